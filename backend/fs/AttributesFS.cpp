@@ -7,6 +7,10 @@
 // LICENSE file in the root of the Project.
 
 #include "AttributesFS.hpp"
+#include "SharedCache.hpp"
+
+#include <algorithm>
+#include <set>
 
 namespace bfs = boost::filesystem;
 namespace y = YAML;
@@ -16,6 +20,110 @@ namespace file {
 
 #define ATTRIBUTES_FILE std::string("attributes")
 
+namespace {
+
+bool is_within(const bfs::path &path, const bfs::path &dir) {
+    auto p = path.begin();
+    for (auto d = dir.begin(); d != dir.end(); ++d, ++p) {
+        if (p == path.end() || *p != *d) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bfs::path directory_key(const bfs::path &dir) {
+    // links to an entity share the cache of the entity
+    return bfs::exists(dir) ? bfs::canonical(dir) : bfs::absolute(dir);
+}
+
+} // anonymous namespace
+
+
+struct AttributesFS::Cache {
+    bfs::path file;
+    y::Node node;
+    FileStamp stamp;
+    bool loaded = false;
+    bool dirty = false;
+    // attributes set or removed since the node was last written
+    std::set<std::string> pending;
+
+    ~Cache();
+
+    void load(const FileStamp &current);
+
+    void write();
+
+    // by canonical directory, so that caches below a directory can be found
+    typedef SharedCache<bfs::path, Cache> Registry;
+};
+
+
+AttributesFS::Cache::~Cache() {
+    if (dirty) {
+        try {
+            write();
+        } catch (...) {
+            // nothing sensible to do in a destructor
+        }
+    }
+}
+
+
+void AttributesFS::Cache::load(const FileStamp &current) {
+    // parse the file again and apply the pending changes on top of it
+    y::Node fresh = bfs::exists(file) ? y::LoadFile(file.string()) : y::Node();
+    const y::Node &changes = node;
+    for (const auto &name : pending) {
+        if (changes[name]) {
+            fresh[name] = y::Clone(changes[name]);
+        } else {
+            fresh.remove(name);
+        }
+    }
+    node = fresh;
+    stamp = current;
+    loaded = true;
+}
+
+
+void AttributesFS::Cache::write() {
+    if (!bfs::exists(file.parent_path())) {
+        // the directory is gone, the changes belong to a removed entity
+        pending.clear();
+        dirty = false;
+        return;
+    }
+
+    FileStamp current;
+    if (!file_stamp(file, current) || current != stamp) {
+        // the file was replaced or removed since it was read, keep the
+        // attributes changed by others
+        load(current);
+    }
+
+    bfs::path temp = file;
+    temp += ".tmp";
+    std::ofstream ofs;
+    ofs.open(temp.string(), std::ofstream::trunc);
+    if (!ofs.is_open()) {
+        throw std::runtime_error("Could not write to attributes file!");
+    }
+    ofs << node << std::endl;
+    ofs.close();
+    if (!ofs) {
+        throw std::runtime_error("Could not write to attributes file!");
+    }
+
+    bfs::rename(temp, file);
+    file_stamp(file, stamp);
+    pending.clear();
+    dirty = false;
+}
+
+
 AttributesFS::AttributesFS() { }
 
 
@@ -31,39 +139,73 @@ AttributesFS::AttributesFS(const bfs::path &file_path, FileMode mode)
 }
 
 
-void AttributesFS::open_or_create() {
-    bfs::path attr(ATTRIBUTES_FILE);
-    bfs::path temp = location() / attr;
-    if (!bfs::exists(temp)) {
+y::Node &AttributesFS::open_or_create() {
+    if (!cache) {
+        bfs::path dir = directory_key(location());
+        cache = Cache::Registry::acquire(dir, [&dir] {
+            Cache *created = new Cache();
+            created->file = dir / bfs::path(ATTRIBUTES_FILE);
+            return created;
+        });
+    }
+
+    FileStamp current;
+    if (!file_stamp(cache->file, current)) {
         if (mode > FileMode::ReadOnly) {
             std::ofstream ofs;
-            ofs.open(temp.string(), std::ofstream::out | std::ofstream::app);
+            ofs.open(cache->file.string(), std::ofstream::out | std::ofstream::app);
             ofs.close();
+            file_stamp(cache->file, current);
         } else {
             throw std::logic_error("Trying to create new attributes in ReadOnly mode!");
         }
     }
-    node = y::LoadFile(temp.string());
+
+    if (!cache->loaded || current != cache->stamp) {
+        cache->load(current);
+    }
+    return cache->node;
+}
+
+
+void AttributesFS::changed(const std::string &name) {
+    cache->pending.insert(name);
+    cache->dirty = true;
 }
 
 
 bool AttributesFS::has(const std::string &name) {
-    open_or_create();
+    y::Node &node = open_or_create();
     return (node.size() > 0) && (node[name]);
 }
 
 
 void AttributesFS::flush() {
-    std::ofstream ofs;
-    bfs::path temp = location() / bfs::path(ATTRIBUTES_FILE);
-    ofs.open(temp.string(), std::ofstream::trunc);
-    if (ofs.is_open()) {
-        ofs << node << std::endl;
+    if (cache && cache->dirty) {
+        cache->write();
     }
-    else {
-        throw std::runtime_error("Could not write to attributes file!");
-    }
-    ofs.close();
+}
+
+
+void AttributesFS::flushAll(const bfs::path &dir) {
+    bfs::path key = directory_key(dir);
+    Cache::Registry::forEach([&key](const bfs::path &dir, const std::shared_ptr<Cache> &cache) {
+        if (cache->dirty && is_within(dir, key)) {
+            cache->write();
+        }
+    });
+}
+
+
+void AttributesFS::discardAll(const bfs::path &dir) {
+    bfs::path key = directory_key(dir);
+    Cache::Registry::forEach([&key](const bfs::path &dir, const std::shared_ptr<Cache> &cache) {
+        if (is_within(dir, key)) {
+            cache->loaded = false;
+            cache->pending.clear();
+            cache->dirty = false;
+        }
+    });
 }
 
 bfs::path AttributesFS::location() const {
@@ -71,20 +213,19 @@ bfs::path AttributesFS::location() const {
 }
 
 nix::ndsize_t AttributesFS::attributeCount() {
-    open_or_create();
-    return node.size();
+    return open_or_create().size();
 }
 
 void AttributesFS::remove(const std::string &name) {
-    open_or_create();
+    y::Node &node = open_or_create();
     if (mode == FileMode::ReadOnly) {
         throw std::logic_error("Trying to remove an attributes in ReadOnly mode!");
     }
     if (node[name]) {
         node.remove(name);
     }
-    flush();
+    changed(name);
 }
 
 } //namespace file
-} //namespace nix
\ No newline at end of file
+} //namespace nix
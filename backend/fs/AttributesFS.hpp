@@ -13,6 +13,7 @@
 #include <boost/filesystem.hpp>
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 #include <nix/Platform.hpp>
 #include <nix/NDSize.hpp>
@@ -21,16 +22,29 @@
 namespace nix {
 namespace file {
 
+/**
+ * The attributes of an entity, stored as YAML file in its directory.
+ *
+ * The parsed attributes are shared by all AttributesFS of the same
+ * directory and only parsed again when the file was changed by someone
+ * else, i.e. when its inode, size or modification time differ; pending
+ * changes are applied again on top of the new content. Changes are kept
+ * in memory and written when the last AttributesFS of the directory is
+ * destroyed, on flush() or on File::flush(); the file is written to a
+ * temporary file first and renamed into place.
+ */
 class AttributesFS {
 
 private:
+    struct Cache;
+
     boost::filesystem::path loc;
     FileMode mode;
-    YAML::Node node;
+    std::shared_ptr<Cache> cache;
 
-    void open_or_create();
+    YAML::Node &open_or_create();
 
-    void flush();
+    void changed(const std::string &name);
 
 public:
     AttributesFS();
@@ -52,25 +66,42 @@ public:
     template <typename T> void set(const std::string &name, const T &value);
 
     ndsize_t attributeCount();
+
+    /**
+     * Write changed attributes to the file.
+     */
+    void flush();
+
+    /**
+     * Write the changed attributes of all entities in a directory to
+     * their files.
+     */
+    static void flushAll(const boost::filesystem::path &dir);
+
+    /**
+     * Forget the attributes of all entities in a directory, including
+     * unwritten changes. Used before the directory is removed or moved.
+     */
+    static void discardAll(const boost::filesystem::path &dir);
 };
 
 template <typename T> void AttributesFS::get(const std::string &name, T &value) {
-    open_or_create();
-    if (has(name)) {
+    YAML::Node &node = open_or_create();
+    if (node.size() > 0 && node[name]) {
         value = node[name].as<T>();
     }
 }
 
 template <typename T> void AttributesFS::set(const std::string &name, const T &value) {
-    open_or_create();
+    YAML::Node &node = open_or_create();
     if (mode == FileMode::ReadOnly) {
         throw std::logic_error("Trying to set an attributes in ReadOnly mode!");
     }
     if (node[name]) {
         node.remove(name);
     }
-    this->node[name] = value;
-    this->flush();
+    node[name] = value;
+    changed(name);
 }
 
 } // namespace file
@@ -125,7 +125,7 @@ void BaseTagFS::references(const std::vector<DataArray> &refs_new) {
 
     // sort them
     std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
+    std::sort(names_old.begin(), names_old.end());
 
     // get names only in names_new (add), names only in names_old (remove) & ignore rest
     std::vector<std::string> names_add;
@@ -135,17 +135,18 @@ void BaseTagFS::references(const std::vector<DataArray> &refs_new) {
     std::set_difference(names_old.begin(), names_old.end(), names_new.begin(), names_new.end(),
                         std::inserter(names_rem, names_rem.begin()));
 
-    // check if all new references exist & add sources
+    // check if all new references exist before changing any & add sources
     auto blck = std::dynamic_pointer_cast<BlockFS>(block());
     for (auto name : names_add) {
         if (!blck->hasDataArray(name))
             throw std::runtime_error("One or more data arrays do not exist in this block!");
+    }
+    for (auto name : names_add) {
         addReference(blck->getDataArray(name)->id());
     }
     // remove references
     for (auto name : names_rem) {
-        if (!blck->hasDataArray(name))
-            removeReference(blck->getDataArray(name)->id());
+        removeReference(name);
     }
 }
 
@@ -9,6 +9,7 @@
 #include "BlockFS.hpp"
 #include "MultiTagFS.hpp"
 #include "GroupFS.hpp"
+#include "QueryFS.hpp"
 
 namespace bfs = boost::filesystem;
 
@@ -143,6 +144,9 @@ std::shared_ptr<base::IDataArray> BlockFS::createDataArray(const std::string &na
     if (hasDataArray(name)) {
         throw DuplicateName("Block::createDataArray: an entity with the same name already exists!");
     }
+    if (data_type == DataType::String) {
+        throw std::invalid_argument("Block::createDataArray: String data is not supported by the filesystem backend!");
+    }
     std::string id = util::createId();
     DataArrayFS da(file(), block(), data_array_dir.location(), id, type, name);
     da.createData(data_type, shape);
@@ -307,6 +311,24 @@ bool BlockFS::deleteGroup(const std::string &name_or_id) {
 }
 
 
+std::vector<std::string> BlockFS::matchingNames(ObjectType type, const util::Query &query) const {
+    switch (type) {
+        case ObjectType::Source:
+            return file::matchingNames([this](ndsize_t i) { return getSource(i); }, sourceCount(), query);
+        case ObjectType::DataArray:
+            return file::matchingNames([this](ndsize_t i) { return getDataArray(i); }, dataArrayCount(), query);
+        case ObjectType::Tag:
+            return file::matchingNames([this](ndsize_t i) { return getTag(i); }, tagCount(), query);
+        case ObjectType::MultiTag:
+            return file::matchingNames([this](ndsize_t i) { return getMultiTag(i); }, multiTagCount(), query);
+        case ObjectType::Group:
+            return file::matchingNames([this](ndsize_t i) { return getGroup(i); }, groupCount(), query);
+        default: break;
+    }
+    throw std::invalid_argument("BlockFS::matchingNames: unsupported object type");
+}
+
+
 std::shared_ptr<base::IBlock> BlockFS::block() const {
     return std::const_pointer_cast<BlockFS>(shared_from_this());
 }
@@ -174,6 +174,13 @@ public:
 
     bool deleteGroup(const std::string &name_or_id);
 
+    //--------------------------------------------------
+    // Queries
+    //--------------------------------------------------
+
+
+    std::vector<std::string> matchingNames(ObjectType type, const util::Query &query) const;
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -9,7 +9,6 @@
 #include <nix/util/util.hpp>
 
 #include "DataArrayFS.hpp"
-#include "hdf5/h5x/H5DataSet.hpp" // FIXME
 #include "DimensionFS.hpp"
 
 namespace bfs = boost::filesystem;
@@ -171,28 +170,41 @@ std::shared_ptr<base::IDimension> DataArrayFS::getDimension(ndsize_t index) cons
 
 
 std::shared_ptr<base::ISetDimension> DataArrayFS::createSetDimension(ndsize_t index) {
+    clearDimension(index);
     SetDimensionFS dim(dimensions.location(), index, fileMode());
     return std::make_shared<SetDimensionFS>(dim);
 }
 
 
 std::shared_ptr<base::IRangeDimension> DataArrayFS::createRangeDimension(ndsize_t index, const std::vector<double> &ticks) {
+    clearDimension(index);
     RangeDimensionFS dim(dimensions.location(), index, ticks, fileMode());
     return std::make_shared<RangeDimensionFS>(dim);
 }
 
 
 std::shared_ptr<base::IRangeDimension> DataArrayFS::createAliasRangeDimension() {
+    clearDimension(1);
     RangeDimensionFS dim(dimensions.location(), 1, *this, fileMode());
     return std::make_shared<RangeDimensionFS>(dim);
 }
 
 
 std::shared_ptr<base::ISampledDimension> DataArrayFS::createSampledDimension(ndsize_t index, double sampling_interval) {
+    clearDimension(index);
     SampledDimensionFS dim(dimensions.location(), index, sampling_interval, fileMode());
     return std::make_shared<SampledDimensionFS>(dim);
 }
 
+
+void DataArrayFS::clearDimension(ndsize_t index) {
+    // a dimension created at the index of an existing one replaces it
+    std::string str_id = util::numToStr(index);
+    if (dimensions.hasObject(str_id)) {
+        dimensions.removeObjectByNameOrAttribute("index", str_id);
+    }
+}
+
 /*
 Group DataArrayFS::createDimensionGroup(size_t index) {
     boost::optional<Group> g = dimension_group(true);
@@ -242,106 +254,68 @@ DataArrayFS::~DataArrayFS() {
 }
 
 
-void DataArrayFS::createData(DataType dtype, const NDSize &size) {
-    setDtype(dtype);
-    dataExtent(size);
-    /*
-    if (group().hasData("data")) {
-        throw new std::runtime_error("DataArray alread exists"); //TODO: FIXME, better exception
+std::shared_ptr<RawDataFS> DataArrayFS::rawData() const {
+    if (!raw_data) {
+        bfs::path p = bfs::path(location()) / "data";
+        if (bfs::exists(p)) {
+            raw_data = std::make_shared<RawDataFS>(p, fileMode());
+        }
     }
+    return raw_data;
+}
+
 
-    group().createData("data", dtype, size); //FIXME: check if this 2-step creation is needed
-    DataSet ds = group().openData("data");
-    */ //FIXME
+void DataArrayFS::createData(DataType dtype, const NDSize &size) {
+    if (hasData()) {
+        throw std::runtime_error("DataArray already exists"); //TODO: FIXME, better exception
+    }
+    raw_data = std::make_shared<RawDataFS>(bfs::path(location()) / "data", dtype, size);
 }
 
+
 bool DataArrayFS::hasData() const {
-    return hasObject("data");
+    return rawData() != nullptr;
 }
 
-void DataArrayFS::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
-    /*
-    DataSet ds;
 
-    if (!group().hasData("data")) {
+void DataArrayFS::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    if (!hasData()) {
         //FIXME: this case should actually never be possible, replace with exception?
-        ds = group().createData("data", dtype, count);
-    } else {
-        ds = group().openData("data");
+        createData(dtype, count);
     }
-
-    if (offset.size()) {
-        Selection fileSel = ds.createSelection();
-        fileSel.select(count, offset);
-        Selection memSel(DataSpace::create(count, false));
-
-        ds.write(dtype, data, fileSel, memSel);
-    } else {
-        ds.write(dtype, count, data);
-    }
-    */ // FIXME
+    raw_data->write(dtype, data, count, offset);
 }
 
+
 void DataArrayFS::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
-    if (!hasObject("data")) {
+    if (!hasData()) {
         return;
     }
-    /*
-    DataSet ds = group().openData("data");
-
-    if (offset.size()) {
-        Selection fileSel = ds.createSelection();
-        // if count.size() == 0, i.e. we want to read a scalar,
-        // we have to supply something that fileSel can make sense of
-        fileSel.select(count ? count : NDSize(offset.size(), 1), offset);
-        Selection memSel(DataSpace::create(count, false));
-
-        ds.read(dtype, data, fileSel, memSel);
-    } else {
-        ds.read(dtype, count, data);
-    }
-    */
+    raw_data->read(dtype, data, count, offset);
 }
 
+
 NDSize DataArrayFS::dataExtent(void) const {
-    if (!hasAttr("extent")) {
+    if (!hasData()) {
         return NDSize{};
     }
-    std::vector<int> ext;
-    getAttr("extent", ext);
-    NDSize extent(ext.size());
-    for (ndsize_t i = 0; i < ext.size(); i++) {
-        extent[i] = ext[i];
-    }
-    return extent;
+    return raw_data->extent();
 }
 
+
 void DataArrayFS::dataExtent(const NDSize &extent) {
-    std::vector<int> ext;
-    for (ndsize_t i = 0; i < extent.size(); i++) {
-        ext.push_back(extent[i]);
-    }
-    if (hasAttr("extent")){
-        removeAttr("extent");
+    if (!hasData()) {
+        throw std::runtime_error("Data field not found in DataArray!");
     }
-    setAttr("extent", ext);
+    raw_data->extent(extent);
 }
 
+
 DataType DataArrayFS::dataType(void) const {
-    if (!hasAttr("dtype")) {
+    if (!hasData()) {
         return DataType::Nothing;
     }
-    std::string dtype;
-    getAttr("dtype", dtype);
-    return nix::string_to_data_type(dtype);
-}
-
-
-void DataArrayFS::setDtype(nix::DataType dtype) {
-    if (hasAttr("dtype")) {
-        removeAttr("dtype");
-    }
-    setAttr("dtype", nix::data_type_to_string(dtype));
+    return raw_data->dataType();
 }
 
 } // ns nix::file
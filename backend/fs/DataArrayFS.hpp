@@ -16,6 +16,7 @@
 
 #include <nix/base/IDataArray.hpp>
 #include "EntityWithSourcesFS.hpp"
+#include "RawDataFS.hpp"
 
 #include <boost/multi_array.hpp>
 #include "Directory.hpp"
@@ -33,7 +34,12 @@ private:
 
     Directory dimensions;
 
-    void setDtype(nix::DataType dtype);
+    // opened on first access, shared by all copies of this entity
+    mutable std::shared_ptr<RawDataFS> raw_data;
+
+    std::shared_ptr<RawDataFS> rawData() const;
+
+    void clearDimension(ndsize_t index);
 public:
 
     /**
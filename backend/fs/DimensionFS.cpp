@@ -7,6 +7,9 @@
 // LICENSE file in the root of the Project.
 
 #include "DimensionFS.hpp"
+#include "RawDataFS.hpp"
+
+#include <algorithm>
 
 using namespace nix::base;
 
@@ -401,37 +404,64 @@ bool RangeDimensionFS::alias() const {
 
 
 std::vector<double> RangeDimensionFS::ticks() const {
-    std::vector<double> ticks;
-    /*
-    Group g = redirectGroup();
-    if (g.hasData("ticks")) {
-        g.getData("ticks", ticks);
-        return ticks;
-    } else if (g.hasData("data")) {
-        g.getData("data", ticks);
-        return ticks;
-    } else {
+    // the ticks of an alias range dimension are the data of the array
+    boost::filesystem::path l(location());
+    boost::filesystem::path p = alias() ? l / "data" / "data" : l / "ticks";
+    if (!boost::filesystem::exists(p)) {
         throw MissingAttr("ticks");
     }
-    */ // FIXME
+
+    RawDataFS data(p, FileMode::ReadOnly);
+    NDSize extent = data.extent();
+    std::vector<double> ticks(extent.nelms());
+    data.read(DataType::Double, ticks.data(), extent, {});
     return ticks;
 }
 
 
 void RangeDimensionFS::ticks(const std::vector<double> &ticks) {
-    /*
-    Group g = redirectGroup();
+    boost::filesystem::path l(location());
+    NDSize extent(1, ticks.size());
     if (!alias()) {
-        g.setData("ticks", ticks);
-    } else if (g.hasData("data")) {
-        NDSize extent(1, ticks.size());
-        DataSet ds = g.openData("data");
-        ds.setExtent(extent);
-        ds.write(nix::DataType::Double, extent, ticks.data());
+        RawDataFS data(l / "ticks", DataType::Double, extent);
+        data.write(DataType::Double, ticks.data(), extent, {});
+    } else if (boost::filesystem::exists(l / "data" / "data")) {
+        RawDataFS data(l / "data" / "data", fileMode());
+        data.extent(extent);
+        data.write(DataType::Double, ticks.data(), extent, {});
     } else {
         throw MissingAttr("ticks");
     }
-    */ //FIXME
+}
+
+ndsize_t RangeDimensionFS::tickCount() const {
+    return ticks().size();
+}
+
+
+std::vector<double> RangeDimensionFS::ticks(ndsize_t start, ndsize_t count) const {
+    std::vector<double> ticks = this->ticks();
+    if (start > ticks.size() || count > ticks.size() - start) {
+        throw OutOfBounds("RangeDimension: requested ticks are out of range!");
+    }
+    return std::vector<double>(ticks.begin() + start, ticks.begin() + start + count);
+}
+
+
+std::vector<ndsize_t> RangeDimensionFS::indexOf(const std::vector<double> &positions) const {
+    std::vector<double> ticks = this->ticks();
+    std::vector<ndsize_t> indices(positions.size(), 0);
+    if (ticks.empty()) {
+        return indices;
+    }
+    for (size_t i = 0; i < positions.size(); ++i) {
+        if (positions[i] > ticks.back()) {
+            indices[i] = ticks.size() - 1;
+        } else if (positions[i] >= ticks.front()) {
+            indices[i] = std::lower_bound(ticks.begin(), ticks.end(), positions[i]) - ticks.begin();
+        }
+    }
+    return indices;
 }
 
 RangeDimensionFS::~RangeDimensionFS() {}
@@ -185,6 +185,15 @@ public:
     void ticks(const std::vector<double> &ticks);
 
 
+    ndsize_t tickCount() const;
+
+
+    std::vector<double> ticks(ndsize_t start, ndsize_t count) const;
+
+
+    std::vector<ndsize_t> indexOf(const std::vector<double> &positions) const;
+
+
     virtual ~RangeDimensionFS();
 
 private:
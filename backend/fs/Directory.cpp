@@ -8,12 +8,40 @@
 
 #include <iostream>
 #include "Directory.hpp"
+#include "SharedCache.hpp"
+
+#include <algorithm>
+#include <map>
 
 namespace bfs = boost::filesystem;
 
 namespace nix {
 namespace file {
 
+struct Directory::Listing {
+    FileStamp stamp;
+    bool valid = false;
+
+    // sorted names of all subdirectories and links, links are only
+    // subdirectories while their target exists
+    std::vector<std::string> subdirs;
+    std::vector<bool> is_link;
+    bool has_links = false;
+
+    bool alive(const bfs::path &dir, size_t index) const {
+        return !is_link[index] || bfs::is_directory(dir / bfs::path(subdirs[index]));
+    }
+
+    // per attribute the subdirectory of each value, filled by lookups; and
+    // the subdirectories that did not have the attribute yet at that time
+    std::map<std::string, std::map<std::string, std::string>> by_attribute;
+    std::map<std::string, std::vector<std::string>> without_attribute;
+
+    // by the key of the stamp, so that links to a directory share its listing
+    typedef SharedCache<std::string, Listing> Registry;
+};
+
+
 Directory::Directory(const bfs::path &location, FileMode mode)
     : loc(location), mode(mode) {
     open_or_create();
@@ -24,7 +52,12 @@ Directory::Directory(const std::string &location, FileMode mode): Directory(bfs:
 void Directory::open_or_create() {
     if (!exists(loc)) {
         if (mode > FileMode::ReadOnly) {
+            bfs::path parent = loc.parent_path();
+            while (!parent.empty() && !exists(parent)) {
+                parent = parent.parent_path();
+            }
             create_directories(loc);
+            invalidate(parent.empty() ? bfs::current_path() : parent);
         } else {
             throw std::logic_error("Trying to create new directory in ReadOnly mode!");
         }
@@ -42,14 +75,101 @@ FileMode Directory::fileMode() const {
 }
 
 
+Directory::Listing &Directory::entries() const {
+    FileStamp current;
+    if (!file_stamp(loc, current) || !current.directory) {
+        throw bfs::filesystem_error("Directory: cannot list", loc,
+                                    boost::system::errc::make_error_code(boost::system::errc::no_such_file_or_directory));
+    }
+
+    if (!listing || listing->stamp.key != current.key) {
+        listing = Listing::Registry::acquire(current.key, [&current] {
+            Listing *created = new Listing();
+            created->stamp.key = current.key;
+            return created;
+        });
+    }
+
+    if (!listing->valid || listing->stamp != current) {
+        // links are kept apart: removing the target of a link does not
+        // change the directory of the link
+        std::vector<std::pair<std::string, bool>> found;
+        for (bfs::directory_iterator end, di(loc); di != end; ++di) {
+            bfs::file_status st = di->symlink_status();
+            if (bfs::is_symlink(st) || bfs::is_directory(st)) {
+                found.push_back(std::make_pair(di->path().filename().string(), bfs::is_symlink(st)));
+            }
+        }
+        std::sort(found.begin(), found.end());
+
+        std::vector<std::string> subdirs;
+        std::vector<bool> is_link;
+        bool has_links = false;
+        for (const auto &entry : found) {
+            subdirs.push_back(entry.first);
+            is_link.push_back(entry.second);
+            has_links = has_links || entry.second;
+        }
+
+        // attributes used for lookups (names, ids, indices) only change
+        // when a subdirectory is renamed, so what is known about the
+        // remaining subdirectories is kept; new ones are read on demand
+        auto present = [&subdirs](const std::string &name) {
+            return std::binary_search(subdirs.begin(), subdirs.end(), name);
+        };
+        std::vector<std::string> added;
+        for (const std::string &name : subdirs) {
+            if (!std::binary_search(listing->subdirs.begin(), listing->subdirs.end(), name)) {
+                added.push_back(name);
+            }
+        }
+        for (auto &attribute : listing->by_attribute) {
+            auto &values = attribute.second;
+            for (auto it = values.begin(); it != values.end();) {
+                it = present(it->second) ? std::next(it) : values.erase(it);
+            }
+            std::vector<std::string> &without = listing->without_attribute[attribute.first];
+            without.erase(std::remove_if(without.begin(), without.end(), [&](const std::string &name) {
+                return !present(name);
+            }), without.end());
+            without.insert(without.end(), added.begin(), added.end());
+        }
+
+        listing->subdirs.swap(subdirs);
+        listing->is_link.swap(is_link);
+        listing->has_links = has_links;
+        listing->stamp = current;
+        listing->valid = true;
+    }
+    return *listing;
+}
+
+
+void Directory::invalidate(const bfs::path &dir, bool entries_removed) {
+    FileStamp current;
+    if (!file_stamp(dir, current) || !current.directory) {
+        return;
+    }
+    std::shared_ptr<Listing> cached = Listing::Registry::find(current.key);
+    if (cached) {
+        cached->valid = false;
+        if (entries_removed) {
+            cached->by_attribute.clear();
+            cached->without_attribute.clear();
+        }
+    }
+}
+
+
 ndsize_t Directory::subdirCount() const {
+    const Listing &l = entries();
+    if (!l.has_links) {
+        return l.subdirs.size();
+    }
     ndsize_t count = 0;
-    bfs::directory_iterator end;
-    bfs::directory_iterator di(location().c_str());
-    while (di != end) {
-        if (bfs::is_directory(*di))
+    for (size_t i = 0; i < l.subdirs.size(); i++) {
+        if (l.alive(loc, i))
             count ++;
-        ++di;
     }
     return count;
 }
@@ -57,19 +177,23 @@ ndsize_t Directory::subdirCount() const {
 
 void Directory::removeAll() {
     bfs::path p(location());
+    AttributesFS::discardAll(p);
     for (bfs::directory_iterator end_it, it(p); it!=end_it; ++it) {
         bfs::remove_all(it->path());
     }
+    invalidate(p, true);
 }
 
 
 boost::filesystem::path Directory::sub_dir_by_index(ndsize_t index) const {
     bfs::path p;
-    std::vector<bfs::path> paths;
-    copy(bfs::directory_iterator(loc), bfs::directory_iterator(), back_inserter(paths));
-    std::sort(paths.begin(), paths.end());
-    if (index < paths.size())
-        p = paths[index];
+    const Listing &l = entries();
+    for (size_t i = 0; i < l.subdirs.size(); i++) {
+        if (l.alive(loc, i) && index-- == 0) {
+            p = loc / bfs::path(l.subdirs[i]);
+            break;
+        }
+    }
     return p;
 }
 
@@ -80,38 +204,55 @@ boost::optional<bfs::path> Directory::findByNameOrAttribute(const std::string &a
         p = location() / bfs::path(value.c_str());
         return p;
     }
+
+    Listing &l = entries();
     bfs::path attr_path("attributes");
-    bfs::directory_iterator end;
-    bfs::directory_iterator di(location().c_str());
-    while (di != end) {
-        bfs::path temp = *di;
-        if (bfs::is_directory(temp) && exists(temp / attr_path)){
-            AttributesFS attr(temp);
-            std::string s;
-            if (attr.has(attribute)) {
-                attr.get(attribute, s);
-                if (s == value) {
-                    p = temp;
-                    return p;
-                }
+
+    // reads the attribute of a subdirectory into the listing
+    auto lookup = [&](const std::string &name, std::map<std::string, std::string> &values) {
+        bfs::path temp = loc / bfs::path(name);
+        if (!bfs::is_directory(temp) || !exists(temp / attr_path)) {
+            return false;
+        }
+        AttributesFS attr(temp);
+        std::string s;
+        if (!attr.has(attribute)) {
+            return false;
+        }
+        attr.get(attribute, s);
+        values.insert(std::make_pair(s, name));
+        return true;
+    };
+
+    auto known = l.by_attribute.find(attribute);
+    if (known == l.by_attribute.end()) {
+        known = l.by_attribute.insert(std::make_pair(attribute, std::map<std::string, std::string>())).first;
+        std::vector<std::string> &without = l.without_attribute[attribute];
+        for (const std::string &name : l.subdirs) {
+            if (!lookup(name, known->second)) {
+                without.push_back(name);
             }
         }
-        ++di;
+    } else if (known->second.find(value) == known->second.end()) {
+        // entities get their attributes after their directory was created
+        std::vector<std::string> &without = l.without_attribute[attribute];
+        without.erase(std::remove_if(without.begin(), without.end(), [&](const std::string &name) {
+            return lookup(name, known->second);
+        }), without.end());
+    }
+
+    auto found = known->second.find(value);
+    if (found != known->second.end() && hasObject(found->second)) {
+        p = loc / bfs::path(found->second);
     }
     return p;
 }
 
 
 bool Directory::hasObject(const std::string &name) const {
-    bfs::directory_iterator end;
-    bfs::directory_iterator di(location().c_str());
-    while (di != end) {
-        bfs::path temp = *di;
-        if (bfs::is_directory(temp) && temp.filename().string() == name)
-            return true;
-        ++di;
-    }
-    return false;
+    const Listing &l = entries();
+    auto it = std::lower_bound(l.subdirs.begin(), l.subdirs.end(), name);
+    return it != l.subdirs.end() && *it == name && l.alive(loc, it - l.subdirs.begin());
 }
 
 bool Directory::removeObjectByNameOrAttribute(const std::string &attribute, const std::string &name_or_id) const {
@@ -125,10 +266,15 @@ bool Directory::removeObjectByNameOrAttribute(const std::string &attribute, cons
                 attr.get("links", links);
                 for (auto &l :links) {
                     bfs::remove_all(bfs::path(l));
+                    invalidate(bfs::path(l).parent_path(), true);
                 }
             }
         }
+        if (!bfs::is_symlink(*p)) {
+            AttributesFS::discardAll(*p);
+        }
         uintmax_t ret = remove_all(*p);
+        invalidate(loc, true);
         return ret > 0;
     }
     return false;
@@ -136,8 +282,9 @@ bool Directory::removeObjectByNameOrAttribute(const std::string &attribute, cons
 
 
 void Directory::createDirectoryLink(const std::string &target, const std::string &name) {
-    if (boost::filesystem::exists({target})) {
+    if (boost::filesystem::exists(boost::filesystem::path(target))) {
         boost::filesystem::create_directory_symlink(boost::filesystem::path(target), loc / boost::filesystem::path(name));
+        invalidate(loc);
     } else {
         throw std::runtime_error("Directory::createLink: target does not exist");
     }
@@ -147,7 +294,11 @@ void Directory::createDirectoryLink(const std::string &target, const std::string
 void Directory::renameSubdir(const std::string &old_name, const std::string &new_name) {
     bfs::path o(bfs::path(location()) / bfs::path(old_name)), n(bfs::path(location()) / bfs::path(new_name));
     if (hasObject(old_name) && ! hasObject(new_name)) {
+        // pending attribute changes must reach the files before they move
+        AttributesFS::flushAll(o);
+        AttributesFS::discardAll(o);
         rename(o, n);
+        invalidate(loc, true);
     }
 }
 
@@ -13,20 +13,35 @@
 #include "AttributesFS.hpp"
 #include <nix/File.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace nix {
 namespace file {
 
+/**
+ * A directory of the file, usually holding one subdirectory per entity.
+ *
+ * The sorted names of the subdirectories and, for lookups by attribute,
+ * which subdirectory has which value are cached. The cache is shared by
+ * all Directory objects of the same directory and is rebuilt when the
+ * modification time of the directory changes or when the backend reports
+ * a change with invalidate().
+ */
 class Directory {
 
 private:
+    struct Listing;
+
     boost::filesystem::path loc;
     FileMode mode;
+    mutable std::shared_ptr<Listing> listing;
 
     void open_or_create();
 
+    Listing &entries() const;
+
 public:
     Directory () {};
 
@@ -55,6 +70,13 @@ public:
     bool isValid() const;
 
     virtual void removeAll();
+
+    /**
+     * Mark the cached listing of a directory as outdated, after entries
+     * were added, removed or renamed. What is known about the attributes
+     * of the entries is kept, unless some were removed or renamed.
+     */
+    static void invalidate(const boost::filesystem::path &dir, bool entries_removed = false);
 };
 
 }
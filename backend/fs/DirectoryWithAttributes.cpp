@@ -43,6 +43,7 @@ void DirectoryWithAttributes::createLink(const bfs::path &linker) {
         getAttr("links", links);
     }
     bfs::create_directory_symlink(bfs::path(location()), linker);
+    invalidate(linker.parent_path());
     links.push_back(linker.string());
     setAttr("links", links);
 }
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include "EntityFS.hpp"
+#include "FileFS.hpp"
 
 namespace bfs = boost::filesystem;
 
@@ -54,6 +55,7 @@ void EntityFS::setUpdatedAt() {
     if (!hasAttr("updated_at")) {
         time_t t = util::getTime();
         setAttr("updated_at", util::timeToStr(t));
+        markModified(entity_file);
     }
 }
 
@@ -61,6 +63,7 @@ void EntityFS::setUpdatedAt() {
 void EntityFS::forceUpdatedAt() {
     time_t t = util::getTime();
     setAttr("updated_at", util::timeToStr(t));
+    markModified(entity_file);
 }
 
 
@@ -88,6 +88,7 @@ void EntityWithMetadataFS::metadata(const none_t t) {
         bfs::path p1(location()), p2("metadata");
         sec_tmp->unlink(p1 / p2);
         bfs::remove_all(p1/p2);
+        Directory::invalidate(p1, true);
     }
     forceUpdatedAt();
 }
@@ -9,6 +9,7 @@
 #include "FileFS.hpp"
 #include "BlockFS.hpp"
 #include "SectionFS.hpp"
+#include "QueryFS.hpp"
 
 namespace bfs = boost::filesystem;
 
@@ -20,7 +21,7 @@ namespace file {
 #define FILE_FORMAT  std::string("nix")
 
 FileFS::FileFS(const std::string &name, FileMode mode)
-    : DirectoryWithAttributes(name, mode){
+    : DirectoryWithAttributes(name, mode), revision_count(0) {
     this->mode = mode;
     if (mode == FileMode::Overwrite) {
         removeAll();
@@ -142,7 +143,27 @@ std::shared_ptr<base::ISection> FileFS::createSection(const std::string &name, c
 
 
 bool FileFS::deleteSection(const std::string &name_or_id) {
-    return metadata_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
+    bool deleted = metadata_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
+    if (deleted) {
+        modified();
+    }
+    return deleted;
+}
+
+//--------------------------------------------------
+// Queries
+//--------------------------------------------------
+
+
+std::vector<std::string> FileFS::matchingNames(ObjectType type, const util::Query &query) const {
+    switch (type) {
+        case ObjectType::Block:
+            return file::matchingNames([this](ndsize_t i) { return getBlock(i); }, blockCount(), query);
+        case ObjectType::Section:
+            return file::matchingNames([this](ndsize_t i) { return getSection(i); }, sectionCount(), query);
+        default: break;
+    }
+    throw std::invalid_argument("FileFS::matchingNames: unsupported object type");
 }
 
 //--------------------------------------------------
@@ -210,7 +231,19 @@ void FileFS::forceCreatedAt(time_t t) {
 }
 
 
-void FileFS::close() {} // FIXME not needed?
+void FileFS::close() {
+    flush();
+}
+
+
+void FileFS::flush() {
+    AttributesFS::flushAll(location());
+}
+
+
+void FileFS::repack(const std::string &path, const StorageOptions &options) const {
+    throw std::runtime_error("FileFS::repack: not supported by the filesystem back-end");
+}
 
 bool FileFS::isOpen() const { //FIXME not needed?
     return true;
@@ -260,6 +293,32 @@ FileMode FileFS::fileMode() const {
     return mode;
 }
 
+void FileFS::beginBatch() {} // changed attributes are written back anyway
+
+void FileFS::endBatch() {
+    flush();
+}
+
+void FileFS::abandonBatch() {}
+
+
+size_t FileFS::revision() const {
+    return revision_count;
+}
+
+
+void FileFS::modified() {
+    revision_count++;
+}
+
+
+void markModified(const std::shared_ptr<base::IFile> &file) {
+    FileFS *f = dynamic_cast<FileFS *>(file.get());
+    if (f) {
+        f->modified();
+    }
+}
+
 FileFS::~FileFS() {}
 
 } // namespace file
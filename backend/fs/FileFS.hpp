@@ -25,6 +25,9 @@ private:
     Directory data_dir, metadata_dir;
     FileMode mode;
 
+    /* incremented on every modification of an entity, see revision() */
+    size_t revision_count;
+
     void create_subfolders(const std::string &loc);
 
 public:
@@ -69,6 +72,13 @@ public:
 
     bool deleteSection(const std::string &name_or_id);
 
+    //--------------------------------------------------
+    // Queries
+    //--------------------------------------------------
+
+
+    std::vector<std::string> matchingNames(ObjectType type, const util::Query &query) const;
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -104,12 +114,36 @@ public:
     void close() override;
 
 
+    void flush();
+
+
+    void repack(const std::string &path, const StorageOptions &options) const;
+
+
     bool isOpen() const;
 
 
     FileMode fileMode() const;
 
 
+    void beginBatch();
+
+
+    void endBatch();
+
+
+    void abandonBatch();
+
+
+    size_t revision() const;
+
+
+    /**
+     * Record a modification of an entity of the file.
+     */
+    void modified();
+
+
     bool operator==(const FileFS &other) const;
 
 
@@ -130,6 +164,16 @@ public:
 
 };
 
+
+/**
+ * Record a modification of an entity of the given file, which
+ * increments the revision of the file.
+ *
+ * @param file      The file of the modified entity.
+ */
+void markModified(const std::shared_ptr<base::IFile> &file);
+
+
 } // namespace file
 } // namespace nix
 
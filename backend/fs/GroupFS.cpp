@@ -129,7 +129,7 @@ void GroupFS::dataArrays(const std::vector<DataArray> &data_arrays) {
 
     // sort them
     std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
+    std::sort(names_old.begin(), names_old.end());
 
     // get names only in names_new (add), names only in names_old (remove) & ignore rest
     std::vector<std::string> names_add;
@@ -148,8 +148,7 @@ void GroupFS::dataArrays(const std::vector<DataArray> &data_arrays) {
     }
     // remove references
     for (auto name : names_rem) {
-        if (!blck->hasDataArray(name))
-            removeDataArray(blck->getDataArray(name)->id());
+        removeDataArray(name);
     }
 }
 
@@ -227,7 +226,7 @@ void GroupFS::tags(const std::vector<Tag> &tags) {
 
     // sort them
     std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
+    std::sort(names_old.begin(), names_old.end());
 
     // get names only in names_new (add), names only in names_old (remove) & ignore rest
     std::vector<std::string> names_add;
@@ -246,8 +245,7 @@ void GroupFS::tags(const std::vector<Tag> &tags) {
     }
     // remove references
     for (auto name : names_rem) {
-        if (!blck->hasTag(name))
-            removeTag(blck->getTag(name)->id());
+        removeTag(name);
     }
 }
 
@@ -325,7 +323,7 @@ void GroupFS::multiTags(const std::vector<MultiTag> &multi_tags) {
 
     // sort them
     std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
+    std::sort(names_old.begin(), names_old.end());
 
     // get names only in names_new (add), names only in names_old (remove) & ignore rest
     std::vector<std::string> names_add;
@@ -344,8 +342,7 @@ void GroupFS::multiTags(const std::vector<MultiTag> &multi_tags) {
     }
     // remove references
     for (auto name : names_rem) {
-        if (!blck->hasMultiTag(name))
-            removeMultiTag(blck->getMultiTag(name)->id());
+        removeMultiTag(name);
     }
 }
 
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include "PropertyFS.hpp"
+#include "FileFS.hpp"
 
 namespace bfs = boost::filesystem;
 
@@ -14,14 +15,14 @@ namespace nix {
 namespace file {
 
 PropertyFS::PropertyFS(const std::shared_ptr<base::IFile> &file, const bfs::path &loc)
-    : DirectoryWithAttributes(loc, file->fileMode())
+    : DirectoryWithAttributes(loc, file->fileMode()), entity_file(file)
 {
 }
 
 
 PropertyFS::PropertyFS(const std::shared_ptr<base::IFile> &file, const bfs::path &loc, const std::string &id,
                        const std::string &name, const DataType &dataType)
-    : DirectoryWithAttributes(loc / bfs::path(name), file->fileMode())
+    : DirectoryWithAttributes(loc / bfs::path(name), file->fileMode()), entity_file(file)
 {
     if (name.empty()) {
         throw EmptyString("name");
@@ -61,6 +62,7 @@ void PropertyFS::setUpdatedAt() {
     if (!hasAttr("updated_at")) {
         time_t t = util::getTime();
         setAttr("updated_at", util::timeToStr(t));
+        markModified(entity_file);
     }
 }
 
@@ -68,6 +70,7 @@ void PropertyFS::setUpdatedAt() {
 void PropertyFS::forceUpdatedAt() {
     time_t t = util::getTime();
     setAttr("updated_at", util::timeToStr(t));
+    markModified(entity_file);
 }
 
 
@@ -217,6 +220,11 @@ std::vector<Value> PropertyFS::values(void) const {
 }
 
 
+ValueColumn PropertyFS::valueColumn() const {
+    return ValueColumn(values());
+}
+
+
 void PropertyFS::values(const nix::none_t t) {
     // TODO: rethink if we want two methods for same thing
     deleteValues();
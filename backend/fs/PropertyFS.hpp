@@ -26,6 +26,10 @@ namespace file {
 class PropertyFS : virtual public base::IProperty, public DirectoryWithAttributes,
                    public std::enable_shared_from_this<PropertyFS> {
 
+private:
+
+    std::shared_ptr<base::IFile> entity_file;
+
 public:
     PropertyFS(const std::shared_ptr<base::IFile> &file, const boost::filesystem::path &loc);
 
@@ -100,6 +104,9 @@ public:
     std::vector<Value> values(void) const;
 
 
+    ValueColumn valueColumn() const;
+
+
     void values(const boost::none_t t);
 
 
@@ -0,0 +1,82 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_QUERY_FS_H
+#define NIX_QUERY_FS_H
+
+#include <nix/util/query.hpp>
+#include <nix/base/IEntityWithMetadata.hpp>
+#include <nix/base/ISection.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nix {
+namespace file {
+
+
+inline boost::optional<std::string> metadata_id(const base::INamedEntity *entity) {
+    return boost::none;
+}
+
+
+inline boost::optional<std::string> metadata_id(const base::IEntityWithMetadata *entity) {
+    boost::optional<std::string> ret;
+    std::shared_ptr<base::ISection> section = entity->metadata();
+    if (section) {
+        ret = section->id();
+    }
+    return ret;
+}
+
+
+/**
+ * Evaluate a query on the entities of a collection. The filesystem
+ * back-end reads the attributes through the entity objects.
+ *
+ * @param getEntity     Function that returns the entity with the given index.
+ * @param n             The number of entities in the collection.
+ * @param query         The query to evaluate.
+ *
+ * @return The names of the matching entities in index order.
+ */
+template<typename TFUNC>
+std::vector<std::string> matchingNames(TFUNC const &getEntity, ndsize_t n, const util::Query &query) {
+    typedef util::Query::Field Field;
+    std::vector<std::string> names;
+
+    for (ndsize_t i = 0; i < n; i++) {
+        auto entity = getEntity(i);
+        if (!entity) {
+            continue;
+        }
+
+        auto get = [&entity](Field f) -> boost::optional<std::string> {
+            switch (f) {
+                case Field::Name:       return entity->name();
+                case Field::Type:       return entity->type();
+                case Field::Id:         return entity->id();
+                case Field::Definition: return entity->definition();
+                case Field::Metadata:   return metadata_id(entity.get());
+            }
+            return boost::none;
+        };
+
+        if (query.matches(get)) {
+            names.push_back(entity->name());
+        }
+    }
+
+    return names;
+}
+
+
+} // namespace file
+} // namespace nix
+
+#endif // NIX_QUERY_FS_H
@@ -0,0 +1,605 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "RawDataFS.hpp"
+
+#include <nix/Exception.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+
+namespace bfs = boost::filesystem;
+namespace bip = boost::interprocess;
+
+namespace nix {
+namespace file {
+
+const uint32_t RawDataFS::version;
+
+static const char magic[8] = {'N', 'I', 'X', '-', 'R', 'A', 'W', '\0'};
+
+// magic, version, data type, rank and header size
+static const size_t fixed_header_size = sizeof(magic) + 4 * sizeof(uint32_t);
+
+// data starts at a multiple of this, which keeps elements aligned
+static const size_t header_alignment = 64;
+
+// hyperslabs spanning more bytes are announced to the kernel with madvise
+static const size_t advise_threshold = 64 * 1024;
+
+/* header fields are always stored little endian */
+
+static void put_u32(char *dest, uint32_t value) {
+    for (size_t i = 0; i < 4; i++) {
+        dest[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+
+static void put_u64(char *dest, uint64_t value) {
+    for (size_t i = 0; i < 8; i++) {
+        dest[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+
+static uint32_t get_u32(const char *src) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(src[i])) << (8 * i);
+    }
+    return value;
+}
+
+
+static uint64_t get_u64(const char *src) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(src[i])) << (8 * i);
+    }
+    return value;
+}
+
+
+static void check_host() {
+    // elements are copied from and to the file as they are in memory
+    const uint16_t probe = 1;
+    if (*reinterpret_cast<const unsigned char *>(&probe) != 1) {
+        throw std::runtime_error("RawDataFS: Data files are not supported on big endian hosts");
+    }
+}
+
+
+static std::invalid_argument unsupported_type(DataType dtype) {
+    // strings have no fixed size and would need a heap of their own
+    if (dtype == DataType::String) {
+        return std::invalid_argument("RawDataFS: String data is not supported by the filesystem backend");
+    }
+    return std::invalid_argument("RawDataFS: Unsupported data type " + data_type_to_string(dtype));
+}
+
+
+static size_t element_size(DataType dtype) {
+    switch (dtype) {
+        case DataType::Bool:
+        case DataType::Char:
+        case DataType::Float:
+        case DataType::Double:
+        case DataType::Int8:
+        case DataType::Int16:
+        case DataType::Int32:
+        case DataType::Int64:
+        case DataType::UInt8:
+        case DataType::UInt16:
+        case DataType::UInt32:
+        case DataType::UInt64:
+            return data_type_to_size(dtype);
+        default:
+            throw unsupported_type(dtype);
+    }
+}
+
+
+static NDSize row_major(const NDSize &shape) {
+    size_t n = shape.size();
+    NDSize strides(n, 1);
+    for (size_t i = n; i > 1; --i) {
+        strides[i - 2] = strides[i - 1] * shape[i - 1];
+    }
+    return strides;
+}
+
+
+/*
+ * Calls fn(index) for every index of the first dims dimensions of shape,
+ * i.e. for every row, in row major order or reversed.
+ */
+template<typename F>
+static void for_each_index(const NDSize &shape, size_t dims, bool reverse, F fn) {
+    ndsize_t total = 1;
+    for (size_t d = 0; d < dims; d++) {
+        total *= shape[d];
+    }
+
+    NDSize index(dims, 0);
+    for (ndsize_t n = 0; n < total; n++) {
+        ndsize_t k = reverse ? total - 1 - n : n;
+        for (size_t d = dims; d > 0; --d) {
+            index[d - 1] = k % shape[d - 1];
+            k /= shape[d - 1];
+        }
+        fn(index);
+    }
+}
+
+
+static ndsize_t row_offset(const NDSize &strides, const NDSize &index) {
+    ndsize_t pos = 0;
+    for (size_t d = 0; d < index.size(); d++) {
+        pos += index[d] * strides[d];
+    }
+    return pos;
+}
+
+
+/* conversion between the stored and the requested data type */
+
+template<typename Dst, typename Src>
+static void copy_as(const Src *src, void *dst, size_t n) {
+    Dst *out = static_cast<Dst *>(dst);
+    for (size_t i = 0; i < n; i++) {
+        out[i] = static_cast<Dst>(src[i]);
+    }
+}
+
+
+template<typename Src>
+static void convert_from(const Src *src, DataType dtype, void *dst, size_t n) {
+    switch (dtype) {
+        case DataType::Bool:   copy_as<bool>(src, dst, n);     break;
+        case DataType::Char:   copy_as<char>(src, dst, n);     break;
+        case DataType::Float:  copy_as<float>(src, dst, n);    break;
+        case DataType::Double: copy_as<double>(src, dst, n);   break;
+        case DataType::Int8:   copy_as<int8_t>(src, dst, n);   break;
+        case DataType::Int16:  copy_as<int16_t>(src, dst, n);  break;
+        case DataType::Int32:  copy_as<int32_t>(src, dst, n);  break;
+        case DataType::Int64:  copy_as<int64_t>(src, dst, n);  break;
+        case DataType::UInt8:  copy_as<uint8_t>(src, dst, n);  break;
+        case DataType::UInt16: copy_as<uint16_t>(src, dst, n); break;
+        case DataType::UInt32: copy_as<uint32_t>(src, dst, n); break;
+        case DataType::UInt64: copy_as<uint64_t>(src, dst, n); break;
+        default:
+            throw unsupported_type(dtype);
+    }
+}
+
+
+static void convert(DataType src_type, const void *src, DataType dst_type, void *dst, size_t n) {
+    if (src_type == dst_type) {
+        std::memcpy(dst, src, n * data_type_to_size(src_type));
+        return;
+    }
+
+    switch (src_type) {
+        case DataType::Bool:   convert_from(static_cast<const bool *>(src), dst_type, dst, n);     break;
+        case DataType::Char:   convert_from(static_cast<const char *>(src), dst_type, dst, n);     break;
+        case DataType::Float:  convert_from(static_cast<const float *>(src), dst_type, dst, n);    break;
+        case DataType::Double: convert_from(static_cast<const double *>(src), dst_type, dst, n);   break;
+        case DataType::Int8:   convert_from(static_cast<const int8_t *>(src), dst_type, dst, n);   break;
+        case DataType::Int16:  convert_from(static_cast<const int16_t *>(src), dst_type, dst, n);  break;
+        case DataType::Int32:  convert_from(static_cast<const int32_t *>(src), dst_type, dst, n);  break;
+        case DataType::Int64:  convert_from(static_cast<const int64_t *>(src), dst_type, dst, n);  break;
+        case DataType::UInt8:  convert_from(static_cast<const uint8_t *>(src), dst_type, dst, n);  break;
+        case DataType::UInt16: convert_from(static_cast<const uint16_t *>(src), dst_type, dst, n); break;
+        case DataType::UInt32: convert_from(static_cast<const uint32_t *>(src), dst_type, dst, n); break;
+        case DataType::UInt64: convert_from(static_cast<const uint64_t *>(src), dst_type, dst, n); break;
+        default:
+            throw unsupported_type(src_type);
+    }
+}
+
+//--------------------------------------------------
+// RawDataFS
+//--------------------------------------------------
+
+RawDataFS::RawDataFS(const bfs::path &path, FileMode mode)
+    : path(path), mode(mode)
+{
+    check_host();
+
+    file = bip::file_mapping(path.string().c_str(), mode == FileMode::ReadOnly ? bip::read_only : bip::read_write);
+    map();
+
+    if (region.get_size() < fixed_header_size || std::memcmp(base(), magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("RawDataFS: Not a data file: " + path.string());
+    }
+    if (get_u32(base() + 8) != version) {
+        throw std::runtime_error("RawDataFS: Unsupported version of data file: " + path.string());
+    }
+}
+
+
+RawDataFS::RawDataFS(const bfs::path &path, DataType dtype, const NDSize &extent)
+    : path(path), mode(FileMode::ReadWrite)
+{
+    check_host();
+
+    std::vector<char> head = encodeHeader(dtype, extent, extent);
+    {
+        bfs::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(head.data(), head.size());
+        if (!out) {
+            throw std::runtime_error("RawDataFS: Could not create data file: " + path.string());
+        }
+    }
+
+    size_t data_size = check::fits_in_size_t(extent.nelms() * element_size(dtype), "RawDataFS: Data too large");
+    bfs::resize_file(path, head.size() + data_size);
+
+    file = bip::file_mapping(path.string().c_str(), bip::read_write);
+    map();
+}
+
+
+size_t RawDataFS::headerSize(size_t rank) {
+    size_t size = fixed_header_size + 2 * rank * sizeof(uint64_t);
+    return (size + header_alignment - 1) / header_alignment * header_alignment;
+}
+
+
+std::vector<char> RawDataFS::encodeHeader(DataType dtype, const NDSize &extent, const NDSize &layout) {
+    element_size(dtype);
+
+    const size_t rank = extent.size();
+    std::vector<char> head(headerSize(rank), 0);
+
+    std::memcpy(head.data(), magic, sizeof(magic));
+    put_u32(head.data() + 8, version);
+    put_u32(head.data() + 12, static_cast<uint32_t>(dtype));
+    put_u32(head.data() + 16, static_cast<uint32_t>(rank));
+    put_u32(head.data() + 20, static_cast<uint32_t>(head.size()));
+
+    for (size_t i = 0; i < rank; i++) {
+        put_u64(head.data() + fixed_header_size + 8 * i, extent[i]);
+        put_u64(head.data() + fixed_header_size + 8 * (rank + i), layout[i]);
+    }
+    return head;
+}
+
+
+RawDataFS::Header RawDataFS::header() const {
+    // another RawDataFS of the same file may have grown it since it was
+    // mapped here; then the mapping is renewed once
+    for (int attempt = 0; ; attempt++) {
+        const char *head = base();
+        Header h;
+        h.dtype = static_cast<DataType>(get_u32(head + 12));
+        size_t rank = get_u32(head + 16);
+        h.data_offset = get_u32(head + 20);
+
+        h.extent = NDSize(rank);
+        h.layout = NDSize(rank);
+        for (size_t i = 0; i < rank; i++) {
+            h.extent[i] = get_u64(head + fixed_header_size + 8 * i);
+            h.layout[i] = get_u64(head + fixed_header_size + 8 * (rank + i));
+        }
+
+        ndsize_t needed = h.data_offset + h.layout.nelms() * element_size(h.dtype);
+        if (needed <= region.get_size()) {
+            return h;
+        } else if (attempt > 0) {
+            throw std::runtime_error("RawDataFS: Data file is truncated: " + path.string());
+        }
+        map();
+    }
+}
+
+
+void RawDataFS::storeShape(const NDSize &extent, const NDSize &layout) {
+    char *head = base();
+    const size_t rank = extent.size();
+    for (size_t i = 0; i < rank; i++) {
+        put_u64(head + fixed_header_size + 8 * i, extent[i]);
+        put_u64(head + fixed_header_size + 8 * (rank + i), layout[i]);
+    }
+}
+
+
+void RawDataFS::map() const {
+    region = bip::mapped_region(file, mode == FileMode::ReadOnly ? bip::read_only : bip::read_write);
+}
+
+
+char *RawDataFS::base() const {
+    return static_cast<char *>(region.get_address());
+}
+
+
+DataType RawDataFS::dataType() const {
+    return static_cast<DataType>(get_u32(base() + 12));
+}
+
+
+NDSize RawDataFS::extent() const {
+    return header().extent;
+}
+
+
+NDSize RawDataFS::layout() const {
+    return header().layout;
+}
+
+
+void RawDataFS::extent(const NDSize &extent) {
+    if (mode == FileMode::ReadOnly) {
+        throw std::runtime_error("RawDataFS: Cannot change read only data");
+    }
+
+    Header h = header();
+    const size_t rank = h.extent.size();
+    if (extent.size() != rank) {
+        throw IncompatibleDimensions("Cannot change the rank of data", "RawDataFS::extent");
+    }
+    if (extent == h.extent) {
+        return;
+    }
+
+    // elements outside of the extent are always zero
+    clear(h, extent);
+
+    NDSize layout = h.layout;
+    for (size_t d = 0; d < rank; d++) {
+        if (extent[d] > layout[d]) {
+            layout[d] = std::max(extent[d], 2 * layout[d]);
+        }
+    }
+
+    if (layout != h.layout) {
+        size_t data_size = check::fits_in_size_t(layout.nelms() * element_size(h.dtype), "RawDataFS: Data too large");
+        bfs::resize_file(path, h.data_offset + data_size);
+        map();
+
+        NDSize keep(rank);
+        for (size_t d = 0; d < rank; d++) {
+            keep[d] = std::min(h.extent[d], extent[d]);
+        }
+        h.extent = keep;
+        relayout(h, layout);
+    }
+
+    storeShape(extent, layout);
+}
+
+
+void RawDataFS::clear(const Header &h, const NDSize &extent) {
+    const size_t rank = h.extent.size();
+    if (rank == 0) {
+        return;
+    }
+
+    const size_t esize = element_size(h.dtype);
+    const NDSize strides = row_major(h.layout);
+    const ndsize_t row = h.extent[rank - 1];
+    char *data = base() + h.data_offset;
+
+    for_each_index(h.extent, rank - 1, false, [&](const NDSize &index) {
+        ndsize_t first = extent[rank - 1];
+        for (size_t d = 0; d < rank - 1; d++) {
+            if (index[d] >= extent[d]) {
+                first = 0;
+            }
+        }
+        if (first < row) {
+            ndsize_t pos = row_offset(strides, index) + first;
+            std::memset(data + pos * esize, 0, (row - first) * esize);
+        }
+    });
+}
+
+
+void RawDataFS::relayout(const Header &h, const NDSize &layout) {
+    const size_t rank = h.extent.size();
+
+    // the position of an element only depends on the layout of
+    // all but the first dimension
+    bool moved = false;
+    for (size_t d = 1; d < rank; d++) {
+        moved = moved || layout[d] != h.layout[d];
+    }
+    if (!moved) {
+        return;
+    }
+
+    const size_t esize = element_size(h.dtype);
+    const NDSize old_strides = row_major(h.layout);
+    const NDSize new_strides = row_major(layout);
+    const size_t row_bytes = h.extent[rank - 1] * esize;
+    char *data = base() + h.data_offset;
+
+    // elements only move towards the end of the file, so rows are moved
+    // starting with the last one
+    for_each_index(h.extent, rank - 1, true, [&](const NDSize &index) {
+        std::memmove(data + row_offset(new_strides, index) * esize,
+                     data + row_offset(old_strides, index) * esize,
+                     row_bytes);
+    });
+
+    // zero what is left of the old rows
+    for_each_index(layout, rank - 1, false, [&](const NDSize &index) {
+        ndsize_t first = h.extent[rank - 1];
+        for (size_t d = 0; d < rank - 1; d++) {
+            if (index[d] >= h.extent[d]) {
+                first = 0;
+            }
+        }
+        ndsize_t pos = row_offset(new_strides, index) + first;
+        std::memset(data + pos * esize, 0, (layout[rank - 1] - first) * esize);
+    });
+}
+
+
+void RawDataFS::selection(const Header &h, const NDSize &count, const NDSize &offset,
+                          NDSize &file_count, NDSize &file_offset) const {
+    const size_t rank = h.extent.size();
+
+    if (!offset) {
+        // the whole data
+        file_offset = NDSize(rank, 0);
+        file_count = h.extent;
+        if (count && count.nelms() != file_count.nelms()) {
+            throw IncompatibleDimensions("Size of buffer and data do not match", "RawDataFS");
+        }
+    } else {
+        if (offset.size() != rank) {
+            throw IncompatibleDimensions("Offset must have the rank of the data", "RawDataFS");
+        }
+
+        // like for HDF5, the count may have more dimensions than the data,
+        // as long as the number of elements is the same; no count reads
+        // a single element
+        file_offset = offset;
+        file_count = NDSize(rank, 1);
+        if (count) {
+            if (count.size() < rank) {
+                throw IncompatibleDimensions("Count must have at least the rank of the data", "RawDataFS");
+            }
+            for (size_t d = 0; d < rank; d++) {
+                file_count[d] = count[d];
+            }
+            if (count.nelms() != file_count.nelms()) {
+                throw IncompatibleDimensions("Size of buffer and selection do not match", "RawDataFS");
+            }
+        }
+    }
+
+    for (size_t d = 0; d < rank; d++) {
+        if (file_offset[d] + file_count[d] > h.extent[d]) {
+            throw OutOfBounds("RawDataFS: Selection out of bounds", file_offset[d] + file_count[d]);
+        }
+    }
+}
+
+
+/*
+ * Calls fn(position, count) for every contiguous run of elements of the
+ * hyperslab, in row major order. Trailing dimensions that are selected
+ * completely are merged into a single run.
+ */
+template<typename F>
+void RawDataFS::forEachRow(const Header &h, const NDSize &count, const NDSize &offset, F fn) const {
+    const size_t rank = count.size();
+    if (rank == 0) {
+        fn(0, 1);
+        return;
+    }
+    if (count.nelms() == 0) {
+        return;
+    }
+
+    size_t inner = rank - 1;
+    while (inner > 0 && count[inner] == h.layout[inner]) {
+        inner--;
+    }
+
+    ndsize_t run = 1;
+    for (size_t d = inner; d < rank; d++) {
+        run *= count[d];
+    }
+
+    const NDSize strides = row_major(h.layout);
+    const ndsize_t start = offset.dot(strides);
+
+    for_each_index(count, inner, false, [&](const NDSize &index) {
+        fn(start + row_offset(strides, index), run);
+    });
+}
+
+
+/*
+ * Tell the kernel that the elements from the first to the last element of
+ * a hyperslab, given as element positions, will be needed soon.
+ */
+static void advise(const bip::mapped_region &region, const char *data, size_t esize,
+                   const NDSize &strides, const NDSize &count, const NDSize &offset) {
+#if !defined(_WIN32)
+    ndsize_t last = offset.dot(strides);
+    for (size_t d = 0; d < count.size(); d++) {
+        last += (count[d] - 1) * strides[d];
+    }
+    const char *first = data + offset.dot(strides) * esize;
+    const char *end = data + (last + 1) * esize;
+
+    if (static_cast<size_t>(end - first) < advise_threshold) {
+        return;
+    }
+    const size_t page = bip::mapped_region::get_page_size();
+    char *start = static_cast<char *>(region.get_address());
+    size_t begin = (first - start) / page * page;
+    posix_madvise(start + begin, end - start - begin, POSIX_MADV_WILLNEED);
+#endif
+}
+
+
+void RawDataFS::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    const Header h = header();
+    NDSize file_count, file_offset;
+    selection(h, count, offset, file_count, file_offset);
+
+    if (file_count.nelms() == 0) {
+        return;
+    }
+
+    const size_t in_size = element_size(h.dtype);
+    const size_t out_size = element_size(dtype);
+    const char *source = base() + h.data_offset;
+    char *out = static_cast<char *>(data);
+
+    advise(region, source, in_size, row_major(h.layout), file_count, file_offset);
+
+    forEachRow(h, file_count, file_offset, [&](ndsize_t pos, ndsize_t n) {
+        convert(h.dtype, source + pos * in_size, dtype, out, n);
+        out += n * out_size;
+    });
+}
+
+
+void RawDataFS::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    if (mode == FileMode::ReadOnly) {
+        throw std::runtime_error("RawDataFS: Cannot write read only data");
+    }
+
+    const Header h = header();
+    NDSize file_count, file_offset;
+    selection(h, count, offset, file_count, file_offset);
+
+    if (file_count.nelms() == 0) {
+        return;
+    }
+
+    const size_t in_size = element_size(dtype);
+    const size_t out_size = element_size(h.dtype);
+    char *dest = base() + h.data_offset;
+    const char *in = static_cast<const char *>(data);
+
+    advise(region, dest, out_size, row_major(h.layout), file_count, file_offset);
+
+    forEachRow(h, file_count, file_offset, [&](ndsize_t pos, ndsize_t n) {
+        convert(dtype, in, h.dtype, dest + pos * out_size, n);
+        in += n * in_size;
+    });
+}
+
+} // namespace file
+} // namespace nix
@@ -0,0 +1,118 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_RAW_DATA_FS_HPP
+#define NIX_RAW_DATA_FS_HPP
+
+#include <nix/DataType.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/base/IFile.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdint>
+
+namespace nix {
+namespace file {
+
+/**
+ * Bulk data stored as a raw binary file.
+ *
+ * The file starts with a small header: a magic string, the version, the
+ * data type, the rank, the extent and the layout. The header is padded
+ * to 64 bytes, the elements follow in row major order and little endian.
+ *
+ * The layout is the shape the elements are stored in. It can be larger
+ * than the extent, so that the extent can grow without moving elements;
+ * it grows at least by a factor of two, and growth of the first dimension
+ * only appends to the file. All elements outside of the extent are zero.
+ *
+ * The file is memory mapped. Reads and writes of hyperslabs copy directly
+ * between the mapping and the buffer of the caller, converting between
+ * data types when needed. Changes are made in place, so every RawDataFS
+ * of the same file sees them.
+ *
+ * Only fixed size types are supported; String data is rejected with
+ * std::invalid_argument.
+ */
+class RawDataFS {
+
+public:
+
+    /**
+     * Open an existing data file.
+     */
+    RawDataFS(const boost::filesystem::path &path, FileMode mode);
+
+    /**
+     * Create a data file, replacing an existing one.
+     */
+    RawDataFS(const boost::filesystem::path &path, DataType dtype, const NDSize &extent);
+
+    DataType dataType() const;
+
+    NDSize extent() const;
+
+    NDSize layout() const;
+
+    /**
+     * Change the extent; the rank must stay the same. Elements inside the
+     * old and the new extent are kept, new elements are zero.
+     */
+    void extent(const NDSize &extent);
+
+    void read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const;
+
+    void write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset);
+
+    static const uint32_t version = 1;
+
+private:
+
+    struct Header {
+        DataType dtype;
+        size_t data_offset;
+        NDSize extent;
+        NDSize layout;
+    };
+
+    static size_t headerSize(size_t rank);
+
+    static std::vector<char> encodeHeader(DataType dtype, const NDSize &extent, const NDSize &layout);
+
+    Header header() const;
+
+    void storeShape(const NDSize &extent, const NDSize &layout);
+
+    void map() const;
+
+    char *base() const;
+
+    void selection(const Header &h, const NDSize &count, const NDSize &offset,
+                   NDSize &file_count, NDSize &file_offset) const;
+
+    template<typename F>
+    void forEachRow(const Header &h, const NDSize &count, const NDSize &offset, F fn) const;
+
+    void relayout(const Header &h, const NDSize &layout);
+
+    void clear(const Header &h, const NDSize &extent);
+
+    boost::filesystem::path path;
+    FileMode mode;
+
+    mutable boost::interprocess::file_mapping file;
+    mutable boost::interprocess::mapped_region region;
+};
+
+} // namespace file
+} // namespace nix
+
+#endif //NIX_RAW_DATA_FS_HPP
@@ -11,6 +11,7 @@
 #include <nix/File.hpp>
 #include "SectionFS.hpp"
 #include "PropertyFS.hpp"
+#include "FileFS.hpp"
 
 namespace bfs = boost::filesystem;
 
@@ -123,7 +124,7 @@ void SectionFS::link(const std::string &id) {
 std::shared_ptr<base::ISection> SectionFS::link() const {
     std::shared_ptr<base::ISection> sec;
 
-    if (bfs::exists({location() + "/link"})) {
+    if (bfs::exists(bfs::path(location() + "/link"))) {
         auto sec_tmp = std::make_shared<SectionFS>(file(), location() + "/link");
         // re-get above section "sec_tmp": parent missing, findSections will set it!
         auto found = File(file()).findSections(util::IdFilter<Section>(sec_tmp->id()));
@@ -136,8 +137,9 @@ std::shared_ptr<base::ISection> SectionFS::link() const {
 
 
 void SectionFS::link(const none_t t) {
-    if (bfs::exists({location() + "/link"})) {
-        bfs::remove_all({location() + "/link"});
+    if (bfs::exists(bfs::path(location() + "/link"))) {
+        bfs::remove_all(bfs::path(location() + "/link"));
+        invalidate(location(), true);
     }
     forceUpdatedAt();
 }
@@ -200,8 +202,7 @@ std::shared_ptr<base::ISection> SectionFS::getSection(const std::string &name_or
     std::shared_ptr<base::ISection> sec;
     boost::optional<bfs::path> path = subsection_dir.findByNameOrAttribute("entity_id", name_or_id);
     if (path) {
-        SectionFS s(file(), path->string());
-        return std::make_shared<SectionFS>(s);
+        return std::make_shared<SectionFS>(file(), self(), path->string());
     }
     return sec;
 }
@@ -212,7 +213,12 @@ std::shared_ptr<base::ISection> SectionFS::getSection(ndsize_t index) const {
         throw OutOfBounds("Trying to access section.subsection with invalid index.", index);
     }
     bfs::path p = subsection_dir.sub_dir_by_index(index);
-    return std::make_shared<SectionFS>(file(), p.string());
+    return std::make_shared<SectionFS>(file(), self(), p.string());
+}
+
+
+std::shared_ptr<base::ISection> SectionFS::self() const {
+    return std::const_pointer_cast<SectionFS>(shared_from_this());
 }
 
 
@@ -229,6 +235,10 @@ std::shared_ptr<base::ISection> SectionFS::createSection(const std::string &name
 bool SectionFS::deleteSection(const std::string &name_or_id) {
     bool success = true;
     Section s = getSection(name_or_id);
+    if (!s) {
+        return false;
+    }
+    markModified(file());
     success = SectionFS::removeSubsections(s);
     if (success) {
         success = success && subsection_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
@@ -308,7 +318,32 @@ std::shared_ptr<base::IProperty> SectionFS::createProperty(const std::string &na
 
 
 bool SectionFS::deleteProperty(const std::string &name_or_id) {
-    return property_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
+    bool deleted = property_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
+    if (deleted) {
+        markModified(file());
+    }
+    return deleted;
+}
+
+
+std::map<std::string, std::vector<Value>> SectionFS::propertyValues(size_t max_depth) const {
+    std::map<std::string, std::vector<Value>> values;
+
+    for (ndsize_t i = 0; i < propertyCount(); i++) {
+        std::shared_ptr<base::IProperty> p = getProperty(i);
+        values[p->name()] = p->values();
+    }
+
+    if (max_depth > 0) {
+        for (ndsize_t i = 0; i < sectionCount(); i++) {
+            std::shared_ptr<base::ISection> s = getSection(i);
+            for (auto &v : s->propertyValues(max_depth - 1)) {
+                values[s->name() + "/" + v.first] = std::move(v.second);
+            }
+        }
+    }
+
+    return values;
 }
 
 
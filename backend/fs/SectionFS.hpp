@@ -30,6 +30,7 @@ private:
 
     void createSubFolders(const std::shared_ptr<base::IFile> &file);
     bool removeSubsections(Section &section);
+    std::shared_ptr<base::ISection> self() const;
 
 public:
     /**
@@ -156,6 +157,9 @@ public:
 
     bool deleteProperty(const std::string &name_or_id);
 
+
+    std::map<std::string, std::vector<Value>> propertyValues(size_t max_depth) const;
+
     //--------------------------------------------------
     // Ohter methods and operators
     //--------------------------------------------------
@@ -0,0 +1,51 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "SharedCache.hpp"
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
+namespace bfs = boost::filesystem;
+
+namespace nix {
+namespace file {
+
+bool file_stamp(const bfs::path &path, FileStamp &stamp) {
+#if !defined(_WIN32)
+    struct stat st;
+    if (::stat(path.string().c_str(), &st) != 0) {
+        return false;
+    }
+    stamp.key = std::to_string(st.st_dev) + ":" + std::to_string(st.st_ino);
+    stamp.directory = S_ISDIR(st.st_mode);
+    stamp.size = static_cast<uintmax_t>(st.st_size);
+    stamp.mtime = st.st_mtime;
+#if defined(__APPLE__)
+    stamp.mtime_nsec = st.st_mtimespec.tv_nsec;
+#else
+    stamp.mtime_nsec = st.st_mtim.tv_nsec;
+#endif
+    return true;
+#else
+    boost::system::error_code ec;
+    bfs::file_status st = bfs::status(path, ec);
+    if (ec || !bfs::exists(st)) {
+        return false;
+    }
+    stamp.key = bfs::absolute(path).string();
+    stamp.directory = bfs::is_directory(st);
+    stamp.size = stamp.directory ? 0 : bfs::file_size(path, ec);
+    stamp.mtime = bfs::last_write_time(path, ec);
+    return !ec;
+#endif
+}
+
+} // namespace file
+} // namespace nix
@@ -0,0 +1,125 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_SHARED_CACHE_FS_H
+#define NIX_SHARED_CACHE_FS_H
+
+#include <boost/filesystem.hpp>
+
+#include <ctime>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace nix {
+namespace file {
+
+/**
+ * The state of a file or directory as reported by the file system.
+ *
+ * The key is the device and inode of the entry, so that all links to it
+ * share one cache. A cache built from an entry is outdated as soon as the
+ * stamp of the entry differs from the stamp taken when it was built.
+ */
+struct FileStamp {
+    std::string key;
+    bool directory = false;
+    uintmax_t size = 0;
+    time_t mtime = 0;
+    long mtime_nsec = 0;
+
+    bool operator==(const FileStamp &other) const {
+        return key == other.key && directory == other.directory && size == other.size &&
+               mtime == other.mtime && mtime_nsec == other.mtime_nsec;
+    }
+
+    bool operator!=(const FileStamp &other) const {
+        return !(*this == other);
+    }
+};
+
+
+/**
+ * Read the stamp of a file or directory.
+ *
+ * @param path      The file or directory.
+ * @param stamp     Receives the stamp.
+ *
+ * @return False if the entry does not exist.
+ */
+bool file_stamp(const boost::filesystem::path &path, FileStamp &stamp);
+
+
+/**
+ * Caches shared by all handles of the same entry in this process.
+ *
+ * Only weak references are registered, a cache lives as long as one of
+ * its handles and is removed from the registry with the last of them.
+ */
+template<typename Key, typename T>
+class SharedCache {
+
+public:
+    /**
+     * The cache of a key, created with make() if none is alive.
+     */
+    template<typename Make>
+    static std::shared_ptr<T> acquire(const Key &key, Make make) {
+        std::weak_ptr<T> &entry = registry()[key];
+        std::shared_ptr<T> cache = entry.lock();
+        if (!cache) {
+            cache = std::shared_ptr<T>(make(), [key](T *released) {
+                delete released;
+                release(key);
+            });
+            entry = cache;
+        }
+        return cache;
+    }
+
+    /**
+     * The cache of a key, if it is alive.
+     */
+    static std::shared_ptr<T> find(const Key &key) {
+        auto it = registry().find(key);
+        return it != registry().end() ? it->second.lock() : std::shared_ptr<T>();
+    }
+
+    /**
+     * Call fn(key, cache) for every cache that is alive.
+     */
+    template<typename Fn>
+    static void forEach(Fn fn) {
+        for (auto &entry : registry()) {
+            std::shared_ptr<T> cache = entry.second.lock();
+            if (cache) {
+                fn(entry.first, cache);
+            }
+        }
+    }
+
+private:
+    static void release(const Key &key) {
+        auto it = registry().find(key);
+        if (it != registry().end() && it->second.expired()) {
+            registry().erase(it);
+        }
+    }
+
+    static std::map<Key, std::weak_ptr<T>> &registry() {
+        // never destroyed, handles in static objects may be released last
+        static auto *caches = new std::map<Key, std::weak_ptr<T>>();
+        return *caches;
+    }
+};
+
+} // namespace file
+} // namespace nix
+
+#endif // NIX_SHARED_CACHE_FS_H
@@ -12,6 +12,7 @@
 #include "DataArrayHDF5.hpp"
 #include "BlockHDF5.hpp"
 #include "FeatureHDF5.hpp"
+#include "EntityLinksHDF5.hpp"
 
 using namespace nix::base;
 
@@ -47,13 +48,8 @@ BaseTagHDF5::BaseTagHDF5(const std::shared_ptr<IFile> &file, const std::shared_p
 //--------------------------------------------------
 
 bool BaseTagHDF5::hasReference(const std::string &name_or_id) const {
-    std::string id = name_or_id;
-
-    if (!util::looksLikeUUID(name_or_id) && block()->hasDataArray(name_or_id)) {
-        id = block()->getDataArray(name_or_id)->id();
-    }
-
-    return refs_group(false) ? refs_group(false)->hasGroup(id) : false;
+    boost::optional<H5Group> g = refs_group(false);
+    return g ? g->hasGroup(referenceId(name_or_id)) : false;
 }
 
 
@@ -67,15 +63,12 @@ std::shared_ptr<IDataArray>  BaseTagHDF5::getReference(const std::string &name_o
     std::shared_ptr<IDataArray> da;
     boost::optional<H5Group> g = refs_group(false);
 
-    std::string id = name_or_id;
-
-    if (!util::looksLikeUUID(name_or_id) && block()->hasDataArray(name_or_id)) {
-        id = block()->getDataArray(name_or_id)->id();
-    }
-
-    if (g && hasReference(id)) {
-        H5Group group = g->openGroup(id);
-        da = std::make_shared<DataArrayHDF5>(file(), block(), group);
+    if (g) {
+        std::string id = referenceId(name_or_id);
+        if (g->hasGroup(id)) {
+            H5Group group = g->openGroup(id, false);
+            da = std::make_shared<DataArrayHDF5>(file(), block(), group);
+        }
     }
 
     return da;
@@ -88,14 +81,13 @@ std::shared_ptr<IDataArray>  BaseTagHDF5::getReference(ndsize_t index) const {
 }
 
 void BaseTagHDF5::addReference(const std::string &name_or_id) {
-    boost::optional<H5Group> g = refs_group(true);
+    auto target = std::dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
 
-    if (!block()->hasDataArray(name_or_id))
+    if (!target)
         throw std::runtime_error("BaseTagHDF5::addReference: DataArray not found in block!");
 
-    auto target = std::dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
-
-    g->createLink(target->group(), target->id());
+    boost::optional<H5Group> g = refs_group(true);
+    g->addLink(target->group(), target->id());
 }
 
 
@@ -103,11 +95,12 @@ bool BaseTagHDF5::removeReference(const std::string &name_or_id) {
     boost::optional<H5Group> g = refs_group(false);
     bool removed = false;
 
-    if (g && hasReference(name_or_id)) {
-        std::shared_ptr<IDataArray> reference = getReference(name_or_id);
-
-        g->removeGroup(reference->id());
-        removed = true;
+    if (g) {
+        std::string id = referenceId(name_or_id);
+        if (g->hasGroup(id)) {
+            g->deleteLink(id);
+            removed = true;
+        }
     }
 
     return removed;
@@ -115,41 +108,15 @@ bool BaseTagHDF5::removeReference(const std::string &name_or_id) {
 
 
 void BaseTagHDF5::references(const std::vector<DataArray> &refs_new) {
+    auto blck = std::dynamic_pointer_cast<BlockHDF5>(block());
+    replaceLinks(refs_group, *blck, ObjectType::DataArray, linkTargets(refs_new),
+                 "One or more data arrays do not exist in this block!");
+}
+
 
-    // extract vectors of names from vectors of new & old references
-    std::vector<std::string> names_new(refs_new.size());
-    std::transform(refs_new.begin(), refs_new.end(), names_new.begin(), util::toName<DataArray>);
-
-    size_t ref_count = nix::check::fits_in_size_t(referenceCount(), "refrenceCount() failed; count > size_t.");
-    std::vector<DataArray> refs_old(ref_count);
-    for (size_t i = 0; i < refs_old.size(); i++) refs_old[i] = getReference(i);
-    std::vector<std::string> names_old(refs_old.size());
-    std::transform(refs_old.begin(), refs_old.end(), names_old.begin(), util::toName<DataArray>);
-
-    // sort them
-    std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
-
-    // get names only in names_new (add), names only in names_old (remove) & ignore rest
-    std::vector<std::string> names_add;
-    std::vector<std::string> names_rem;
-    std::set_difference(names_new.begin(), names_new.end(), names_old.begin(), names_old.end(),
-            std::inserter(names_add, names_add.begin()));
-    std::set_difference(names_old.begin(), names_old.end(), names_new.begin(), names_new.end(),
-            std::inserter(names_rem, names_rem.begin()));
-
-    // check if all new references exist & add sources
+std::string BaseTagHDF5::referenceId(const std::string &name_or_id) const {
     auto blck = std::dynamic_pointer_cast<BlockHDF5>(block());
-    for (auto name : names_add) {
-        if (!blck->hasDataArray(name))
-            throw std::runtime_error("One or more data arrays do not exist in this block!");
-        addReference(blck->getDataArray(name)->id());
-    }
-    // remove references
-    for (auto name : names_rem) {
-        if (!blck->hasDataArray(name))
-            removeReference(blck->getDataArray(name)->id());
-    }
+    return blck->entityId(ObjectType::DataArray, name_or_id);
 }
 
 //--------------------------------------------------
@@ -101,6 +101,11 @@ public:
     */
     virtual ~BaseTagHDF5();
 
+private:
+
+    // resolve the name or id of a data array to the name of its reference link
+    std::string referenceId(const std::string &name_or_id) const;
+
 };
 
 
@@ -0,0 +1,84 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BatchHDF5.hpp"
+
+#include <nix/util/util.hpp>
+#include "FileHDF5.hpp"
+
+using namespace std;
+
+namespace nix {
+namespace hdf5 {
+
+
+BatchHDF5::BatchHDF5()
+    : last_time(-1)
+{
+}
+
+
+bool BatchHDF5::hasName(const H5Group &group, const string &name) {
+    const unordered_set<string> &index = names(group);
+    return index.find(name) != index.end();
+}
+
+
+void BatchHDF5::addName(const H5Group &group, const string &name) {
+    auto it = name_index.find(group.address());
+    // groups that were not indexed yet will be read including the new name
+    if (it != name_index.end()) {
+        it->second.insert(name);
+    }
+}
+
+
+void BatchHDF5::removeName(const H5Group &group, const string &name) {
+    auto it = name_index.find(group.address());
+    if (it != name_index.end()) {
+        it->second.erase(name);
+    }
+}
+
+
+const string &BatchHDF5::timeToStr(time_t time) {
+    if (time != last_time) {
+        last_time_str = util::timeToStr(time);
+        last_time = time;
+    }
+    return last_time_str;
+}
+
+
+unordered_set<string> &BatchHDF5::names(const H5Group &group) {
+    haddr_t addr = group.address();
+    auto it = name_index.find(addr);
+
+    if (it == name_index.end()) {
+        vector<string> links = group.objectNames();
+        it = name_index.emplace(addr, unordered_set<string>(links.begin(), links.end())).first;
+    }
+
+    return it->second;
+}
+
+
+BatchHDF5 *activeBatch(const shared_ptr<base::IFile> &file) {
+    FileHDF5 *f = dynamic_cast<FileHDF5 *>(file.get());
+    return f ? f->batch() : nullptr;
+}
+
+
+string timeToStr(const shared_ptr<base::IFile> &file, time_t time) {
+    BatchHDF5 *batch = activeBatch(file);
+    return batch ? batch->timeToStr(time) : util::timeToStr(time);
+}
+
+
+} // ns nix::hdf5
+} // ns nix
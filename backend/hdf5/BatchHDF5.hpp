@@ -0,0 +1,99 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BATCH_HDF5_H
+#define NIX_BATCH_HDF5_H
+
+#include <nix/base/IFile.hpp>
+#include "h5x/H5Group.hpp"
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * State of an active batch on a FileHDF5, see {@link nix::File::beginBatch}.
+ *
+ * Holds in-memory indices of the link names inside groups that were
+ * checked for duplicate names and memoizes the formatting of timestamps.
+ */
+class BatchHDF5 {
+
+private:
+
+    // link names per group, keyed by the address of the group in the file
+    std::map<haddr_t, std::unordered_set<std::string>> name_index;
+
+    time_t last_time;
+    std::string last_time_str;
+
+public:
+
+    BatchHDF5();
+
+    /**
+     * Check if the group contains a link with the given name.
+     * The link names are read once per group and batch.
+     */
+    bool hasName(const H5Group &group, const std::string &name);
+
+    /**
+     * Record a newly created link in the index of the group.
+     */
+    void addName(const H5Group &group, const std::string &name);
+
+    /**
+     * Remove a link from the index of the group.
+     */
+    void removeName(const H5Group &group, const std::string &name);
+
+    /**
+     * Convert the given time to its string representation,
+     * the result for the last time is kept.
+     */
+    const std::string &timeToStr(time_t time);
+
+private:
+
+    std::unordered_set<std::string> &names(const H5Group &group);
+
+};
+
+
+/**
+ * Get the active batch of a file.
+ *
+ * @param file      The file to get the batch for.
+ *
+ * @return The active batch or nullptr if there is none.
+ */
+BatchHDF5 *activeBatch(const std::shared_ptr<base::IFile> &file);
+
+
+/**
+ * Convert a time to its string representation. If a batch is active
+ * on the file the conversion is shared between all entities of the batch.
+ *
+ * @param file      The file of the entity.
+ * @param time      The time to convert.
+ *
+ * @return The time as string.
+ */
+std::string timeToStr(const std::shared_ptr<base::IFile> &file, time_t time);
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_BATCH_HDF5_H
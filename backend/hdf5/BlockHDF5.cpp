@@ -15,6 +15,8 @@
 #include "TagHDF5.hpp"
 #include "MultiTagHDF5.hpp"
 #include "GroupHDF5.hpp"
+#include "QueryHDF5.hpp"
+#include "FileHDF5.hpp"
 
 #include <boost/range/irange.hpp>
 
@@ -49,6 +51,23 @@ BlockHDF5::BlockHDF5(const shared_ptr<IFile> &file, const H5Group &group, const
 }
 
 
+static void index_added(const shared_ptr<IFile> &file, const H5Group &container, const H5Group &entity,
+                        const string &name, const string &type) {
+    TypeIndexHDF5 *index = typeIndex(file);
+    if (index) {
+        index->added(container, entity, name, type);
+    }
+}
+
+
+static void index_removed(const shared_ptr<IFile> &file, const H5Group &container, const string &name) {
+    TypeIndexHDF5 *index = typeIndex(file);
+    if (index) {
+        index->removed(container, name);
+    }
+}
+
+
 //--------------------------------------------------
 // Methods concerning sources
 //--------------------------------------------------
@@ -91,7 +110,9 @@ shared_ptr<ISource> BlockHDF5::createSource(const string &name, const string &ty
     boost::optional<H5Group> g = source_group(true);
 
     H5Group group = g->openGroup(name, true);
-    return make_shared<SourceHDF5>(file(), group, id, type, name);
+    auto source = make_shared<SourceHDF5>(file(), group, id, type, name);
+    index_added(file(), *g, group, name, type);
+    return source;
 }
 
 
@@ -110,6 +131,7 @@ bool BlockHDF5::deleteSource(const string &name_or_id) {
             }
             // if hasSource is true then source_group always exists
             deleted = g->removeAllLinks(source.name());
+            index_removed(file(), *g, source.name());
         }
     }
 
@@ -128,7 +150,9 @@ shared_ptr<ITag> BlockHDF5::createTag(const std::string &name, const std::string
     boost::optional<H5Group> g = tag_group(true);
 
     H5Group group = g->openGroup(name);
-    return make_shared<TagHDF5>(file(), block(), group, id, type, name, position);
+    auto tag = make_shared<TagHDF5>(file(), block(), group, id, type, name, position);
+    index_added(file(), *g, group, name, type);
+    return tag;
 }
 
 
@@ -170,7 +194,9 @@ bool BlockHDF5::deleteTag(const std::string &name_or_id) {
 
     if (hasTag(name_or_id) && g) {
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getTag(name_or_id)->name());
+        string name = getTag(name_or_id)->name();
+        deleted = g->removeAllLinks(name);
+        index_removed(file(), *g, name);
     }
 
     return deleted;
@@ -223,6 +249,7 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
 
     H5Group group = g->openGroup(name, true);
     auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
+    index_added(file(), *g, group, name, type);
 
     // now create the actual H5::DataSet
     da->createData(data_type, shape);
@@ -236,7 +263,9 @@ bool BlockHDF5::deleteDataArray(const string &name_or_id) {
 
     if (hasDataArray(name_or_id) && g) {
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getDataArray(name_or_id)->name());
+        string name = getDataArray(name_or_id)->name();
+        deleted = g->removeAllLinks(name);
+        index_removed(file(), *g, name);
     }
 
     return deleted;
@@ -254,7 +283,9 @@ shared_ptr<IMultiTag> BlockHDF5::createMultiTag(const std::string &name, const s
     boost::optional<H5Group> g = multi_tag_group(true);
 
     H5Group group = g->openGroup(name);
-    return make_shared<MultiTagHDF5>(file(), block(), group, id, type, name, positions);
+    auto mtag = make_shared<MultiTagHDF5>(file(), block(), group, id, type, name, positions);
+    index_added(file(), *g, group, name, type);
+    return mtag;
 }
 
 
@@ -296,7 +327,9 @@ bool BlockHDF5::deleteMultiTag(const std::string &name_or_id) {
 
     if (hasMultiTag(name_or_id) && g) {
         // we get first "entity" link by name, but delete all others whatever their name with it
-        deleted = g->removeAllLinks(getMultiTag(name_or_id)->name());
+        string name = getMultiTag(name_or_id)->name();
+        deleted = g->removeAllLinks(name);
+        index_removed(file(), *g, name);
     }
 
     return deleted;
@@ -311,7 +344,9 @@ shared_ptr<IGroup> BlockHDF5::createGroup(const std::string &name, const std::st
     boost::optional<H5Group> g = groups_group(true);
 
     H5Group group = g->openGroup(name);
-    return make_shared<GroupHDF5>(file(), block(), group, id, type, name);
+    auto grp = make_shared<GroupHDF5>(file(), block(), group, id, type, name);
+    index_added(file(), *g, group, name, type);
+    return grp;
 }
 
 
@@ -351,7 +386,9 @@ bool BlockHDF5::deleteGroup(const std::string &name_or_id) {
     bool deleted = false;
 
     if (hasGroup(name_or_id) && g) {
-        deleted = g->removeAllLinks(getGroup(name_or_id)->name());
+        string name = getGroup(name_or_id)->name();
+        deleted = g->removeAllLinks(name);
+        index_removed(file(), *g, name);
     }
     return deleted;
 }
@@ -362,6 +399,69 @@ shared_ptr<IBlock> BlockHDF5::block() const {
 }
 
 
+boost::optional<H5Group> BlockHDF5::openEntity(ObjectType type, const string &name) const {
+    boost::optional<H5Group> entity;
+    boost::optional<H5Group> g = collection(type)();
+
+    if (g && g->hasGroup(name)) {
+        entity = g->openGroup(name, false);
+    }
+
+    return entity;
+}
+
+
+string BlockHDF5::entityId(ObjectType type, const string &name_or_id) const {
+    string id = name_or_id;
+
+    if (!util::looksLikeUUID(name_or_id)) {
+        boost::optional<H5Group> entity = openEntity(type, name_or_id);
+        if (entity) {
+            entity->getAttr("entity_id", id);
+        }
+    }
+
+    return id;
+}
+
+
+const optGroup &BlockHDF5::collection(ObjectType type) const {
+    switch (type) {
+        case ObjectType::Source:    return source_group;
+        case ObjectType::DataArray: return data_array_group;
+        case ObjectType::Tag:       return tag_group;
+        case ObjectType::MultiTag:  return multi_tag_group;
+        case ObjectType::Group:     return groups_group;
+        default: break;
+    }
+    throw std::invalid_argument("BlockHDF5::collection: unsupported object type");
+}
+
+
+//--------------------------------------------------
+// Queries
+//--------------------------------------------------
+
+
+static vector<string> matching_names(const shared_ptr<IFile> &file, const boost::optional<H5Group> &container,
+                                     const util::Query &query) {
+    boost::optional<vector<string>> types = query.allowedValues(util::Query::Field::Type);
+    TypeIndexHDF5 *index = typeIndex(file);
+
+    if (!container || !types || !index) {
+        return hdf5::matchingNames(file, container, query);
+    }
+
+    // only entities of the requested types are opened
+    return hdf5::matchingNames(file, *container, index->find(*container, *types), query);
+}
+
+
+vector<string> BlockHDF5::matchingNames(ObjectType type, const util::Query &query) const {
+    return matching_names(file(), collection(type)(), query);
+}
+
+
 BlockHDF5::~BlockHDF5() {
 }
 
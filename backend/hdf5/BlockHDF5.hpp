@@ -170,6 +170,13 @@ public:
 
     bool deleteGroup(const std::string &name_or_id);
 
+    //--------------------------------------------------
+    // Queries
+    //--------------------------------------------------
+
+
+    std::vector<std::string> matchingNames(ObjectType type, const util::Query &query) const;
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -180,6 +187,38 @@ public:
 
     std::shared_ptr<base::IBlock> block() const;
 
+
+    /**
+     * Open the group of an entity of this block by its name, without
+     * searching the collection for ids.
+     *
+     * @param type      The type of the entity.
+     * @param name      The name of the entity.
+     *
+     * @return The group or an unset optional if there is no such entity.
+     */
+    boost::optional<H5Group> openEntity(ObjectType type, const std::string &name) const;
+
+
+    /**
+     * Resolve the name or id of an entity of this block to its id.
+     *
+     * Strings that look like ids are returned unchanged and names are
+     * resolved via the link of the entity, so that the collection is
+     * never searched.
+     *
+     * @param type          The type of the entity.
+     * @param name_or_id    The name or id of the entity.
+     *
+     * @return The id of the entity or name_or_id if there is no entity
+     *         with this name.
+     */
+    std::string entityId(ObjectType type, const std::string &name_or_id) const;
+
+private:
+
+    const optGroup &collection(ObjectType type) const;
+
 };
 
 
@@ -11,6 +11,7 @@
 #include "DataArrayHDF5.hpp"
 #include "h5x/H5DataSet.hpp"
 #include "DimensionHDF5.hpp"
+#include "FileHDF5.hpp"
 
 using namespace std;
 using namespace nix::base;
@@ -157,16 +158,28 @@ void DataArrayHDF5::polynomCoefficients(const none_t t) {
 
 
 ndsize_t DataArrayHDF5::dimensionCount() const {
+    checkDimensions();
+    if (dimension_count) {
+        return *dimension_count;
+    }
+
     boost::optional<H5Group> g = dimension_group();
 	ndsize_t count = 0;
 	if (g) {
 		count = g->objectCount();
 	}
+    dimension_count = count;
     return count;
 }
 
 
 shared_ptr<IDimension> DataArrayHDF5::getDimension(ndsize_t index) const {
+    checkDimensions();
+    auto it = dimensions.find(index);
+    if (it != dimensions.end()) {
+        return it->second;
+    }
+
     shared_ptr<IDimension> dim;
     boost::optional<H5Group> g = dimension_group();
 
@@ -174,7 +187,8 @@ shared_ptr<IDimension> DataArrayHDF5::getDimension(ndsize_t index) const {
         string str_id = util::numToStr(index);
         if (g->hasGroup(str_id)) {
             H5Group group = g->openGroup(str_id, false);
-            dim = openDimensionHDF5(group, index);
+            dim = openDimensionHDF5(file(), group, index);
+            dimensions[index] = dim;
         }
     }
 
@@ -182,27 +196,55 @@ shared_ptr<IDimension> DataArrayHDF5::getDimension(ndsize_t index) const {
 }
 
 
+template<typename T>
+shared_ptr<T> DataArrayHDF5::cacheDimension(ndsize_t index, const shared_ptr<T> &dim) {
+    checkDimensions();
+    dimensions[index] = dim;
+    return dim;
+}
+
+
+void DataArrayHDF5::checkDimensions() const {
+    size_t revision = dataRevision(file());
+    if (!dimensions_revision || *dimensions_revision != revision) {
+        dimensions.clear();
+        dimension_count = boost::none;
+        dimensions_revision = revision;
+    }
+}
+
+
+void DataArrayHDF5::dimensionsChanged() {
+    markDataModified(file());
+}
+
+
+void DataArrayHDF5::dataChanged() {
+    markDataModified(file());
+}
+
+
 std::shared_ptr<base::ISetDimension> DataArrayHDF5::createSetDimension(ndsize_t index) {
     H5Group g = createDimensionGroup(index);
-    return make_shared<SetDimensionHDF5>(g, index);
+    return cacheDimension(index, make_shared<SetDimensionHDF5>(file(), g, index));
 }
 
 
 std::shared_ptr<base::IRangeDimension> DataArrayHDF5::createRangeDimension(ndsize_t index, const std::vector<double> &ticks) {
     H5Group g = createDimensionGroup(index);
-    return make_shared<RangeDimensionHDF5>(g, index, ticks);
+    return cacheDimension(index, make_shared<RangeDimensionHDF5>(file(), g, index, ticks));
 }
 
 
 std::shared_ptr<base::IRangeDimension> DataArrayHDF5::createAliasRangeDimension() {
     H5Group g = createDimensionGroup(1);
-    return make_shared<RangeDimensionHDF5>(g, 1, *this);
+    return cacheDimension(1, make_shared<RangeDimensionHDF5>(file(), g, 1, *this));
 }
 
 
 std::shared_ptr<base::ISampledDimension> DataArrayHDF5::createSampledDimension(ndsize_t index, double sampling_interval) {
     H5Group g = createDimensionGroup(index);
-    return make_shared<SampledDimensionHDF5>(g, index, sampling_interval);
+    return cacheDimension(index, make_shared<SampledDimensionHDF5>(file(), g, index, sampling_interval));
 }
 
 
@@ -218,7 +260,9 @@ H5Group DataArrayHDF5::createDimensionGroup(ndsize_t index) {
         g->removeGroup(str_id);
     }
 
-    return g->openGroup(str_id, true);
+    H5Group dim_group = g->openGroup(str_id, true);
+    dimensionsChanged();
+    return dim_group;
 }
 
 
@@ -243,6 +287,9 @@ bool DataArrayHDF5::deleteDimension(ndsize_t index) {
         }
     }
 
+    if (deleted) {
+        dimensionsChanged();
+    }
     return deleted;
 }
 
@@ -277,6 +324,7 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
     DataSet ds = group().openData("data");
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
     ds.write(data, memType, count, offset);
+    dataChanged();
 }
 
 void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
@@ -305,6 +353,7 @@ void DataArrayHDF5::dataExtent(const NDSize &extent) {
 
     DataSet ds = group().openData("data");
     ds.setExtent(extent);
+    dataChanged();
 }
 
 DataType DataArrayHDF5::dataType(void) const {
@@ -19,6 +19,8 @@
 
 #include <boost/multi_array.hpp>
 
+#include <map>
+
 namespace nix {
 namespace hdf5 {
 
@@ -32,6 +34,12 @@ private:
 
     optGroup dimension_group;
 
+    // Dimensions and their count as read at the data revision of the
+    // file in dimensions_revision; dropped when the revision changes.
+    mutable std::map<ndsize_t, std::shared_ptr<base::IDimension>> dimensions;
+    mutable boost::optional<ndsize_t> dimension_count;
+    mutable boost::optional<size_t> dimensions_revision;
+
 public:
 
     /**
@@ -152,6 +160,18 @@ private:
 
     // small helper for handling dimension groups
     H5Group createDimensionGroup(ndsize_t index);
+
+    template<typename T>
+    std::shared_ptr<T> cacheDimension(ndsize_t index, const std::shared_ptr<T> &dim);
+
+    // drop the cached dimensions if the data revision of the file changed
+    void checkDimensions() const;
+
+    // the ticks of an alias range dimension are the data, so both
+    // increment the data revision of the file
+    void dimensionsChanged();
+
+    void dataChanged();
 };
 
 
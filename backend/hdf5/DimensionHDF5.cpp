@@ -7,8 +7,12 @@
 // LICENSE file in the root of the Project.
 
 #include "DimensionHDF5.hpp"
+#include "FileHDF5.hpp"
 #include <nix/util/util.hpp>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace std;
 using namespace nix::base;
 
@@ -61,7 +65,7 @@ std::string dimensionTypeToStr(DimensionType dim) {
 }
 
 
-shared_ptr<IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index) {
+shared_ptr<IDimension> openDimensionHDF5(const shared_ptr<IFile> &file, const H5Group &group, ndsize_t index) {
     string type_name;
     group.getAttr("dimension_type", type_name);
 
@@ -70,13 +74,13 @@ shared_ptr<IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index) {
 
     switch (type) {
         case DimensionType::Set:
-            dim = make_shared<SetDimensionHDF5>(group, index);
+            dim = make_shared<SetDimensionHDF5>(file, group, index);
             break;
         case DimensionType::Range:
-            dim = make_shared<RangeDimensionHDF5>(group, index);
+            dim = make_shared<RangeDimensionHDF5>(file, group, index);
             break;
         case DimensionType::Sample:
-            dim = make_shared<SampledDimensionHDF5>(group, index);
+            dim = make_shared<SampledDimensionHDF5>(file, group, index);
             break;
     }
 
@@ -86,8 +90,8 @@ shared_ptr<IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index) {
 
 // Implementation of Dimension
 
-DimensionHDF5::DimensionHDF5(const H5Group &group, ndsize_t index)
-    : group(group), dim_index(index)
+DimensionHDF5::DimensionHDF5(const shared_ptr<IFile> &file, const H5Group &group, ndsize_t index)
+    : entity_file(file), group(group), dim_index(index)
 {
 }
 
@@ -98,6 +102,21 @@ void DimensionHDF5::setType() {
 }
 
 
+bool DimensionHDF5::cacheValid() const {
+    return cache_revision && *cache_revision == dataRevision(entity_file);
+}
+
+
+void DimensionHDF5::cacheUpdated() const {
+    cache_revision = dataRevision(entity_file);
+}
+
+
+void DimensionHDF5::modified() {
+    markDataModified(entity_file);
+}
+
+
 bool DimensionHDF5::operator==(const DimensionHDF5 &other) const {
     return group == other.group;
 }
@@ -114,13 +133,14 @@ DimensionHDF5::~DimensionHDF5() {}
 // Implementation of SampledDimension
 //--------------------------------------------------------------
 
-SampledDimensionHDF5::SampledDimensionHDF5(const H5Group &group, ndsize_t index)
-    : DimensionHDF5(group, index)
+SampledDimensionHDF5::SampledDimensionHDF5(const shared_ptr<IFile> &file, const H5Group &group, ndsize_t index)
+    : DimensionHDF5(file, group, index)
 {
 }
 
-SampledDimensionHDF5::SampledDimensionHDF5(const H5Group &group, ndsize_t index, double sampling_interval)
-    : SampledDimensionHDF5(group, index)
+SampledDimensionHDF5::SampledDimensionHDF5(const shared_ptr<IFile> &file, const H5Group &group, ndsize_t index,
+                                           double sampling_interval)
+    : SampledDimensionHDF5(file, group, index)
 {
     setType();
     this->samplingInterval(sampling_interval);
@@ -132,19 +152,30 @@ DimensionType SampledDimensionHDF5::dimensionType() const {
 }
 
 
-boost::optional<std::string> SampledDimensionHDF5::label() const {
-    boost::optional<std::string> ret;
-    string label;
-    bool have_attr = group.getAttr("label", label);
-    if (have_attr) {
-        ret = label;
+void SampledDimensionHDF5::loadAttrs() const {
+    if (cacheValid()) {
+        return;
     }
-    return ret;
+
+    string str;
+    double value;
+    label_value = group.getAttr("label", str) ? boost::make_optional(str) : boost::none;
+    unit_value = group.getAttr("unit", str) ? boost::make_optional(str) : boost::none;
+    interval_value = group.getAttr("sampling_interval", value) ? boost::make_optional(value) : boost::none;
+    offset_value = group.getAttr("offset", value) ? boost::make_optional(value) : boost::none;
+    cacheUpdated();
+}
+
+
+boost::optional<std::string> SampledDimensionHDF5::label() const {
+    loadAttrs();
+    return label_value;
 }
 
 
 void SampledDimensionHDF5::label(const string &label) {
     group.setAttr("label", label);
+    modified();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -153,23 +184,20 @@ void SampledDimensionHDF5::label(const none_t t) {
     if (group.hasAttr("label")) {
         group.removeAttr("label");
     }
+    modified();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
 
 boost::optional<std::string> SampledDimensionHDF5::unit() const {
-    boost::optional<std::string> ret;
-    string unit;
-    bool have_attr = group.getAttr("unit", unit);
-    if (have_attr) {
-        ret = unit;
-    }
-    return ret;
+    loadAttrs();
+    return unit_value;
 }
 
 
 void SampledDimensionHDF5::unit(const string &unit) {
     group.setAttr("unit", unit);
+    modified();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -178,16 +206,15 @@ void SampledDimensionHDF5::unit(const none_t t) {
     if (group.hasAttr("unit")) {
         group.removeAttr("unit");
     }
+    modified();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
 
 double SampledDimensionHDF5::samplingInterval() const {
-    double sampling_interval;
-
-    if (group.hasAttr("sampling_interval")) {
-        group.getAttr("sampling_interval", sampling_interval);
-        return sampling_interval;
+    loadAttrs();
+    if (interval_value) {
+        return *interval_value;
     } else {
         throw MissingAttr("sampling_interval");
     }
@@ -196,21 +223,19 @@ double SampledDimensionHDF5::samplingInterval() const {
 
 void SampledDimensionHDF5::samplingInterval(double sampling_interval) {
     group.setAttr("sampling_interval", sampling_interval);
+    modified();
 }
 
 
 boost::optional<double> SampledDimensionHDF5::offset() const {
-    boost::optional<double> ret;
-    double offset = 0;
-    if (group.getAttr("offset", offset)) {
-        ret = offset;
-    }
-    return ret;
+    loadAttrs();
+    return offset_value;
 }
 
 
 void SampledDimensionHDF5::offset(double offset) {
     group.setAttr("offset", offset);
+    modified();
 }
 
 
@@ -218,6 +243,7 @@ void SampledDimensionHDF5::offset(const none_t t) {
     if (group.hasAttr("offset")) {
         group.removeAttr("offset");
     }
+    modified();
 }
 
 
@@ -227,8 +253,8 @@ SampledDimensionHDF5::~SampledDimensionHDF5() {}
 // Implementation of SetDimensionHDF5
 //--------------------------------------------------------------
 
-SetDimensionHDF5::SetDimensionHDF5(const H5Group &group, ndsize_t index)
-    : DimensionHDF5(group, index)
+SetDimensionHDF5::SetDimensionHDF5(const shared_ptr<IFile> &file, const H5Group &group, ndsize_t index)
+    : DimensionHDF5(file, group, index)
 {
     setType();
 }
@@ -240,21 +266,26 @@ DimensionType SetDimensionHDF5::dimensionType() const {
 
 
 vector<string> SetDimensionHDF5::labels() const {
-    vector<string> labels;
-
-    group.getData("labels", labels);
-    return labels;
+    if (!cacheValid()) {
+        vector<string> labels;
+        group.getData("labels", labels);
+        labels_value = labels;
+        cacheUpdated();
+    }
+    return labels_value;
 }
 
 
 void SetDimensionHDF5::labels(const vector<string> &labels) {
    group.setData("labels", labels);
+   modified();
 }
 
 void SetDimensionHDF5::labels(const none_t t) {
     if (group.hasData("labels")) {
         group.removeData("labels");
     }
+    modified();
 }
 
 SetDimensionHDF5::~SetDimensionHDF5() {}
@@ -263,22 +294,27 @@ SetDimensionHDF5::~SetDimensionHDF5() {}
 // Implementation of RangeDimensionHDF5
 //--------------------------------------------------------------
 
-RangeDimensionHDF5::RangeDimensionHDF5(const H5Group &group, ndsize_t index)
-    : DimensionHDF5(group, index)
+const ndsize_t RangeDimensionHDF5::cache_limit = 1 << 20;
+
+
+RangeDimensionHDF5::RangeDimensionHDF5(const shared_ptr<IFile> &file, const H5Group &group, ndsize_t index)
+    : DimensionHDF5(file, group, index)
 {
 }
 
 
-RangeDimensionHDF5::RangeDimensionHDF5(const H5Group &group, ndsize_t index, vector<double> ticks)
-    : RangeDimensionHDF5(group, index)
+RangeDimensionHDF5::RangeDimensionHDF5(const shared_ptr<IFile> &file, const H5Group &group, ndsize_t index,
+                                       vector<double> ticks)
+    : RangeDimensionHDF5(file, group, index)
 {
     setType();
     this->ticks(ticks);
 }
 
 
-RangeDimensionHDF5::RangeDimensionHDF5(const H5Group &group, ndsize_t index, const DataArrayHDF5 &array)
-    :RangeDimensionHDF5(group, index)
+RangeDimensionHDF5::RangeDimensionHDF5(const shared_ptr<IFile> &file, const H5Group &group, ndsize_t index,
+                                       const DataArrayHDF5 &array)
+    :RangeDimensionHDF5(file, group, index)
 {
     setType();
     this->group.createLink(array.group(), array.id());
@@ -291,14 +327,15 @@ DimensionType RangeDimensionHDF5::dimensionType() const {
 
 
 H5Group RangeDimensionHDF5::redirectGroup() const {
-    H5Group g;
-    if (alias()) {
-        string group_name = group.objectName(0);
-        g = group.openGroup(group_name, false);
-    } else {
-        g = group;
+    if (!redirect_group) {
+        if (alias()) {
+            string group_name = group.objectName(0);
+            redirect_group = group.openGroup(group_name, false);
+        } else {
+            redirect_group = group;
+        }
     }
-    return g;
+    return *redirect_group;
 }
 
 
@@ -363,21 +400,40 @@ bool RangeDimensionHDF5::alias() const {
 }
 
 
-vector<double> RangeDimensionHDF5::ticks() const {
-    vector<double> ticks;
+DataSet RangeDimensionHDF5::ticksData() const {
     H5Group g = redirectGroup();
     if (g.hasData("ticks")) {
-        g.getData("ticks", ticks);
-        return ticks;
+        return g.openData("ticks");
     } else if (g.hasData("data")) {
-        g.getData("data", ticks);
-        return ticks;
+        return g.openData("data");
     } else {
         throw MissingAttr("ticks");
     }
 }
 
 
+void RangeDimensionHDF5::cacheTicks(const vector<double> &ticks) const {
+    if (ticks.size() <= cache_limit) {
+        tick_cache = ticks;
+        cacheUpdated();
+    } else {
+        vector<double>().swap(tick_cache);
+        cache_revision = boost::none;
+    }
+}
+
+
+vector<double> RangeDimensionHDF5::ticks() const {
+    if (cacheValid()) {
+        return tick_cache;
+    }
+    vector<double> ticks;
+    ticksData().read(ticks, true);
+    cacheTicks(ticks);
+    return ticks;
+}
+
+
 void RangeDimensionHDF5::ticks(const vector<double> &ticks) {
     H5Group g = redirectGroup();
     if (!alias()) {
@@ -390,8 +446,159 @@ void RangeDimensionHDF5::ticks(const vector<double> &ticks) {
     } else {
         throw MissingAttr("ticks");
     }
+    modified();
+    cacheTicks(ticks);
 }
 
+
+ndsize_t RangeDimensionHDF5::tickCount() const {
+    if (cacheValid()) {
+        return tick_cache.size();
+    }
+    NDSize size = ticksData().size();
+    return size.size() > 0 ? size[0] : 0;
+}
+
+
+namespace {
+
+// Index of the first tick not less than the position, clamped to the ticks.
+ndsize_t tick_index(const vector<double> &ticks, double position) {
+    if (ticks.empty() || position < ticks.front()) {
+        return 0;
+    } else if (position > ticks.back()) {
+        return ticks.size() - 1;
+    }
+    return lower_bound(ticks.begin(), ticks.end(), position) - ticks.begin();
+}
+
+
+/*
+ * Binary search in a tick data set that is too large to be read at once.
+ * The block that contains a position is located by reading the first tick
+ * of blocks, which are as large as the chunks of the data set, and only this
+ * block is read. The last block read is kept, so that searching positions in
+ * ascending order reads every block at most once.
+ */
+class TickSearch {
+
+public:
+
+    TickSearch(const DataSet &ds, ndsize_t count)
+        : ds(ds), count(count), block_start(0)
+    {
+        NDSize chunks = ds.chunking();
+        block_size = chunks.size() > 0 ? max<ndsize_t>(chunks[0], 1024) : 8192;
+        first = at(0);
+        last = at(count - 1);
+    }
+
+    ndsize_t index(double position) {
+        if (position < first) {
+            return 0;
+        } else if (position > last) {
+            return count - 1;
+        }
+
+        ndsize_t lo = 0, hi = (count + block_size - 1) / block_size;
+        while (lo < hi) {
+            ndsize_t mid = lo + (hi - lo) / 2;
+            if (at(mid * block_size) < position) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == 0) {
+            return 0;
+        }
+
+        load((lo - 1) * block_size);
+        return block_start + (lower_bound(block.begin(), block.end(), position) - block.begin());
+    }
+
+private:
+
+    DataSet ds;
+    ndsize_t count, block_size, block_start;
+    vector<double> block;
+    double first, last;
+
+    double at(ndsize_t i) {
+        if (i >= block_start && i - block_start < block.size()) {
+            return block[i - block_start];
+        }
+        double value;
+        ds.read(&value, data_type_to_h5_memtype(DataType::Double), NDSize({1}), NDSize({i}));
+        return value;
+    }
+
+    void load(ndsize_t start) {
+        if (start == block_start && !block.empty()) {
+            return;
+        }
+        ndsize_t n = min(block_size, count - start);
+        block.resize(n);
+        ds.read(block.data(), data_type_to_h5_memtype(DataType::Double), NDSize({n}), NDSize({start}));
+        block_start = start;
+    }
+};
+
+} // anonymous namespace
+
+
+vector<double> RangeDimensionHDF5::ticks(ndsize_t start, ndsize_t count) const {
+    ndsize_t tick_count = tickCount();
+    if (start > tick_count || count > tick_count - start) {
+        throw OutOfBounds("RangeDimension: requested ticks are out of range!");
+    }
+
+    if (cacheValid()) {
+        return vector<double>(tick_cache.begin() + start, tick_cache.begin() + start + count);
+    }
+
+    vector<double> ticks(count);
+    if (count > 0) {
+        ticksData().read(ticks.data(), data_type_to_h5_memtype(DataType::Double), NDSize({count}), NDSize({start}));
+    }
+    return ticks;
+}
+
+
+vector<ndsize_t> RangeDimensionHDF5::indexOf(const vector<double> &positions) const {
+    vector<ndsize_t> indices(positions.size());
+
+    if (!cacheValid()) {
+        DataSet ds = ticksData();
+        NDSize size = ds.size();
+        ndsize_t count = size.size() > 0 ? size[0] : 0;
+
+        if (count > cache_limit) {
+            // search in ascending order to reuse blocks
+            vector<size_t> order(positions.size());
+            iota(order.begin(), order.end(), 0);
+            sort(order.begin(), order.end(), [&positions](size_t a, size_t b) {
+                return positions[a] < positions[b];
+            });
+            TickSearch search(ds, count);
+            for (size_t i : order) {
+                indices[i] = search.index(positions[i]);
+            }
+            return indices;
+        }
+
+        vector<double> ticks;
+        ds.read(ticks, true);
+        cacheTicks(ticks);
+    }
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        indices[i] = tick_index(tick_cache, positions[i]);
+    }
+    return indices;
+}
+
+
 RangeDimensionHDF5::~RangeDimensionHDF5() {}
 
 } // ns nix::hdf5
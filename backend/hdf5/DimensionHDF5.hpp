@@ -27,19 +27,25 @@ DimensionType dimensionTypeFromStr(const std::string &str);
 std::string dimensionTypeToStr(DimensionType dim);
 
 
-std::shared_ptr<base::IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index);
+std::shared_ptr<base::IDimension> openDimensionHDF5(const std::shared_ptr<base::IFile> &file,
+                                                    const H5Group &group, ndsize_t index);
 
 
 class DimensionHDF5 : virtual public base::IDimension {
 
 protected:
 
+    std::shared_ptr<base::IFile> entity_file;
     H5Group group;
     ndsize_t dim_index;
 
+    // data revision of the file at which the cached values were read,
+    // none if nothing is cached
+    mutable boost::optional<size_t> cache_revision;
+
 public:
 
-    DimensionHDF5(const H5Group &group, ndsize_t index);
+    DimensionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group, ndsize_t index);
 
 
     ndsize_t index() const { return dim_index; }
@@ -57,6 +63,21 @@ protected:
 
     void setType();
 
+    /**
+     * Whether the cached values are still up to date, i.e. no data or
+     * dimension of the file was changed since they were read.
+     */
+    bool cacheValid() const;
+
+
+    void cacheUpdated() const;
+
+    /**
+     * Record a change of the dimension, which outdates the cached values
+     * of all handles.
+     */
+    void modified();
+
 };
 
 
@@ -64,10 +85,11 @@ class SampledDimensionHDF5 : virtual public base::ISampledDimension, public Dime
 
 public:
 
-    SampledDimensionHDF5(const H5Group &group, ndsize_t index);
+    SampledDimensionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group, ndsize_t index);
 
 
-    SampledDimensionHDF5(const H5Group &group, ndsize_t index, double sampling_interval);
+    SampledDimensionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group, ndsize_t index,
+                         double sampling_interval);
 
 
     DimensionType dimensionType() const;
@@ -108,6 +130,14 @@ public:
 
     virtual ~SampledDimensionHDF5();
 
+private:
+
+    // attributes as read at the cache revision
+    mutable boost::optional<std::string> label_value, unit_value;
+    mutable boost::optional<double> interval_value, offset_value;
+
+    void loadAttrs() const;
+
 };
 
 
@@ -115,7 +145,7 @@ class SetDimensionHDF5 : virtual public base::ISetDimension, public DimensionHDF
 
 public:
 
-    SetDimensionHDF5(const H5Group &group, ndsize_t index);
+    SetDimensionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group, ndsize_t index);
 
 
     DimensionType dimensionType() const;
@@ -132,6 +162,11 @@ public:
 
     virtual ~SetDimensionHDF5();
 
+private:
+
+    // labels as read at the cache revision
+    mutable std::vector<std::string> labels_value;
+
 };
 
 
@@ -139,13 +174,15 @@ class RangeDimensionHDF5 : virtual public base::IRangeDimension, public Dimensio
 
 public:
 
-    RangeDimensionHDF5(const H5Group &group, ndsize_t index);
+    RangeDimensionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group, ndsize_t index);
 
 
-    RangeDimensionHDF5(const H5Group &group, ndsize_t index, std::vector<double> ticks);
+    RangeDimensionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group, ndsize_t index,
+                       std::vector<double> ticks);
 
 
-    RangeDimensionHDF5(const H5Group &group, ndsize_t index, const DataArrayHDF5 &dataArray );
+    RangeDimensionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group, ndsize_t index,
+                       const DataArrayHDF5 &dataArray);
 
 
     DimensionType dimensionType() const;
@@ -178,11 +215,34 @@ public:
     void ticks(const std::vector<double> &ticks);
 
 
+    ndsize_t tickCount() const;
+
+
+    std::vector<double> ticks(ndsize_t start, ndsize_t count) const;
+
+
+    std::vector<ndsize_t> indexOf(const std::vector<double> &positions) const;
+
+
     virtual ~RangeDimensionHDF5();
 
 private:
 
+    // Ticks are kept in memory up to this number, until the data of the
+    // file changes; larger tick arrays are searched on disk.
+    static const ndsize_t cache_limit;
+
+    mutable std::vector<double> tick_cache;
+
+    // the group holding ticks and attributes, the data array of an
+    // alias range dimension
+    mutable boost::optional<H5Group> redirect_group;
+
     H5Group redirectGroup() const;
+
+    DataSet ticksData() const;
+
+    void cacheTicks(const std::vector<double> &ticks) const;
 };
 
 
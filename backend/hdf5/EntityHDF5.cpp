@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include "EntityHDF5.hpp"
+#include "FileHDF5.hpp"
 
 #include <nix/util/util.hpp>
 
@@ -60,14 +61,16 @@ time_t EntityHDF5::updatedAt() const {
 void EntityHDF5::setUpdatedAt() {
     if (!group().hasAttr("updated_at")) {
         time_t t = util::getTime();
-        group().setAttr("updated_at", util::timeToStr(t));
+        group().setAttr("updated_at", timeToStr(file(), t));
+        markModified(file());
     }
 }
 
 
 void EntityHDF5::forceUpdatedAt() {
     time_t t = util::getTime();
-    group().setAttr("updated_at", util::timeToStr(t));
+    group().setAttr("updated_at", timeToStr(file(), t));
+    markModified(file());
 }
 
 
@@ -81,13 +84,13 @@ time_t EntityHDF5::createdAt() const {
 void EntityHDF5::setCreatedAt() {
     if (!group().hasAttr("created_at")) {
         time_t t = util::getTime();
-        group().setAttr("created_at", util::timeToStr(t));
+        group().setAttr("created_at", timeToStr(file(), t));
     }
 }
 
 
 void EntityHDF5::forceCreatedAt(time_t t) {
-    group().setAttr("created_at", util::timeToStr(t));
+    group().setAttr("created_at", timeToStr(file(), t));
 }
 
 
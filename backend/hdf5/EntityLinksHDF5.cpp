@@ -0,0 +1,72 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "EntityLinksHDF5.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+using namespace std;
+
+namespace nix {
+namespace hdf5 {
+
+
+void replaceLinks(const optGroup &links, const BlockHDF5 &block, ObjectType type,
+                  link_targets_t targets, const string &error) {
+    sort(targets.begin(), targets.end());
+    targets.erase(unique(targets.begin(), targets.end()), targets.end());
+
+    // the links are named by the ids of their targets
+    vector<string> ids_old;
+    boost::optional<H5Group> g = links(false);
+    if (g) {
+        ids_old = g->objectNames();
+        sort(ids_old.begin(), ids_old.end());
+    }
+
+    vector<string> ids_new(targets.size());
+    transform(targets.begin(), targets.end(), ids_new.begin(),
+              [](const pair<string, string> &t) { return t.first; });
+
+    // open all targets that are not linked yet before changing anything
+    vector<pair<string, H5Group>> add;
+    auto old = ids_old.cbegin();
+    for (const auto &target : targets) {
+        old = lower_bound(old, ids_old.cend(), target.first);
+        if (old != ids_old.cend() && *old == target.first) {
+            continue;
+        }
+
+        boost::optional<H5Group> entity = block.openEntity(type, target.second);
+        string id;
+        if (!entity || !entity->getAttr("entity_id", id) || id != target.first) {
+            throw runtime_error(error);
+        }
+        add.emplace_back(target.first, *entity);
+    }
+
+    vector<string> rem;
+    set_difference(ids_old.begin(), ids_old.end(), ids_new.begin(), ids_new.end(), back_inserter(rem));
+
+    for (const string &id : rem) {
+        g->deleteLink(id);
+    }
+
+    if (!add.empty()) {
+        g = links(true);
+        for (const auto &entry : add) {
+            g->addLink(entry.second, entry.first);
+        }
+    }
+}
+
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,64 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_LINKS_HDF5_H
+#define NIX_ENTITY_LINKS_HDF5_H
+
+#include "BlockHDF5.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * Pairs of id and name of the entities a group should link to.
+ */
+typedef std::vector<std::pair<std::string, std::string>> link_targets_t;
+
+
+/**
+ * Get id and name of the given entities.
+ */
+template<typename T>
+link_targets_t linkTargets(const std::vector<T> &entities) {
+    link_targets_t targets;
+    targets.reserve(entities.size());
+    for (const T &e : entities) {
+        targets.emplace_back(e.id(), e.name());
+    }
+    return targets;
+}
+
+
+/**
+ * Replace the links in a group, e.g. the references of a tag, by links to
+ * the given entities of a block.
+ *
+ * Links are named by the ids of their targets. Only the differences between
+ * the existing and the new links are applied; all new targets are checked
+ * before any link is changed.
+ *
+ * @param links     The group that holds the links.
+ * @param block     The block that holds the entities.
+ * @param type      The type of the entities.
+ * @param targets   Id and name of the entities to link to.
+ * @param error     Message of the exception thrown if one of the targets
+ *                  is not an entity of the block.
+ */
+void replaceLinks(const optGroup &links, const BlockHDF5 &block, ObjectType type,
+                  link_targets_t targets, const std::string &error);
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_ENTITY_LINKS_HDF5_H
@@ -62,12 +62,10 @@ shared_ptr<ISection> EntityWithMetadataHDF5::metadata() const {
 
     if (group().hasGroup("metadata")) {
         H5Group other_group = group().openGroup("metadata", false);
-        auto sec_tmp = make_shared<EntityWithMetadataHDF5>(file(), other_group);
-        // re-get above section "sec_tmp": we just got it to have id, parent is missing, 
-        // findSections will return it with parent!
-        auto found = File(file()).findSections(util::IdFilter<Section>(sec_tmp->id()));
-        if (found.size() > 0) {
-            sec = found.front().impl();
+        auto target = make_shared<SectionHDF5>(file(), other_group);
+        // the section may have been deleted from the tree while still linked here
+        if (target->attached()) {
+            sec = target;
         }
     }
 
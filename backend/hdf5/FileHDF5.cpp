@@ -11,8 +11,12 @@
 #include <nix/util/util.hpp>
 #include "BlockHDF5.hpp"
 #include "SectionHDF5.hpp"
+#include "QueryHDF5.hpp"
+#include "RepackHDF5.hpp"
 #include "h5x/H5Exception.hpp"
 
+#include <boost/filesystem.hpp>
+
 #include <fstream>
 #include <vector>
 #include <ctime>
@@ -47,6 +51,7 @@ static unsigned int map_file_mode(FileMode mode) {
 
 
 FileHDF5::FileHDF5(const string &name, FileMode mode)
+    : batch_depth(0), revision_count(0), data_revision_count(0)
 {
     if (!fileExists(name)) {
         mode = FileMode::Overwrite;
@@ -125,6 +130,8 @@ bool FileHDF5::deleteBlock(const std::string &name_or_id) {
     if (hasBlock(name_or_id)) {
         // we get first "entity" link by name, but delete all others whatever their name with it
         deleted = data.removeAllLinks(getBlock(name_or_id)->name());
+        // addresses of the removed groups may be reused
+        type_index.clear();
     }
 
     return deleted;
@@ -142,6 +149,9 @@ ndsize_t FileHDF5::blockCount() const {
 
 
 bool FileHDF5::hasSection(const std::string &name_or_id) const {
+    if (active_batch && !util::looksLikeUUID(name_or_id)) {
+        return active_batch->hasName(metadata, name_or_id);
+    }
     return getSection(name_or_id) != nullptr;
 }
 
@@ -151,7 +161,7 @@ shared_ptr<base::ISection> FileHDF5::getSection(const std::string &name_or_id) c
 
     boost::optional<H5Group> group = metadata.findGroupByNameOrAttribute("entity_id", name_or_id);
     if (group)
-        sec = make_shared<SectionHDF5>(file(), *group);
+        sec = make_shared<SectionHDF5>(file(), nullptr, *group);
 
     return sec;
 }
@@ -167,6 +177,10 @@ shared_ptr<base::ISection> FileHDF5::createSection(const string &name, const  st
     string id = util::createId();
 
     H5Group group = metadata.openGroup(name, true);
+    group.setRefAttr("parent", metadata);
+    if (active_batch) {
+        active_batch->addName(metadata, name);
+    }
     return make_shared<SectionHDF5>(file(), group, id, type, name);
 }
 
@@ -184,6 +198,11 @@ bool FileHDF5::deleteSection(const std::string &name_or_id) {
         }
         // if hasSection is true then section_group always exists
         deleted = metadata.removeAllLinks(section.name());
+
+        if (active_batch) {
+            active_batch->removeName(metadata, section.name());
+        }
+        modified();
     }
 
     return deleted;
@@ -195,6 +214,111 @@ ndsize_t FileHDF5::sectionCount() const {
 }
 
 
+//--------------------------------------------------
+// Queries
+//--------------------------------------------------
+
+
+vector<string> FileHDF5::matchingNames(ObjectType type, const util::Query &query) const {
+    switch (type) {
+        case ObjectType::Block:   return hdf5::matchingNames(file(), data, query);
+        case ObjectType::Section: return hdf5::matchingNames(file(), metadata, query);
+        default: break;
+    }
+    throw std::invalid_argument("FileHDF5::matchingNames: unsupported object type");
+}
+
+
+//--------------------------------------------------
+// Batch operations
+//--------------------------------------------------
+
+
+void FileHDF5::beginBatch() {
+    if (batch_depth++ == 0) {
+        active_batch.reset(new BatchHDF5());
+    }
+}
+
+
+void FileHDF5::endBatch() {
+    if (batch_depth == 0 || --batch_depth > 0) {
+        return;
+    }
+
+    active_batch.reset();
+
+    // write everything the batch has left in the metadata cache at once
+    flush();
+}
+
+
+void FileHDF5::abandonBatch() {
+    if (batch_depth == 0 || --batch_depth > 0) {
+        return;
+    }
+
+    active_batch.reset();
+}
+
+
+BatchHDF5 *FileHDF5::batch() const {
+    return active_batch.get();
+}
+
+
+size_t FileHDF5::revision() const {
+    return revision_count;
+}
+
+
+void FileHDF5::modified() {
+    revision_count++;
+}
+
+
+size_t FileHDF5::dataRevision() const {
+    return data_revision_count;
+}
+
+
+void FileHDF5::dataModified() {
+    data_revision_count++;
+}
+
+
+TypeIndexHDF5 &FileHDF5::typeIndex() {
+    return type_index;
+}
+
+
+void markModified(const shared_ptr<base::IFile> &file) {
+    FileHDF5 *f = dynamic_cast<FileHDF5 *>(file.get());
+    if (f) {
+        f->modified();
+    }
+}
+
+
+size_t dataRevision(const shared_ptr<base::IFile> &file) {
+    FileHDF5 *f = dynamic_cast<FileHDF5 *>(file.get());
+    return f ? f->dataRevision() : 0;
+}
+
+
+void markDataModified(const shared_ptr<base::IFile> &file) {
+    FileHDF5 *f = dynamic_cast<FileHDF5 *>(file.get());
+    if (f) {
+        f->dataModified();
+    }
+}
+
+
+TypeIndexHDF5 *typeIndex(const shared_ptr<base::IFile> &file) {
+    FileHDF5 *f = dynamic_cast<FileHDF5 *>(file.get());
+    return f ? &f->typeIndex() : nullptr;
+}
+
 //--------------------------------------------------
 // Local attributes
 //--------------------------------------------------
@@ -272,11 +396,36 @@ string FileHDF5::location() const {
 }
 
 
+void FileHDF5::flush() {
+    if (isOpen() && mode != FileMode::ReadOnly) {
+        HErr res = H5Fflush(hid, H5F_SCOPE_LOCAL);
+        res.check("FileHDF5::flush(): Could not flush file");
+    }
+}
+
+
+void FileHDF5::repack(const std::string &path, const StorageOptions &options) const {
+    boost::system::error_code ec;
+    if (boost::filesystem::equivalent(location(), path, ec)) {
+        throw std::invalid_argument("FileHDF5::repack(): Cannot repack a file into itself");
+    }
+    if (mode != FileMode::ReadOnly) {
+        HErr res = H5Fflush(hid, H5F_SCOPE_LOCAL);
+        res.check("FileHDF5::repack(): Could not flush file");
+    }
+    RepackHDF5 repack(options);
+    repack.copy(root, path);
+}
+
+
 void FileHDF5::close() {
 
     if (!isOpen())
         return;
 
+    active_batch.reset();
+    batch_depth = 0;
+
     data.close();
     metadata.close();
     root.close();
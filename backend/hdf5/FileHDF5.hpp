@@ -11,6 +11,8 @@
 
 #include <nix/base/IFile.hpp>
 #include "h5x/H5Group.hpp"
+#include "BatchHDF5.hpp"
+#include "TypeIndexHDF5.hpp"
 
 #include <string>
 #include <memory>
@@ -30,6 +32,19 @@ private:
     H5Group root, metadata, data;
     FileMode mode;
 
+    /* state of the active batch, see beginBatch() */
+    std::unique_ptr<BatchHDF5> active_batch;
+    size_t batch_depth;
+
+    /* incremented on every modification of an entity, see revision() */
+    size_t revision_count;
+
+    /* incremented on every change of data or dimensions, see dataRevision() */
+    size_t data_revision_count;
+
+    /* index of the entity types in the collections of blocks */
+    TypeIndexHDF5 type_index;
+
 public:
 
     /**
@@ -84,6 +99,13 @@ public:
 
     bool deleteSection(const std::string &name_or_id);
 
+    //--------------------------------------------------
+    // Queries
+    //--------------------------------------------------
+
+
+    std::vector<std::string> matchingNames(ObjectType type, const util::Query &query) const;
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -119,12 +141,65 @@ public:
     void close();
 
 
+    void flush();
+
+
+    void repack(const std::string &path, const StorageOptions &options) const;
+
+
     bool isOpen() const;
 
 
     FileMode fileMode() const;
 
 
+    void beginBatch();
+
+
+    void endBatch();
+
+
+    void abandonBatch();
+
+
+    /**
+     * Get the active batch of the file.
+     *
+     * @return The batch or nullptr if no batch is active.
+     */
+    BatchHDF5 *batch() const;
+
+
+    size_t revision() const;
+
+
+    /**
+     * Record a modification of an entity of the file.
+     */
+    void modified();
+
+
+    /**
+     * Revision of the data and dimensions of all data arrays of the file.
+     *
+     * Handles that cache data or dimensions compare it to the revision
+     * they read them at, so that writes through other handles are seen.
+     */
+    size_t dataRevision() const;
+
+
+    /**
+     * Record a change of data or dimensions of a data array of the file.
+     */
+    void dataModified();
+
+
+    /**
+     * Get the index of entity types, see {@link TypeIndexHDF5}.
+     */
+    TypeIndexHDF5 &typeIndex();
+
+
     bool operator==(const FileHDF5 &other) const;
 
 
@@ -146,6 +221,45 @@ private:
 };
 
 
+/**
+ * Record a modification of an entity of the given file, which
+ * increments the revision of the file.
+ *
+ * @param file      The file of the modified entity.
+ */
+void markModified(const std::shared_ptr<base::IFile> &file);
+
+
+/**
+ * Get the data revision of the given file, see {@link FileHDF5::dataRevision}.
+ *
+ * @param file      The file.
+ *
+ * @return The revision or 0 if the file is not a FileHDF5.
+ */
+size_t dataRevision(const std::shared_ptr<base::IFile> &file);
+
+
+/**
+ * Record a change of data or dimensions of a data array of the given
+ * file, which increments the data revision of the file.
+ *
+ * @param file      The file of the changed data array.
+ */
+void markDataModified(const std::shared_ptr<base::IFile> &file);
+
+
+/**
+ * Get the type index of the given file.
+ *
+ * @param file      The file.
+ *
+ * @return The index or nullptr if the file is not a FileHDF5.
+ */
+TypeIndexHDF5 *typeIndex(const std::shared_ptr<base::IFile> &file);
+
+
+
 } // namespace hdf5
 } // namespace nix
 
@@ -11,6 +11,7 @@
 #include "TagHDF5.hpp"
 #include "MultiTagHDF5.hpp"
 #include "BlockHDF5.hpp"
+#include "EntityLinksHDF5.hpp"
 #include <boost/range/irange.hpp>
 
 using namespace nix::base;
@@ -43,11 +44,8 @@ GroupHDF5::GroupHDF5(const std::shared_ptr<base::IFile> &file, const std::shared
 
 
 bool GroupHDF5::hasDataArray(const std::string &name_or_id) const {
-    std::string id = name_or_id;
-    if (!util::looksLikeUUID(name_or_id) && block()->hasDataArray(name_or_id)) {
-        id = block()->getDataArray(name_or_id)->id();
-    }
-    return data_array_group(false) ? data_array_group(false)->hasGroup(id) : false;
+    boost::optional<H5Group> g = data_array_group(false);
+    return g ? g->hasGroup(linkId(ObjectType::DataArray, name_or_id)) : false;
 }
 
 
@@ -58,29 +56,28 @@ ndsize_t GroupHDF5::dataArrayCount() const {
 
 
 void GroupHDF5::addDataArray(const std::string &name_or_id) {
-    boost::optional<H5Group> g = data_array_group(true);
+    auto target = std::dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
 
-    if (!block()->hasDataArray(name_or_id))
+    if (!target)
         throw std::runtime_error("GroupHDF5::addDataArray: DataArray not found in block!");
 
-    auto target = std::dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
-    g->createLink(target->group(), target->id());
+    boost::optional<H5Group> g = data_array_group(true);
+    g->addLink(target->group(), target->id());
 }
 
 
 std::shared_ptr<base::IDataArray> GroupHDF5::getDataArray(const std::string &name_or_id) const {
-    std::shared_ptr<IDataArray> da;
+    std::shared_ptr<IDataArray> entity;
     boost::optional<H5Group> g = data_array_group(false);
-    std::string id = name_or_id;
-    if (!util::looksLikeUUID(name_or_id) && block()->hasDataArray(name_or_id)) {
-        id = block()->getDataArray(name_or_id)->id();
-    }
 
-    if (g && hasDataArray(id)) {
-        H5Group h5g = g->openGroup(id);
-        da = std::make_shared<DataArrayHDF5>(file(), block(), h5g);
+    if (g) {
+        std::string id = linkId(ObjectType::DataArray, name_or_id);
+        if (g->hasGroup(id)) {
+            H5Group h5g = g->openGroup(id, false);
+            entity = std::make_shared<DataArrayHDF5>(file(), block(), h5g);
+        }
     }
-    return da;
+    return entity;
 }
 
 
@@ -95,61 +92,27 @@ bool GroupHDF5::removeDataArray(const std::string &name_or_id) {
     boost::optional<H5Group> g = data_array_group(false);
     bool removed = false;
 
-    if (g && hasDataArray(name_or_id)) {
-        std::shared_ptr<IDataArray> data_array = getDataArray(name_or_id);
-
-        g->removeGroup(data_array->id());
-        removed = true;
+    if (g) {
+        std::string id = linkId(ObjectType::DataArray, name_or_id);
+        if (g->hasGroup(id)) {
+            g->deleteLink(id);
+            removed = true;
+        }
     }
     return removed;
 }
 
 
 void GroupHDF5::dataArrays(const std::vector<DataArray> &data_arrays) {
-
-    // extract vectors of names from vectors of new & old references
-    std::vector<std::string> names_new(data_arrays.size());
-    std::transform(data_arrays.begin(), data_arrays.end(), names_new.begin(), util::toName<DataArray>);
-
-    size_t array_count = nix::check::fits_in_size_t(dataArrayCount(), "dataArrayCount() failed; count > size_t.");
-    std::vector<DataArray> refs_old(array_count);
-    for (size_t i = 0; i < refs_old.size(); i++) refs_old[i] = getDataArray(i);
-    std::vector<std::string> names_old(refs_old.size());
-    std::transform(refs_old.begin(), refs_old.end(), names_old.begin(), util::toName<DataArray>);
-
-    // sort them
-    std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
-
-    // get names only in names_new (add), names only in names_old (remove) & ignore rest
-    std::vector<std::string> names_add;
-    std::vector<std::string> names_rem;
-    std::set_difference(names_new.begin(), names_new.end(), names_old.begin(), names_old.end(),
-                        std::inserter(names_add, names_add.begin()));
-    std::set_difference(names_old.begin(), names_old.end(), names_new.begin(), names_new.end(),
-                        std::inserter(names_rem, names_rem.begin()));
-
-    // check if all new data_arrays exist & add them
     auto blck = std::dynamic_pointer_cast<BlockHDF5>(block());
-    for (auto name : names_add) {
-        if (!blck->hasDataArray(name))
-            throw std::runtime_error("One or more data arrays do not exist in this block!");
-        addDataArray(blck->getDataArray(name)->id());
-    }
-    // remove references
-    for (auto name : names_rem) {
-        if (!blck->hasDataArray(name))
-            removeDataArray(blck->getDataArray(name)->id());
-    }
+    replaceLinks(data_array_group, *blck, ObjectType::DataArray, linkTargets(data_arrays),
+                 "One or more data arrays do not exist in this block!");
 }
 
 
 bool GroupHDF5::hasTag(const std::string &name_or_id) const {
-    std::string id = name_or_id;
-    if (!util::looksLikeUUID(name_or_id) && block()->hasTag(name_or_id)) {
-        id = block()->getTag(name_or_id)->id();
-    }
-    return tag_group(false) ? tag_group(false)->hasGroup(id) : false;
+    boost::optional<H5Group> g = tag_group(false);
+    return g ? g->hasGroup(linkId(ObjectType::Tag, name_or_id)) : false;
 }
 
 
@@ -160,29 +123,28 @@ ndsize_t GroupHDF5::tagCount() const {
 
 
 void GroupHDF5::addTag(const std::string &name_or_id) {
-    boost::optional<H5Group> g = tag_group(true);
+    auto target = std::dynamic_pointer_cast<TagHDF5>(block()->getTag(name_or_id));
 
-    if (!block()->hasTag(name_or_id))
+    if (!target)
         throw std::runtime_error("GroupHDF5::addTag: Tag not found in block!");
 
-    auto target = std::dynamic_pointer_cast<TagHDF5>(block()->getTag(name_or_id));
-    g->createLink(target->group(), target->id());
+    boost::optional<H5Group> g = tag_group(true);
+    g->addLink(target->group(), target->id());
 }
 
 
 std::shared_ptr<base::ITag> GroupHDF5::getTag(const std::string &name_or_id) const {
-    std::shared_ptr<ITag> da;
+    std::shared_ptr<ITag> entity;
     boost::optional<H5Group> g = tag_group(false);
-    std::string id = name_or_id;
-    if (!util::looksLikeUUID(name_or_id) && block()->hasTag(name_or_id)) {
-        id = block()->getTag(name_or_id)->id();
-    }
 
-    if (g && hasTag(id)) {
-        H5Group h5g = g->openGroup(id);
-        da = std::make_shared<TagHDF5>(file(), block(), h5g);
+    if (g) {
+        std::string id = linkId(ObjectType::Tag, name_or_id);
+        if (g->hasGroup(id)) {
+            H5Group h5g = g->openGroup(id, false);
+            entity = std::make_shared<TagHDF5>(file(), block(), h5g);
+        }
     }
-    return da;
+    return entity;
 }
 
 
@@ -197,61 +159,27 @@ bool GroupHDF5::removeTag(const std::string &name_or_id) {
     boost::optional<H5Group> g = tag_group(false);
     bool removed = false;
 
-    if (g && hasTag(name_or_id)) {
-        std::shared_ptr<ITag> tag = getTag(name_or_id);
-
-        g->removeGroup(tag->id());
-        removed = true;
+    if (g) {
+        std::string id = linkId(ObjectType::Tag, name_or_id);
+        if (g->hasGroup(id)) {
+            g->deleteLink(id);
+            removed = true;
+        }
     }
     return removed;
 }
 
 
 void GroupHDF5::tags(const std::vector<Tag> &tags) {
-
-    // extract vectors of names from vectors of new & old references
-    std::vector<std::string> names_new(tags.size());
-    std::transform(tags.begin(), tags.end(), names_new.begin(), util::toName<Tag>);
-
-    size_t tag_count = nix::check::fits_in_size_t(tagCount(), "tagCount() failed; count > size_t.");
-    std::vector<Tag> refs_old(tag_count);
-    for (size_t i = 0; i < refs_old.size(); i++) refs_old[i] = getTag(i);
-    std::vector<std::string> names_old(refs_old.size());
-    std::transform(refs_old.begin(), refs_old.end(), names_old.begin(), util::toName<Tag>);
-
-    // sort them
-    std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
-
-    // get names only in names_new (add), names only in names_old (remove) & ignore rest
-    std::vector<std::string> names_add;
-    std::vector<std::string> names_rem;
-    std::set_difference(names_new.begin(), names_new.end(), names_old.begin(), names_old.end(),
-                        std::inserter(names_add, names_add.begin()));
-    std::set_difference(names_old.begin(), names_old.end(), names_new.begin(), names_new.end(),
-                        std::inserter(names_rem, names_rem.begin()));
-
-    // check if all new tags exist & add them
     auto blck = std::dynamic_pointer_cast<BlockHDF5>(block());
-    for (auto name : names_add) {
-        if (!blck->hasTag(name))
-            throw std::runtime_error("One or more tags do not exist in this block!");
-        addTag(blck->getTag(name)->id());
-    }
-    // remove references
-    for (auto name : names_rem) {
-        if (!blck->hasTag(name))
-            removeTag(blck->getTag(name)->id());
-    }
+    replaceLinks(tag_group, *blck, ObjectType::Tag, linkTargets(tags),
+                 "One or more tags do not exist in this block!");
 }
 
 
 bool GroupHDF5::hasMultiTag(const std::string &name_or_id) const {
-    std::string id = name_or_id;
-    if (!util::looksLikeUUID(name_or_id) && block()->hasMultiTag(name_or_id)) {
-        id = block()->getMultiTag(name_or_id)->id();
-    }
-    return multi_tag_group(false) ? multi_tag_group(false)->hasGroup(id) : false;
+    boost::optional<H5Group> g = multi_tag_group(false);
+    return g ? g->hasGroup(linkId(ObjectType::MultiTag, name_or_id)) : false;
 }
 
 
@@ -262,29 +190,28 @@ ndsize_t GroupHDF5::multiTagCount() const {
 
 
 void GroupHDF5::addMultiTag(const std::string &name_or_id) {
-    boost::optional<H5Group> g = multi_tag_group(true);
+    auto target = std::dynamic_pointer_cast<MultiTagHDF5>(block()->getMultiTag(name_or_id));
 
-    if (!block()->hasMultiTag(name_or_id))
+    if (!target)
         throw std::runtime_error("GroupHDF5::addMultiTag: MultiTag not found in block!");
 
-    auto target = std::dynamic_pointer_cast<MultiTagHDF5>(block()->getMultiTag(name_or_id));
-    g->createLink(target->group(), target->id());
+    boost::optional<H5Group> g = multi_tag_group(true);
+    g->addLink(target->group(), target->id());
 }
 
 
 std::shared_ptr<base::IMultiTag> GroupHDF5::getMultiTag(const std::string &name_or_id) const {
-    std::shared_ptr<IMultiTag> da;
+    std::shared_ptr<IMultiTag> entity;
     boost::optional<H5Group> g = multi_tag_group(false);
-    std::string id = name_or_id;
-    if (!util::looksLikeUUID(name_or_id) && block()->hasMultiTag(name_or_id)) {
-        id = block()->getMultiTag(name_or_id)->id();
-    }
 
-    if (g && hasMultiTag(id)) {
-        H5Group h5g = g->openGroup(id);
-        da = std::make_shared<MultiTagHDF5>(file(), block(), h5g);
+    if (g) {
+        std::string id = linkId(ObjectType::MultiTag, name_or_id);
+        if (g->hasGroup(id)) {
+            H5Group h5g = g->openGroup(id, false);
+            entity = std::make_shared<MultiTagHDF5>(file(), block(), h5g);
+        }
     }
-    return da;
+    return entity;
 }
 
 
@@ -299,51 +226,27 @@ bool GroupHDF5::removeMultiTag(const std::string &name_or_id) {
     boost::optional<H5Group> g = multi_tag_group(false);
     bool removed = false;
 
-    if (g && hasMultiTag(name_or_id)) {
-        std::shared_ptr<IMultiTag> mtag = getMultiTag(name_or_id);
-
-        g->removeGroup(mtag->id());
-        removed = true;
+    if (g) {
+        std::string id = linkId(ObjectType::MultiTag, name_or_id);
+        if (g->hasGroup(id)) {
+            g->deleteLink(id);
+            removed = true;
+        }
     }
     return removed;
 }
 
 
 void GroupHDF5::multiTags(const std::vector<MultiTag> &multi_tags) {
-    // extract vectors of names from vectors of new & old references
-    std::vector<std::string> names_new(multi_tags.size());
-    std::transform(multi_tags.begin(), multi_tags.end(), names_new.begin(), util::toName<MultiTag>);
-
-    size_t mtag_count = nix::check::fits_in_size_t(multiTagCount(), "multiTagCount() failed; count > size_t.");
-    std::vector<MultiTag> refs_old(mtag_count);
-    for (size_t i = 0; i < refs_old.size(); i++) refs_old[i] = getMultiTag(i);
-    std::vector<std::string> names_old(refs_old.size());
-    std::transform(refs_old.begin(), refs_old.end(), names_old.begin(), util::toName<MultiTag>);
-
-    // sort them
-    std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
-
-    // get names only in names_new (add), names only in names_old (remove) & ignore rest
-    std::vector<std::string> names_add;
-    std::vector<std::string> names_rem;
-    std::set_difference(names_new.begin(), names_new.end(), names_old.begin(), names_old.end(),
-                        std::inserter(names_add, names_add.begin()));
-    std::set_difference(names_old.begin(), names_old.end(), names_new.begin(), names_new.end(),
-                        std::inserter(names_rem, names_rem.begin()));
-
-    // check if all new tags exist & add them
     auto blck = std::dynamic_pointer_cast<BlockHDF5>(block());
-    for (auto name : names_add) {
-        if (!blck->hasMultiTag(name))
-            throw std::runtime_error("One or more MultiTag do not exist in this block!");
-        addMultiTag(blck->getMultiTag(name)->id());
-    }
-    // remove references
-    for (auto name : names_rem) {
-        if (!blck->hasMultiTag(name))
-            removeMultiTag(blck->getMultiTag(name)->id());
-    }
+    replaceLinks(multi_tag_group, *blck, ObjectType::MultiTag, linkTargets(multi_tags),
+                 "One or more MultiTag do not exist in this block!");
+}
+
+
+std::string GroupHDF5::linkId(ObjectType type, const std::string &name_or_id) const {
+    auto blck = std::dynamic_pointer_cast<BlockHDF5>(block());
+    return blck->entityId(type, name_or_id);
 }
 
 } // hdf5
@@ -113,6 +113,11 @@ public:
 
 
     virtual void multiTags(const std::vector<MultiTag> &multi_tags);
+
+private:
+
+    // resolve the name or id of an entity of the block to the name of its link
+    std::string linkId(ObjectType type, const std::string &name_or_id) const;
 };
 }
 }
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include "NamedEntityHDF5.hpp"
+#include "FileHDF5.hpp"
 
 #include <nix/util/util.hpp>
 
@@ -54,6 +55,10 @@ void NamedEntityHDF5::type(const string &type) {
         throw EmptyString("type");
     } else {
         group().setAttr("type", type);
+        TypeIndexHDF5 *index = typeIndex(file());
+        if (index) {
+            index->retyped(group(), type);
+        }
         forceUpdatedAt();
     }
 }
@@ -7,10 +7,13 @@
 // LICENSE file in the root of the Project.
 
 #include "PropertyHDF5.hpp"
+#include "FileHDF5.hpp"
 
 #include <nix/util/util.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 
 using namespace std;
 
@@ -93,14 +96,16 @@ time_t PropertyHDF5::updatedAt() const {
 void PropertyHDF5::setUpdatedAt() {
     if (!dataset().hasAttr("updated_at")) {
         time_t t = util::getTime();
-        dataset().setAttr("updated_at", util::timeToStr(t));
+        dataset().setAttr("updated_at", timeToStr(entity_file, t));
+        markModified(entity_file);
     }
 }
 
 
 void PropertyHDF5::forceUpdatedAt() {
     time_t t = util::getTime();
-    dataset().setAttr("updated_at", util::timeToStr(t));
+    dataset().setAttr("updated_at", timeToStr(entity_file, t));
+    markModified(entity_file);
 }
 
 
@@ -114,13 +119,13 @@ time_t PropertyHDF5::createdAt() const {
 void PropertyHDF5::setCreatedAt() {
     if (!dataset().hasAttr("created_at")) {
         time_t t = util::getTime();
-        dataset().setAttr("created_at", util::timeToStr(t));
+        dataset().setAttr("created_at", timeToStr(entity_file, t));
     }
 }
 
 
 void PropertyHDF5::forceCreatedAt(time_t t) {
-    dataset().setAttr("created_at", util::timeToStr(t));
+    dataset().setAttr("created_at", timeToStr(entity_file, t));
 }
 
 
@@ -265,7 +270,7 @@ struct FileValue<bool>  {
 //
 
 template<typename T>
-h5x::DataType h5_type_for_value(bool for_memory)
+h5x::DataType make_h5_type_for_value(bool for_memory)
 {
     typedef FileValue<T> file_value_t;
 
@@ -285,6 +290,17 @@ h5x::DataType h5_type_for_value(bool for_memory)
     return ct;
 }
 
+
+template<typename T>
+const h5x::DataType &h5_type_for_value(bool for_memory)
+{
+    // the compound types never change, so they are built once per process
+    static const h5x::DataType mem_type = make_h5_type_for_value<T>(true);
+    static const h5x::DataType file_type = make_h5_type_for_value<T>(false);
+
+    return for_memory ? mem_type : file_type;
+}
+
 #if 0 //set to one to check that all supported DataTypes are handled
 #define CHECK_SUPOORTED_VALUES
 #endif
@@ -311,30 +327,92 @@ h5x::DataType PropertyHDF5::fileTypeForValue(DataType dtype)
 }
 
 
+// Allocator for the strings of the compound values: HDF5 would allocate
+// every string with malloc, here they are placed in a few large blocks
+// that are released at once.
+class StringBlocks {
+
+public:
+
+    StringBlocks() : used(0), free(0), total(0) { }
+
+    // called by HDF5, exceptions must not unwind through the C library
+    static void *allocate(size_t size, void *info) {
+        try {
+            return static_cast<StringBlocks *>(info)->get(size);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    size_t size() const {
+        return total;
+    }
+
+private:
+
+    static const size_t block_size = 64 * 1024;
+
+    void *get(size_t size) {
+        if (size > free) {
+            size_t n = std::max(size, block_size);
+            blocks.emplace_back(new char[n]);
+            used = 0;
+            free = n;
+        }
+        char *mem = blocks.back().get() + used;
+        used += size;
+        free -= size;
+        total += size;
+        return mem;
+    }
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t used, free, total;
+};
+
+const size_t StringBlocks::block_size;
+
+
 template<typename T>
 void do_read_value(const DataSet &h5ds, size_t size, std::vector<Value> &values)
 {
-    h5x::DataType memType = h5_type_for_value<T>(true);
+    const h5x::DataType &memType = h5_type_for_value<T>(true);
 
     typedef FileValue<T> file_value_t;
-    std::vector<file_value_t> fileValues;
+    std::vector<file_value_t> fileValues(size);
+    StringBlocks strings;
 
-    fileValues.resize(size);
-    values.resize(size);
+    h5ds.readVlen(fileValues.data(), memType, StringBlocks::allocate, &strings);
 
-    h5ds.read(fileValues.data(), memType, H5S_ALL, H5S_ALL);
-
-    std::transform(fileValues.begin(), fileValues.end(), values.begin(), [](const file_value_t &val) {
-        Value temp(val.val());
+    values.reserve(size);
+    for (const file_value_t &val : fileValues) {
+        values.emplace_back(val.val());
+        Value &temp = values.back();
         temp.uncertainty = val.uncertainty;
         temp.reference = val.reference;
         temp.filename = val.filename;
         temp.encoder = val.encoder;
         temp.checksum = val.checksum;
-        return temp;
-    });
+    }
+}
+
+
+template<typename T>
+void do_read_column(const DataSet &h5ds, size_t size, ValueColumn &column)
+{
+    const h5x::DataType &memType = h5_type_for_value<T>(true);
+
+    typedef FileValue<T> file_value_t;
+    std::vector<file_value_t> fileValues(size);
+    StringBlocks strings;
+
+    h5ds.readVlen(fileValues.data(), memType, StringBlocks::allocate, &strings);
 
-    h5ds.vlenReclaim(memType, fileValues.data());
+    column.reserve(size, strings.size());
+    for (const file_value_t &val : fileValues) {
+        column.append(val.val(), val.uncertainty, val.reference, val.filename, val.encoder, val.checksum);
+    }
 }
 
 
@@ -359,7 +437,7 @@ void do_write_value(DataSet &h5ds, const std::vector<Value> &values)
         return fileVal;
     });
 
-    h5x::DataType memType = h5_type_for_value<T>(true);
+    const h5x::DataType &memType = h5_type_for_value<T>(true);
     h5ds.write(fileValues.data(), memType, H5S_ALL, H5S_ALL);
 }
 
@@ -367,6 +445,7 @@ void do_write_value(DataSet &h5ds, const std::vector<Value> &values)
 
 void PropertyHDF5::deleteValues() {
     dataset().setExtent({0});
+    markModified(entity_file);
 }
 
 
@@ -390,6 +469,8 @@ void PropertyHDF5::values(const std::vector<Value> &values)
         return; //nothing to do
     }
 
+    markModified(entity_file);
+
     switch(values[0].type()) {
 
         case DataType::Bool:   do_write_value<bool>(dset, values); break;
@@ -407,10 +488,15 @@ void PropertyHDF5::values(const std::vector<Value> &values)
 
 
 std::vector<Value> PropertyHDF5::values(void) const
+{
+    return readValues(dataset());
+}
+
+
+std::vector<Value> PropertyHDF5::readValues(const DataSet &dset)
 {
     std::vector<Value> values;
 
-    DataSet dset = dataset();
     DataType dtype = data_type_from_h5(dset.dataType());
     NDSize shape = dset.size();
 
@@ -439,6 +525,42 @@ std::vector<Value> PropertyHDF5::values(void) const
 }
 
 
+ValueColumn PropertyHDF5::valueColumn() const
+{
+    return readColumn(dataset());
+}
+
+
+ValueColumn PropertyHDF5::readColumn(const DataSet &dset)
+{
+    DataType dtype = data_type_from_h5(dset.dataType());
+    ValueColumn column(dtype);
+
+    NDSize shape = dset.size();
+    if (shape.size() < 1 || shape[0] < 1) {
+        return column;
+    }
+
+    assert(shape.size() == 1);
+    size_t nvalues = nix::check::fits_in_size_t(shape[0], "Can't resize: data to big for memory");
+
+    switch (dtype) {
+        case DataType::Bool:   do_read_column<bool>(dset, nvalues, column);     break;
+        case DataType::Int32:  do_read_column<int32_t>(dset, nvalues, column);  break;
+        case DataType::UInt32: do_read_column<uint32_t>(dset, nvalues, column); break;
+        case DataType::Int64:  do_read_column<int64_t>(dset, nvalues, column);  break;
+        case DataType::UInt64: do_read_column<uint64_t>(dset, nvalues, column); break;
+        case DataType::String: do_read_column<char *>(dset, nvalues, column);   break;
+        case DataType::Double: do_read_column<double>(dset, nvalues, column);   break;
+#ifndef CHECK_SUPOORTED_VALUES
+        default: assert(DATATYPE_SUPPORT_NOT_IMPLEMENTED);
+#endif
+    }
+
+    return column;
+}
+
+
 void PropertyHDF5::values(const nix::none_t t) {
     // TODO: rethink if we want two methods for same thing
     deleteValues();
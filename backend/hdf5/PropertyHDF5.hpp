@@ -114,6 +114,9 @@ public:
     std::vector<Value> values(void) const;
 
 
+    ValueColumn valueColumn() const;
+
+
     void values(const boost::none_t t);
 
 
@@ -127,6 +130,16 @@ public:
 
     static h5x::DataType fileTypeForValue(DataType dtype);
 
+    /**
+     * Read the values stored in the dataset of a property.
+     */
+    static std::vector<Value> readValues(const DataSet &dset);
+
+    /**
+     * Read the values stored in the dataset of a property into a column.
+     */
+    static ValueColumn readColumn(const DataSet &dset);
+
     virtual ~PropertyHDF5();
 
 private:
@@ -0,0 +1,101 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "QueryHDF5.hpp"
+#include "SectionHDF5.hpp"
+
+using namespace std;
+
+namespace nix {
+namespace hdf5 {
+
+
+static bool matches(const shared_ptr<base::IFile> &file, const H5Group &container, const string &link,
+                    const boost::optional<string> &type, const util::Query &query) {
+    typedef util::Query::Field Field;
+    boost::optional<H5Group> entity;
+
+    auto get = [&](Field f) -> boost::optional<string> {
+        // entities are stored under their name
+        if (f == Field::Name) {
+            return link;
+        } else if (f == Field::Type && type) {
+            return type;
+        }
+
+        if (!entity) {
+            entity = container.openGroup(link, false);
+        }
+
+        boost::optional<string> ret;
+        string value;
+        bool found = false;
+
+        switch (f) {
+            case Field::Type:       found = entity->getAttr("type", value); break;
+            case Field::Id:         found = entity->getAttr("entity_id", value); break;
+            case Field::Definition: found = entity->getAttr("definition", value); break;
+            case Field::Metadata:
+                if (entity->hasGroup("metadata")) {
+                    H5Group section = entity->openGroup("metadata", false);
+                    // like metadata(), sections deleted from the tree do not count
+                    found = section.getAttr("entity_id", value) && SectionHDF5(file, section).attached();
+                }
+                break;
+            default: break;
+        }
+
+        if (found) {
+            ret = value;
+        }
+        return ret;
+    };
+
+    return query.matches(get);
+}
+
+
+vector<string> matchingNames(const shared_ptr<base::IFile> &file, const boost::optional<H5Group> &container,
+                             const util::Query &query) {
+    vector<string> names;
+
+    if (!container) {
+        return names;
+    }
+
+    vector<string> links = container->objectNames();
+    if (query.acceptsAll()) {
+        return links;
+    }
+
+    for (const string &link : links) {
+        if (matches(file, *container, link, boost::none, query)) {
+            names.push_back(link);
+        }
+    }
+
+    return names;
+}
+
+
+vector<string> matchingNames(const shared_ptr<base::IFile> &file, const H5Group &container,
+                             const TypeIndexHDF5::entries_t &candidates, const util::Query &query) {
+    vector<string> names;
+
+    for (const auto &candidate : candidates) {
+        if (matches(file, container, candidate.first, candidate.second, query)) {
+            names.push_back(candidate.first);
+        }
+    }
+
+    return names;
+}
+
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,59 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_QUERY_HDF5_H
+#define NIX_QUERY_HDF5_H
+
+#include <nix/base/IFile.hpp>
+#include <nix/util/query.hpp>
+#include "h5x/H5Group.hpp"
+#include "TypeIndexHDF5.hpp"
+
+#include <string>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * Evaluate a query on all entities stored in a group.
+ *
+ * Names are taken from the links, other fields are read from the
+ * attributes of an entity only if the query needs them; no entity
+ * objects are constructed.
+ *
+ * @param file          The file of the entities.
+ * @param container     The group holding the entities, may be unset.
+ * @param query         The query to evaluate.
+ *
+ * @return The names of the matching entities in index order.
+ */
+std::vector<std::string> matchingNames(const std::shared_ptr<base::IFile> &file,
+                                       const boost::optional<H5Group> &container, const util::Query &query);
+
+
+/**
+ * Evaluate a query on some of the entities stored in a group, e.g.
+ * the candidates found in a {@link TypeIndexHDF5}.
+ *
+ * @param file          The file of the entities.
+ * @param container     The group holding the entities.
+ * @param candidates    Name and type of the entities to check.
+ * @param query         The query to evaluate.
+ *
+ * @return The names of the matching entities in the order of the candidates.
+ */
+std::vector<std::string> matchingNames(const std::shared_ptr<base::IFile> &file, const H5Group &container,
+                                       const TypeIndexHDF5::entries_t &candidates, const util::Query &query);
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_QUERY_HDF5_H
@@ -0,0 +1,380 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "RepackHDF5.hpp"
+
+#include "h5x/H5Exception.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+// bytes of data copied at once
+const size_t RepackHDF5::slab_size = 4 * 1024 * 1024;
+
+namespace {
+
+// compact data shares the object header (at most 64 KiB) with the
+// attributes of the data set
+const size_t compact_max = 63 * 1024;
+
+// chunks of the new data sets that are partially written by one slab
+// stay in memory until they are complete
+const size_t chunk_cache_size = 32 * 1024 * 1024;
+
+
+H5Object link_order_plist(hid_t plist_class) {
+    H5Object plist = H5Pcreate(plist_class);
+    plist.check("RepackHDF5: Could not create property list");
+    HErr res = H5Pset_link_creation_order(plist.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
+    res.check("RepackHDF5: Could not set link creation order");
+    return plist;
+}
+
+
+std::string link_name(hid_t group, H5_index_t index, hsize_t i) {
+    ssize_t len = H5Lget_name_by_idx(group, ".", index, H5_ITER_INC, i, nullptr, 0, H5P_DEFAULT);
+    if (len < 0) {
+        throw H5Exception("RepackHDF5: Could not get link name");
+    }
+    std::vector<char> name(static_cast<size_t>(len) + 1);
+    H5Lget_name_by_idx(group, ".", index, H5_ITER_INC, i, name.data(), name.size(), H5P_DEFAULT);
+    return std::string(name.data(), static_cast<size_t>(len));
+}
+
+
+std::string object_name(hid_t object) {
+    ssize_t len = H5Iget_name(object, nullptr, 0);
+    if (len < 0) {
+        throw H5Exception("RepackHDF5: Could not get object name");
+    }
+    std::vector<char> name(static_cast<size_t>(len) + 1);
+    H5Iget_name(object, name.data(), name.size());
+    return std::string(name.data(), static_cast<size_t>(len));
+}
+
+} // anonymous namespace
+
+
+RepackHDF5::RepackHDF5(const StorageOptions &options)
+    : options(options)
+{
+}
+
+
+void RepackHDF5::copy(const H5Group &root, const std::string &path) {
+    H5Object fcpl = link_order_plist(H5P_FILE_CREATE);
+    H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("RepackHDF5: Could not create file access plist");
+    if (options.latest_format) {
+        HErr res = H5Pset_libver_bounds(fapl.h5id(), H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+        res.check("RepackHDF5: Could not select the latest file format");
+    }
+
+    file = H5Fcreate(path.c_str(), H5F_ACC_TRUNC, fcpl.h5id(), fapl.h5id());
+    file.check("RepackHDF5: Could not create file " + path);
+
+    H5Group target(H5Gopen2(file.h5id(), "/", H5P_DEFAULT));
+    target.check("RepackHDF5: Could not open root group");
+
+    copied.clear();
+    references.clear();
+    copied[root.address()] = "/";
+    copyAttributes(root.h5id(), target.h5id());
+    copyGroup(root, target, "");
+    copyReferences();
+
+    HErr res = H5Fflush(file.h5id(), H5F_SCOPE_LOCAL);
+    res.check("RepackHDF5: Could not flush file");
+    file = H5Object();
+}
+
+
+void RepackHDF5::copyGroup(const H5Group &source, const H5Group &target, const std::string &path) {
+    H5G_info_t info;
+    HErr res = H5Gget_info(source.h5id(), &info);
+    res.check("RepackHDF5: Could not get group info");
+
+    // keep the order of the links, index based accessors depend on it
+    H5Object source_gcpl = H5Gget_create_plist(source.h5id());
+    source_gcpl.check("RepackHDF5: Could not get group creation plist");
+    unsigned order = 0;
+    res = H5Pget_link_creation_order(source_gcpl.h5id(), &order);
+    res.check("RepackHDF5: Could not get link creation order");
+    H5_index_t index = (order & H5P_CRT_ORDER_TRACKED) ? H5_INDEX_CRT_ORDER : H5_INDEX_NAME;
+
+    H5Object gcpl = link_order_plist(H5P_GROUP_CREATE);
+
+    for (hsize_t i = 0; i < info.nlinks; i++) {
+        std::string name = link_name(source.h5id(), index, i);
+
+        H5L_info_t link;
+        res = H5Lget_info(source.h5id(), name.c_str(), &link, H5P_DEFAULT);
+        res.check("RepackHDF5: Could not get link info");
+
+        if (link.type == H5L_TYPE_SOFT) {
+            std::vector<char> value(link.u.val_size);
+            res = H5Lget_val(source.h5id(), name.c_str(), value.data(), value.size(), H5P_DEFAULT);
+            res.check("RepackHDF5: Could not get soft link");
+            res = H5Lcreate_soft(value.data(), target.h5id(), name.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+            res.check("RepackHDF5: Could not create soft link");
+            continue;
+        } else if (link.type != H5L_TYPE_HARD) {
+            throw H5Exception("RepackHDF5: Unsupported link type of " + path + "/" + name);
+        }
+
+        LocID object(H5Oopen(source.h5id(), name.c_str(), H5P_DEFAULT));
+        object.check("RepackHDF5: Could not open object " + path + "/" + name);
+
+        haddr_t address = object.address();
+        auto done = copied.find(address);
+        if (done != copied.end()) {
+            res = H5Lcreate_hard(file.h5id(), done->second.c_str(), target.h5id(), name.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+            res.check("RepackHDF5: Could not create hard link");
+            continue;
+        }
+        std::string object_path = path + "/" + name;
+        copied[address] = object_path;
+
+        H5I_type_t type = H5Iget_type(object.h5id());
+        if (type == H5I_GROUP) {
+            H5Group group(H5Gcreate2(target.h5id(), name.c_str(), H5P_DEFAULT, gcpl.h5id(), H5P_DEFAULT));
+            group.check("RepackHDF5: Could not create group " + object_path);
+            copyAttributes(object.h5id(), group.h5id());
+            copyGroup(H5Group(object.h5id(), true), group, object_path);
+        } else if (type == H5I_DATASET) {
+            copyData(DataSet(object.h5id(), true), target, name);
+        } else {
+            res = H5Ocopy(source.h5id(), name.c_str(), target.h5id(), name.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+            res.check("RepackHDF5: Could not copy object " + object_path);
+        }
+    }
+}
+
+
+void RepackHDF5::copyAttributes(hid_t source, hid_t target) {
+    H5O_info_t info;
+#if H5_VERSION_GE(1, 10, 3)
+    HErr res = H5Oget_info2(source, &info, H5O_INFO_NUM_ATTRS);
+#else
+    HErr res = H5Oget_info(source, &info);
+#endif
+    res.check("RepackHDF5: Could not get object info");
+
+    for (hsize_t i = 0; i < info.num_attrs; i++) {
+        H5Object attr = H5Aopen_by_idx(source, ".", H5_INDEX_NAME, H5_ITER_INC, i, H5P_DEFAULT, H5P_DEFAULT);
+        attr.check("RepackHDF5: Could not open attribute");
+
+        ssize_t len = H5Aget_name(attr.h5id(), 0, nullptr);
+        std::vector<char> name(static_cast<size_t>(std::max<ssize_t>(len, 0)) + 1);
+        H5Aget_name(attr.h5id(), name.size(), name.data());
+
+        h5x::DataType file_type = H5Aget_type(attr.h5id());
+        h5x::DataType mem_type = H5Tget_native_type(file_type.h5id(), H5T_DIR_ASCEND);
+        DataSpace space = H5Aget_space(attr.h5id());
+        mem_type.check("RepackHDF5: Could not get attribute type");
+        space.check("RepackHDF5: Could not get attribute space");
+
+        hssize_t nelms = H5Sget_simple_extent_npoints(space.h5id());
+        if (file_type.class_t() == H5T_REFERENCE) {
+            if (H5Tequal(file_type.h5id(), H5T_STD_REF_OBJ) <= 0) {
+                throw H5Exception("RepackHDF5: Unsupported reference attribute " + std::string(name.data()));
+            }
+            std::vector<hobj_ref_t> refs(std::max<size_t>(1, static_cast<size_t>(nelms)));
+            res = H5Aread(attr.h5id(), H5T_STD_REF_OBJ, refs.data());
+            res.check("RepackHDF5: Could not read attribute");
+
+            Reference reference = {object_name(target), name.data(), space, {}};
+            for (hsize_t k = 0; k < static_cast<hsize_t>(nelms); k++) {
+                // references to deleted objects stay unresolved
+                hid_t object;
+                H5E_BEGIN_TRY {
+#if H5_VERSION_GE(1, 10, 0)
+                    object = H5Rdereference2(source, H5P_DEFAULT, H5R_OBJECT, &refs[k]);
+#else
+                    object = H5Rdereference(source, H5R_OBJECT, &refs[k]);
+#endif
+                } H5E_END_TRY;
+                reference.targets.push_back(object < 0 ? HADDR_UNDEF : LocID(object).address());
+            }
+            references.push_back(reference);
+            continue;
+        }
+
+        std::vector<char> buffer(std::max<size_t>(1, static_cast<size_t>(nelms) * mem_type.size()));
+        res = H5Aread(attr.h5id(), mem_type.h5id(), buffer.data());
+        res.check("RepackHDF5: Could not read attribute");
+
+        H5Object copy = H5Acreate2(target, name.data(), file_type.h5id(), space.h5id(), H5P_DEFAULT, H5P_DEFAULT);
+        copy.check("RepackHDF5: Could not create attribute");
+        res = H5Awrite(copy.h5id(), mem_type.h5id(), buffer.data());
+
+        // strings and other variable length members were allocated by the read
+        if (H5Tdetect_class(mem_type.h5id(), H5T_VLEN) > 0 || H5Tdetect_class(mem_type.h5id(), H5T_STRING) > 0) {
+            H5Dvlen_reclaim(mem_type.h5id(), space.h5id(), H5P_DEFAULT, buffer.data());
+        }
+        res.check("RepackHDF5: Could not write attribute");
+    }
+}
+
+
+void RepackHDF5::copyData(const DataSet &source, const H5Group &target, const std::string &name) {
+    h5x::DataType file_type = source.dataType();
+    DataSpace space = source.getSpace();
+    H5T_class_t tclass = file_type.class_t();
+
+    bool numeric = tclass == H5T_INTEGER || tclass == H5T_FLOAT || (tclass == H5T_BITFIELD && file_type.size() == 1);
+    if (!numeric || H5Sget_simple_extent_type(space.h5id()) != H5S_SIMPLE) {
+        HErr res = H5Ocopy(source.h5id(), ".", target.h5id(), name.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+        res.check("RepackHDF5: Could not copy data set " + name);
+        return;
+    }
+
+    NDSize extent = source.size();
+    NDSize maxsize;
+    H5Object dcpl = dataCreatePlist(source, data_type_from_h5(file_type), extent, maxsize);
+
+    H5Object dapl = H5Pcreate(H5P_DATASET_ACCESS);
+    dapl.check("RepackHDF5: Could not create data set access plist");
+    HErr res = H5Pset_chunk_cache(dapl.h5id(), 12421, chunk_cache_size, 1.0);
+    res.check("RepackHDF5: Could not set chunk cache");
+
+    DataSpace target_space = DataSpace::create(extent, maxsize);
+    DataSet copy = H5Dcreate2(target.h5id(), name.c_str(), file_type.h5id(), target_space.h5id(),
+                              H5P_DEFAULT, dcpl.h5id(), dapl.h5id());
+    copy.check("RepackHDF5: Could not create data set " + name);
+    copyAttributes(source.h5id(), copy.h5id());
+
+    size_t rank = extent.size();
+    if (extent.nelms() == 0) {
+        return;
+    }
+
+    // a slab holds all of the dimensions after d that fit into slab_size,
+    // and as many indices of dimension d as fit next to them; whole chunks
+    // of dimension d where possible
+    h5x::DataType mem_type = H5Tget_native_type(file_type.h5id(), H5T_DIR_ASCEND);
+    mem_type.check("RepackHDF5: Could not get memory type");
+    size_t esize = mem_type.size();
+    size_t d = rank - 1;
+    ndsize_t inner = 1;
+    while (d > 0 && inner * extent[d] * esize <= slab_size) {
+        inner *= extent[d];
+        d--;
+    }
+    ndsize_t rows = std::max<ndsize_t>(1, std::min<ndsize_t>(extent[d], slab_size / (inner * esize)));
+    NDSize chunks = copy.chunking();
+    if (chunks && rows > chunks[d]) {
+        rows -= rows % chunks[d];
+    }
+
+    NDSize count(extent), offset(rank, 0);
+    for (size_t i = 0; i < d; i++) {
+        count[i] = 1;
+    }
+    std::vector<char> buffer(static_cast<size_t>(rows * inner * esize));
+
+    while (offset[0] < extent[0]) {
+        count[d] = std::min(rows, extent[d] - offset[d]);
+        source.read(buffer.data(), mem_type, count, offset);
+        copy.write(buffer.data(), mem_type, count, offset);
+
+        // next slab, in row major order
+        offset[d] += count[d];
+        for (size_t i = d; i > 0 && offset[i] >= extent[i]; i--) {
+            offset[i] = 0;
+            offset[i - 1]++;
+        }
+    }
+}
+
+
+void RepackHDF5::copyReferences() {
+    for (const auto &reference : references) {
+        std::vector<hobj_ref_t> refs;
+        for (haddr_t address : reference.targets) {
+            hobj_ref_t ref = 0;
+            auto target = copied.find(address);
+            if (target != copied.end()) {
+                HErr res = H5Rcreate(&ref, file.h5id(), target->second.c_str(), H5R_OBJECT, -1);
+                res.check("RepackHDF5: Could not create reference to " + target->second);
+            }
+            refs.push_back(ref);
+        }
+        if (refs.empty()) {
+            refs.push_back(0);
+        }
+
+        LocID object(H5Oopen(file.h5id(), reference.object.c_str(), H5P_DEFAULT));
+        object.check("RepackHDF5: Could not open object " + reference.object);
+        H5Object attr = H5Acreate2(object.h5id(), reference.name.c_str(), H5T_STD_REF_OBJ,
+                                   reference.space.h5id(), H5P_DEFAULT, H5P_DEFAULT);
+        attr.check("RepackHDF5: Could not create attribute " + reference.name);
+        HErr res = H5Awrite(attr.h5id(), H5T_STD_REF_OBJ, refs.data());
+        res.check("RepackHDF5: Could not write attribute " + reference.name);
+    }
+}
+
+
+H5Object RepackHDF5::dataCreatePlist(const DataSet &source, DataType dtype, const NDSize &extent, NDSize &maxsize) const {
+    H5Object dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    dcpl.check("RepackHDF5: Could not create data set creation plist");
+
+    size_t rank = extent.size();
+    maxsize = extent;
+    DataSpace space = source.getSpace();
+    int res_rank = H5Sget_simple_extent_dims(space.h5id(), nullptr, maxsize.data());
+    if (res_rank < 0) {
+        throw H5Exception("RepackHDF5: Could not get the maximum extent");
+    }
+
+    size_t bytes = static_cast<size_t>(extent.nelms()) * data_type_to_size(dtype);
+    if (options.compact_limit > 0 && bytes > 0 && bytes <= std::min(options.compact_limit, compact_max)) {
+        HErr res = H5Pset_layout(dcpl.h5id(), H5D_COMPACT);
+        res.check("RepackHDF5: Could not set compact layout");
+        maxsize = extent;
+        return dcpl;
+    }
+
+    NDSize chunks;
+    if (options.chunking) {
+        chunks = options.chunking(dtype, extent);
+    }
+    if (chunks.size() != rank) {
+        chunks = source.chunking();
+    }
+    if (!chunks && options.compression > 0) {
+        chunks = DataSet::guessChunking(extent, data_type_to_size(dtype));
+    }
+
+    if (chunks) {
+        for (size_t i = 0; i < rank; i++) {
+            if (maxsize[i] == 0) {
+                // data of fixed empty extent can not be chunked
+                return dcpl;
+            }
+            if (maxsize[i] != H5S_UNLIMITED) {
+                chunks[i] = std::min(chunks[i], maxsize[i]);
+            }
+            chunks[i] = std::max<ndsize_t>(chunks[i], 1);
+        }
+        HErr res = H5Pset_chunk(dcpl.h5id(), static_cast<int>(rank), chunks.data());
+        res.check("RepackHDF5: Could not set chunk size");
+        if (options.compression > 0) {
+            res = H5Pset_deflate(dcpl.h5id(), static_cast<unsigned>(std::min(options.compression, 9)));
+            res.check("RepackHDF5: Could not set compression");
+        }
+    }
+    return dcpl;
+}
+
+
+} // namespace hdf5
+} // namespace nix
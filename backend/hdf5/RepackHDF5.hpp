@@ -0,0 +1,88 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_REPACK_HDF5_H
+#define NIX_REPACK_HDF5_H
+
+#include <nix/StorageOptions.hpp>
+#include "h5x/H5Group.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * Copies the objects of a file into a new file, see {@link nix::File::repack}.
+ *
+ * Groups are walked in creation order and re-created with their attributes.
+ * Objects that are linked more than once, e.g. data arrays referenced by
+ * tags, are copied once; further links to them become hard links to the
+ * copy. Numeric data sets are created with the layout given by the
+ * options and copied in slabs of bounded size, all other data sets (e.g.
+ * the values of properties) are copied as they are. Object references
+ * stored in attributes, e.g. the parent of a section, are re-created
+ * once all objects exist in the new file.
+ */
+class RepackHDF5 {
+
+public:
+
+    RepackHDF5(const StorageOptions &options);
+
+    /**
+     * Copy everything below the root group into a new file.
+     *
+     * @param root      The root group of the source file.
+     * @param path      The path of the new file.
+     */
+    void copy(const H5Group &root, const std::string &path);
+
+private:
+
+    void copyGroup(const H5Group &source, const H5Group &target, const std::string &path);
+
+    void copyAttributes(hid_t source, hid_t target);
+
+    void copyData(const DataSet &source, const H5Group &target, const std::string &name);
+
+    H5Object dataCreatePlist(const DataSet &source, DataType dtype, const NDSize &extent, NDSize &maxsize) const;
+
+    void copyReferences();
+
+    static const size_t slab_size;
+
+    const StorageOptions &options;
+
+    H5Object file;
+
+    // path in the new file of every object copied, keyed by the address
+    // of the object in the source file
+    std::map<haddr_t, std::string> copied;
+
+    // attributes holding object references, by the path of their object
+    // in the new file and the addresses of the referenced objects in the
+    // source file
+    struct Reference {
+        std::string object;
+        std::string name;
+        DataSpace space;
+        std::vector<haddr_t> targets;
+    };
+
+    std::vector<Reference> references;
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_REPACK_HDF5_H
@@ -14,6 +14,7 @@
 #include <nix/Section.hpp>
 
 #include "PropertyHDF5.hpp"
+#include "FileHDF5.hpp"
 
 using namespace std;
 using namespace nix::base;
@@ -25,11 +26,12 @@ namespace hdf5 {
 SectionHDF5::SectionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group)
     : SectionHDF5(file, nullptr, group)
 {
+    parent_resolved = false;
 }
     
 
 SectionHDF5::SectionHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::ISection> &parent, const H5Group &group)
-    : NamedEntityHDF5(file, group), parent_section(parent)
+    : NamedEntityHDF5(file, group), parent_section(parent), parent_resolved(true), is_attached(true)
 {
     property_group = this->group().openOptGroup("properties");
     section_group = this->group().openOptGroup("sections");
@@ -59,7 +61,7 @@ SectionHDF5::SectionHDF5(const shared_ptr<IFile> &file, const H5Group &group, co
 
 SectionHDF5::SectionHDF5(const shared_ptr<IFile> &file, const shared_ptr<ISection> &parent, const H5Group &group,
                          const string &id, const string &type, const string &name, time_t time)
-    : NamedEntityHDF5(file, group, id, type, name, time), parent_section(parent)
+    : NamedEntityHDF5(file, group, id, type, name, time), parent_section(parent), parent_resolved(true), is_attached(true)
 {
     property_group = this->group().openOptGroup("properties");
     section_group = this->group().openOptGroup("sections");
@@ -105,6 +107,7 @@ void SectionHDF5::link(const std::string &id) {
     auto target = dynamic_pointer_cast<SectionHDF5>(found.front().impl());
 
     group().createLink(target->group(), "link");
+    markModified(file());
 }
 
 
@@ -113,11 +116,9 @@ shared_ptr<ISection> SectionHDF5::link() const {
 
     if (group().hasGroup("link")) {
         H5Group other_group = group().openGroup("link", false);
-        auto sec_tmp = make_shared<SectionHDF5>(file(), other_group);
-        // re-get above section "sec_tmp": parent missing, findSections will set it!
-        auto found = File(file()).findSections(util::IdFilter<Section>(sec_tmp->id()));
-        if (found.size() > 0) {
-            sec = found.front().impl();
+        auto target = make_shared<SectionHDF5>(file(), other_group);
+        if (target->attached()) {
+            sec = target;
         }
     }
 
@@ -162,10 +163,54 @@ void SectionHDF5::mapping(const none_t t) {
 
 
 shared_ptr<ISection> SectionHDF5::parent() const {
+    attached();
     return parent_section;
 }
 
 
+bool SectionHDF5::attached() const {
+    if (!parent_resolved) {
+        is_attached = resolveParent(parent_section);
+        parent_resolved = true;
+    }
+    return is_attached;
+}
+
+
+bool SectionHDF5::resolveParent(shared_ptr<ISection> &parent) const {
+    // sections store a reference to the group of their parent section, or to
+    // the metadata group for root sections; it is only trusted if that group
+    // still links to this section
+    boost::optional<H5Group> g = group().getRefAttr("parent");
+
+    if (g) {
+        boost::optional<H5Group> container;
+        bool is_root = !g->hasAttr("entity_id");
+
+        if (is_root) {
+            container = g;
+        } else if (g->hasGroup("sections")) {
+            container = g->openGroup("sections", false);
+        }
+
+        string link = name();
+        if (container && container->hasGroup(link) &&
+            container->openGroup(link, false).address() == group().address()) {
+            parent = is_root ? nullptr : make_shared<SectionHDF5>(file(), *g);
+            return true;
+        }
+    }
+
+    // files written without the parent reference: search the metadata tree
+    auto found = File(file()).findSections(util::IdFilter<Section>(id()));
+    if (found.empty()) {
+        return false;
+    }
+    parent = found.front().impl()->parent();
+    return true;
+}
+
+
 //--------------------------------------------------
 // Methods for child section access
 //--------------------------------------------------
@@ -178,6 +223,11 @@ ndsize_t SectionHDF5::sectionCount() const {
 
 
 bool SectionHDF5::hasSection(const string &name_or_id) const {
+    BatchHDF5 *batch = activeBatch(file());
+    if (batch && !util::looksLikeUUID(name_or_id)) {
+        boost::optional<H5Group> g = section_group();
+        return g && batch->hasName(*g, name_or_id);
+    }
     return getSection(name_or_id) != nullptr;
 }
 
@@ -211,6 +261,13 @@ shared_ptr<ISection> SectionHDF5::createSection(const string &name, const string
 
     auto p = const_pointer_cast<SectionHDF5>(shared_from_this());
     H5Group grp = g->openGroup(name, true);
+    grp.setRefAttr("parent", group());
+
+    BatchHDF5 *batch = activeBatch(file());
+    if (batch) {
+        batch->addName(*g, name);
+    }
+
     return make_shared<SectionHDF5>(file(), p, grp, new_id, type, name);
 }
 
@@ -230,6 +287,12 @@ bool SectionHDF5::deleteSection(const string &name_or_id) {
             }
             // if hasSection is true then section_group always exists
             deleted = g->removeAllLinks(section.name());
+
+            BatchHDF5 *batch = activeBatch(file());
+            if (batch) {
+                batch->removeName(*g, section.name());
+            }
+            markModified(file());
         }
     }
 
@@ -249,6 +312,11 @@ ndsize_t SectionHDF5::propertyCount() const {
 
 
 bool SectionHDF5::hasProperty(const string &name_or_id) const {
+    BatchHDF5 *batch = activeBatch(file());
+    if (batch && !util::looksLikeUUID(name_or_id)) {
+        boost::optional<H5Group> g = property_group();
+        return g && batch->hasName(*g, name_or_id);
+    }
     return getProperty(name_or_id) != nullptr;
 }
 
@@ -281,6 +349,11 @@ shared_ptr<IProperty> SectionHDF5::createProperty(const string &name, const Data
     h5x::DataType fileType = PropertyHDF5::fileTypeForValue(dtype);
     DataSet dataset = g->createData(name, fileType, {0});
 
+    BatchHDF5 *batch = activeBatch(file());
+    if (batch) {
+        batch->addName(*g, name);
+    }
+
     return make_shared<PropertyHDF5>(file(), dataset, new_id, name);
 }
 
@@ -304,14 +377,50 @@ bool SectionHDF5::deleteProperty(const string &name_or_id) {
     boost::optional<H5Group> g = property_group();
     bool deleted = false;
     if (g && hasProperty(name_or_id)) {
-        g->removeData(getProperty(name_or_id)->name());
+        string name = getProperty(name_or_id)->name();
+        g->removeData(name);
         deleted = true;
+
+        BatchHDF5 *batch = activeBatch(file());
+        if (batch) {
+            batch->removeName(*g, name);
+        }
+        markModified(file());
     }
 
     return deleted;
 }
 
 
+/*
+ * Read the values of all properties below a section group, working on the
+ * groups and datasets directly to avoid the construction of entities.
+ */
+static void collect_property_values(const H5Group &section, const string &prefix, size_t depth,
+                                    map<string, vector<Value>> &values) {
+    if (section.hasGroup("properties")) {
+        H5Group props = section.openGroup("properties", false);
+        for (const string &name : props.objectNames()) {
+            values[prefix + name] = PropertyHDF5::readValues(props.openData(name));
+        }
+    }
+
+    if (depth > 0 && section.hasGroup("sections")) {
+        H5Group sections = section.openGroup("sections", false);
+        for (const string &name : sections.objectNames()) {
+            collect_property_values(sections.openGroup(name, false), prefix + name + "/", depth - 1, values);
+        }
+    }
+}
+
+
+map<string, vector<Value>> SectionHDF5::propertyValues(size_t max_depth) const {
+    map<string, vector<Value>> values;
+    collect_property_values(group(), "", max_depth, values);
+    return values;
+}
+
+
 SectionHDF5::~SectionHDF5() {}
 
 } // ns nix::hdf5
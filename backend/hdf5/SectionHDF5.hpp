@@ -24,19 +24,23 @@ class SectionHDF5 : public NamedEntityHDF5, virtual public base::ISection,
 
 private:
 
-    // TODO: consider writing parent_section as soft link into file
-    std::shared_ptr<base::ISection> parent_section;
+    // sections opened without their parent resolve it on first access,
+    // see resolveParent()
+    mutable std::shared_ptr<base::ISection> parent_section;
+    mutable bool parent_resolved, is_attached;
     optGroup property_group, section_group;
 
 public:
 
     /**
-     * Standard constructor for existing entity
+     * Standard constructor for existing entity, the parent
+     * is determined when it is first accessed.
      */
     SectionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group);
     
     /**
-     * Standard constructor for existing entity
+     * Standard constructor for existing entity with known
+     * parent (nullptr for root sections).
      */
     SectionHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::ISection> &parent, const H5Group &group);
 
@@ -103,6 +107,12 @@ public:
 
     std::shared_ptr<base::ISection> parent() const;
 
+    /**
+     * Check if the section is still part of the metadata tree of the
+     * file, i.e. it was not deleted while being linked elsewhere.
+     */
+    bool attached() const;
+
 
     //--------------------------------------------------
     // Methods for child section access
@@ -154,12 +164,19 @@ public:
 
     bool deleteProperty(const std::string &name_or_id);
 
+
+    std::map<std::string, std::vector<Value>> propertyValues(size_t max_depth) const;
+
     //--------------------------------------------------
     // Ohter methods and operators
     //--------------------------------------------------
 
     virtual ~SectionHDF5();
 
+private:
+
+    bool resolveParent(std::shared_ptr<base::ISection> &parent) const;
+
 };
 
 
@@ -0,0 +1,126 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TypeIndexHDF5.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace nix {
+namespace hdf5 {
+
+
+TypeIndexHDF5::entries_t TypeIndexHDF5::find(const H5Group &container, const vector<string> &types) {
+    haddr_t address = container.address();
+    auto it = groups.find(address);
+    Index &index = it != groups.end() ? it->second : build(container, address);
+
+    entries_t result;
+    for (const string &type : types) {
+        auto names = index.names.find(type);
+        if (names == index.names.end()) {
+            continue;
+        }
+        for (const string &name : names->second) {
+            result.emplace_back(name, type);
+        }
+    }
+
+    if (types.size() > 1) {
+        sort(result.begin(), result.end());
+        result.erase(unique(result.begin(), result.end()), result.end());
+    }
+
+    return result;
+}
+
+
+void TypeIndexHDF5::added(const H5Group &container, const H5Group &entity, const string &name, const string &type) {
+    if (groups.empty()) {
+        return;
+    }
+
+    haddr_t address = container.address();
+    auto it = groups.find(address);
+    if (it != groups.end()) {
+        insert(it->second, address, entity.address(), name, type);
+    }
+}
+
+
+void TypeIndexHDF5::removed(const H5Group &container, const string &name) {
+    if (groups.empty()) {
+        return;
+    }
+
+    auto it = groups.find(container.address());
+    if (it == groups.end()) {
+        return;
+    }
+
+    Index &index = it->second;
+    auto entry = index.entries.find(name);
+    if (entry != index.entries.end()) {
+        index.names[entry->second.type].erase(name);
+        entities.erase(entry->second.address);
+        index.entries.erase(entry);
+    }
+}
+
+
+void TypeIndexHDF5::retyped(const H5Group &entity, const string &type) {
+    if (entities.empty()) {
+        return;
+    }
+
+    auto it = entities.find(entity.address());
+    if (it == entities.end()) {
+        return;
+    }
+
+    Index &index = groups[it->second.first];
+    const string &name = it->second.second;
+    Entry &entry = index.entries[name];
+    if (entry.type != type) {
+        index.names[entry.type].erase(name);
+        index.names[type].insert(name);
+        entry.type = type;
+    }
+}
+
+
+void TypeIndexHDF5::clear() {
+    groups.clear();
+    entities.clear();
+}
+
+
+TypeIndexHDF5::Index &TypeIndexHDF5::build(const H5Group &container, haddr_t address) {
+    Index &index = groups[address];
+
+    for (const string &name : container.objectNames()) {
+        H5Group entity = container.openGroup(name, false);
+        string type;
+        entity.getAttr("type", type);
+        insert(index, address, entity.address(), name, type);
+    }
+
+    return index;
+}
+
+
+void TypeIndexHDF5::insert(Index &index, haddr_t container, haddr_t entity, const string &name, const string &type) {
+    index.names[type].insert(name);
+    index.entries[name] = Entry{type, entity};
+    entities[entity] = make_pair(container, name);
+}
+
+
+} // namespace hdf5
+} // namespace nix
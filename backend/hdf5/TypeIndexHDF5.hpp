@@ -0,0 +1,103 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TYPE_INDEX_HDF5_H
+#define NIX_TYPE_INDEX_HDF5_H
+
+#include "h5x/H5Group.hpp"
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+
+/**
+ * In-memory index from entity type to the names of the entities in
+ * a group, e.g. the data arrays of a block.
+ *
+ * The index of a group is built on the first lookup, which reads the type
+ * of every entity once. It is kept up to date by {@link added},
+ * {@link removed} and {@link retyped}, so that later lookups only touch
+ * the matching entities. Groups are identified by their address in the
+ * file; since addresses of deleted objects may be reused, the index
+ * has to be cleared when a group that holds indexed groups is removed.
+ */
+class TypeIndexHDF5 {
+
+public:
+
+    /**
+     * Pairs of name and type of entities.
+     */
+    typedef std::vector<std::pair<std::string, std::string>> entries_t;
+
+    /**
+     * Get the entities in a group that have one of the types.
+     *
+     * @param container     The group holding the entities.
+     * @param types         The types to look for.
+     *
+     * @return Name and type of the matching entities, sorted by name.
+     */
+    entries_t find(const H5Group &container, const std::vector<std::string> &types);
+
+    /**
+     * Record a new entity in a group.
+     */
+    void added(const H5Group &container, const H5Group &entity, const std::string &name, const std::string &type);
+
+    /**
+     * Record the removal of an entity from a group.
+     */
+    void removed(const H5Group &container, const std::string &name);
+
+    /**
+     * Record the type change of an entity.
+     */
+    void retyped(const H5Group &entity, const std::string &type);
+
+    /**
+     * Drop the index of all groups.
+     */
+    void clear();
+
+private:
+
+    struct Entry {
+        std::string type;
+        haddr_t address;
+    };
+
+    struct Index {
+        std::unordered_map<std::string, std::set<std::string>> names;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    // indexed groups by address
+    std::map<haddr_t, Index> groups;
+
+    // group address and name of indexed entities by address
+    std::map<haddr_t, std::pair<haddr_t, std::string>> entities;
+
+    Index &build(const H5Group &container, haddr_t address);
+
+    void insert(Index &index, haddr_t container, haddr_t entity, const std::string &name, const std::string &type);
+
+};
+
+
+} // namespace hdf5
+} // namespace nix
+
+#endif // NIX_TYPE_INDEX_HDF5_H
@@ -170,6 +170,24 @@ NDSize DataSet::size() const
     return getSpace().extent();
 }
 
+
+NDSize DataSet::chunking() const
+{
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::chunking(): Could not obtain the creation property list");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return NDSize{};
+    }
+
+    NDSize dims = size();
+    int rank = H5Pget_chunk(dcpl.h5id(), static_cast<int>(dims.size()), dims.data());
+    if (rank < 0) {
+        throw H5Exception("DataSet::chunking(): Could not obtain the chunk dimensions");
+    }
+    return dims;
+}
+
 void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace) const
 {
     HErr res;
@@ -184,6 +202,23 @@ void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace)
 }
 
 
+static void vlen_keep(void *mem, void *info) {
+    // memory is released by the owner of the allocator
+}
+
+void DataSet::readVlen(void *data, const h5x::DataType &memType, vlen_alloc_t alloc, void *info) const
+{
+    H5Object plist = H5Pcreate(H5P_DATASET_XFER);
+    plist.check("DataSet::readVlen(): Could not create transfer plist");
+
+    HErr res = H5Pset_vlen_mem_manager(plist.h5id(), alloc, info, vlen_keep, nullptr);
+    res.check("DataSet::readVlen(): Could not set vlen allocator");
+
+    res = H5Dread(hid, memType.h5id(), H5S_ALL, H5S_ALL, plist.h5id(), data);
+    res.check("DataSet::readVlen() IO error");
+}
+
+
 h5x::DataType DataSet::dataType(void) const
 {
     h5x::DataType ftype = H5Dget_type(hid);
@@ -50,8 +50,25 @@ public:
     void setExtent(const NDSize &dims);
     NDSize size() const;
 
+    /**
+     * The chunk dimensions of the data set, an empty NDSize if the
+     * data set is not chunked.
+     */
+    NDSize chunking() const;
+
     void vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace = nullptr) const;
 
+    typedef void *(*vlen_alloc_t)(size_t size, void *info);
+
+    /**
+     * Read the whole data set and allocate the memory of variable length
+     * members, e.g. strings, with alloc instead of malloc. The memory
+     * belongs to the allocator, vlenReclaim must not be called for it.
+     * alloc is called from within HDF5 and must not throw; it returns
+     * nullptr if it cannot allocate, which makes the read fail.
+     */
+    void readVlen(void *data, const h5x::DataType &memType, vlen_alloc_t alloc, void *info) const;
+
     h5x::DataType dataType(void) const;
 
     DataSpace getSpace() const;
@@ -59,6 +59,13 @@ public:
         }
     }
 
+    // only builds the message string on failure
+    static void check(herr_t result, const char *msg_if_fail) {
+        if (result < 0) {
+            throw H5Error(result, msg_if_fail);
+        }
+    }
+
 private:
     herr_t      error;
 };
@@ -19,6 +19,12 @@ optGroup::optGroup(const H5Group &parent, const std::string &g_name)
 {}
 
 boost::optional<H5Group> optGroup::operator() (bool create) const {
+    // the optional groups are never removed on their own, once
+    // opened the group can be reused for the lifetime of the functor
+    if (g) {
+        return g;
+    }
+
     if (parent.hasGroup(g_name)) {
         g = boost::optional<H5Group>(parent.openGroup(g_name));
     } else if (create) {
@@ -28,6 +34,26 @@ boost::optional<H5Group> optGroup::operator() (bool create) const {
 }
 
 
+/*
+ * The group creation property list is the same for all groups,
+ * so it is created once and shared.
+ */
+static hid_t group_create_plist() {
+    static H5Object gcpl = [] {
+        H5Object plist = H5Pcreate(H5P_GROUP_CREATE);
+        plist.check("Unable to create group creation plist! (H5Pcreate)");
+
+        //we want hdf5 to keep track of the order in which links were created so that
+        //the order for indexed based accessors is stable cf. issue #387
+        HErr res = H5Pset_link_creation_order(plist.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
+        res.check("Unable to create group creation plist! (H5Pset_link_cr...)");
+        return plist;
+    }();
+
+    return gcpl.h5id();
+}
+
+
 H5Group::H5Group() : LocID() {}
 
 
@@ -50,19 +76,19 @@ bool H5Group::hasObject(const std::string &name) const {
 bool H5Group::objectOfType(const std::string &name, H5O_type_t type) const {
     H5O_info_t info;
 
-    hid_t obj = H5Oopen(hid, name.c_str(), H5P_DEFAULT);
+    // only the basic info (incl. the type) is needed, which spares
+    // opening the object and counting its attributes
+#if H5_VERSION_GE(1, 10, 3)
+    HErr err = H5Oget_info_by_name2(hid, name.c_str(), &info, H5O_INFO_BASIC, H5P_DEFAULT);
+#else
+    HErr err = H5Oget_info_by_name(hid, name.c_str(), &info, H5P_DEFAULT);
+#endif
 
-    if (!H5Iis_valid(obj)) {
+    if (err.isError()) {
         return false;
     }
 
-    HErr err = H5Oget_info(obj, &info);
-    err.check("Could not obtain object info");
-
-    bool res = info.type == type;
-
-    H5Oclose(obj);
-    return res;
+    return info.type == type;
 }
 
 ndsize_t H5Group::objectCount() const {
@@ -160,6 +186,24 @@ std::string H5Group::objectName(ndsize_t index) const {
 }
 
 
+static herr_t collect_link_name(hid_t group, const char *name, const H5L_info_t *info, void *op_data) {
+    std::vector<std::string> *names = static_cast<std::vector<std::string> *>(op_data);
+    names->emplace_back(name);
+    return 0;
+}
+
+
+std::vector<std::string> H5Group::objectNames() const {
+    std::vector<std::string> names;
+    hsize_t idx = 0;
+
+    HErr res = H5Literate(hid, H5_INDEX_NAME, H5_ITER_NATIVE, &idx, collect_link_name, &names);
+    res.check("H5Group::objectNames(): H5Literate failed");
+
+    return names;
+}
+
+
 bool H5Group::hasData(const std::string &name) const {
     return hasObject(name) && objectOfType(name, H5O_TYPE_DATASET);
 }
@@ -232,15 +276,7 @@ H5Group H5Group::openGroup(const std::string &name, bool create) const {
         g = H5Group(H5Gopen(hid, name.c_str(), H5P_DEFAULT));
         g.check("H5Group::openGroup(): Could not open group: " + name);
     } else if (create) {
-        H5Object gcpl = H5Pcreate(H5P_GROUP_CREATE);
-        gcpl.check("Unable to create group with name '" + name + "'! (H5Pcreate)");
-
-        //we want hdf5 to keep track of the order in which links were created so that
-        //the order for indexed based accessors is stable cf. issue #387
-        HErr res = H5Pset_link_creation_order(gcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
-        res.check("Unable to create group with name '" + name + "'! (H5Pset_link_cr...)");
-
-        g = H5Group(H5Gcreate2(hid, name.c_str(), H5P_DEFAULT, gcpl.h5id(), H5P_DEFAULT));
+        g = H5Group(H5Gcreate2(hid, name.c_str(), H5P_DEFAULT, group_create_plist(), H5P_DEFAULT));
         g.check("Unable to create group with name '" + name + "'! (H5Gcreate2)");
 
     } else {
@@ -273,14 +309,65 @@ void H5Group::renameGroup(const std::string &old_name, const std::string &new_na
 
 
 H5Group H5Group::createLink(const H5Group &target, const std::string &link_name) {
+    addLink(target, link_name);
+    return openGroup(link_name, false);
+}
+
+
+void H5Group::addLink(const H5Group &target, const std::string &link_name) const {
     check_h5_arg_name(link_name);
 
     HErr res = H5Lcreate_hard(target.hid, ".", hid, link_name.c_str(),
                               H5L_SAME_LOC, H5L_SAME_LOC);
     res.check("Unable to create link " + link_name);
-    return openGroup(link_name, false);
 }
 
+
+void H5Group::setRefAttr(const std::string &name, const H5Group &target) const {
+    hobj_ref_t ref;
+    HErr res = H5Rcreate(&ref, target.hid, ".", H5R_OBJECT, -1);
+    res.check("H5Group::setRefAttr: Could not create reference");
+
+    Attribute attr;
+    if (hasAttr(name)) {
+        attr = openAttr(name);
+    } else {
+        h5x::DataType fileType = h5x::DataType::copy(H5T_STD_REF_OBJ);
+        attr = createAttr(name, fileType, DataSpace::create({}));
+    }
+
+    attr.write(h5x::DataType::copy(H5T_STD_REF_OBJ), {}, &ref);
+}
+
+
+boost::optional<H5Group> H5Group::getRefAttr(const std::string &name) const {
+    boost::optional<H5Group> ret;
+    if (!hasAttr(name)) {
+        return ret;
+    }
+
+    hobj_ref_t ref;
+    Attribute attr = openAttr(name);
+    attr.read(h5x::DataType::copy(H5T_STD_REF_OBJ), {}, &ref);
+
+    H5O_type_t obj_type;
+    herr_t res = H5Rget_obj_type2(hid, H5R_OBJECT, &ref, &obj_type);
+    if (res < 0 || obj_type != H5O_TYPE_GROUP) {
+        return ret;
+    }
+
+#if H5_VERSION_GE(1, 10, 0)
+    H5Group g = H5Group(H5Rdereference2(hid, H5P_DEFAULT, H5R_OBJECT, &ref));
+#else
+    H5Group g = H5Group(H5Rdereference(hid, H5R_OBJECT, &ref));
+#endif
+    if (g.isValid()) {
+        ret = g;
+    }
+    return ret;
+}
+
+
 // TODO implement some kind of roll-back in order to avoid half renamed links.
 bool H5Group::renameAllLinks(const std::string &old_name, const std::string &new_name) {
     check_h5_arg_name(new_name);
@@ -44,6 +44,16 @@ public:
     ndsize_t objectCount() const;
     std::string objectName(ndsize_t index) const;
 
+    /**
+     * @brief Get the names of all links inside this group.
+     *
+     * The names are read in one iteration and are ordered like the
+     * indices accepted by {@link objectName}.
+     *
+     * @return A vector with the link names.
+     */
+    std::vector<std::string> objectNames() const;
+
     bool hasData(const std::string &name) const;
 
     DataSet createData(const std::string &name, const h5x::DataType &fileType,
@@ -148,6 +158,14 @@ public:
      */
     H5Group createLink(const H5Group &target, const std::string &link_name);
 
+    /**
+     * @brief Like {@link createLink} but without opening the linked group.
+     *
+     * @param target    The target of the link to create.
+     * @param linkname  The name of the link to create.
+     */
+    void addLink(const H5Group &target, const std::string &link_name) const;
+
     /**
      * @brief Renames all links of the object defined by the old name.
      *
@@ -170,6 +188,29 @@ public:
      */
     bool removeAllLinks(const std::string &name);
 
+    /**
+     * @brief Store an object reference to the target group in an
+     *        attribute of this group.
+     *
+     * Other than the path of a group the reference stays valid
+     * regardless of the link that was used to open the target.
+     *
+     * @param name      The name of the attribute.
+     * @param target    The group to reference.
+     */
+    void setRefAttr(const std::string &name, const H5Group &target) const;
+
+    /**
+     * @brief Open the group that is referenced by an attribute written
+     *        with {@link setRefAttr}.
+     *
+     * @param name      The name of the attribute.
+     *
+     * @return The referenced group or an unset optional if the attribute
+     *         does not exist or the reference can not be resolved.
+     */
+    boost::optional<H5Group> getRefAttr(const std::string &name) const;
+
 
     virtual ~H5Group();
 
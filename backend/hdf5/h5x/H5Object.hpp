@@ -134,6 +134,13 @@ public:
         }
     }
 
+    // only builds the message string on failure
+    void check(const char *msg_if_fail) {
+        if (type() == H5I_BADID) {
+            throw H5Exception(msg_if_fail);
+        }
+    }
+
     std::string name() const;
 
     H5I_type_t type() const;
@@ -177,6 +184,14 @@ struct NIXAPI HTri {
         return result();
     }
 
+    inline bool check(const char *msg) {
+        if (value < 0) {
+            throw H5Exception(msg);
+        }
+
+        return result();
+    }
+
     value_type value;
 };
 
@@ -202,6 +217,14 @@ struct NIXAPI HErr {
         return true;
     }
 
+    inline bool check(const char *msg) {
+        if (isError()) {
+            throw H5Error(value, msg);
+        }
+
+        return true;
+    }
+
     value_type value;
 };
 
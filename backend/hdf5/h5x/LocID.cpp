@@ -61,6 +61,18 @@ unsigned int LocID::referenceCount() const {
     res.check("LocID:referenceCount: Coud not get object info");
     return oInfo.rc;
 }
+
+
+haddr_t LocID::address() const {
+    H5O_info_t oInfo;
+#if H5_VERSION_GE(1, 10, 3)
+    HErr res = H5Oget_info2(hid, &oInfo, H5O_INFO_BASIC);
+#else
+    HErr res = H5Oget_info(hid, &oInfo);
+#endif
+    res.check("LocID::address: Could not get object info");
+    return oInfo.addr;
+}
 } // nix::hdf5
 
 } // nix::
\ No newline at end of file
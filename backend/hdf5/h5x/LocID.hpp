@@ -41,7 +41,14 @@ public:
     void deleteLink(std::string name, hid_t plist = H5L_SAME_LOC);
 
     unsigned int referenceCount() const;
-private:
+
+    /**
+     * @brief The address of the object in the file; links to the
+     *        same object share the same address.
+     */
+    haddr_t address() const;
+
+protected:
 
     Attribute openAttr(const std::string &name) const;
     Attribute createAttr(const std::string &name, h5x::DataType fileType, const DataSpace &fileSpace) const;
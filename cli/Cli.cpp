@@ -27,6 +27,7 @@ namespace po = boost::program_options;
 #include <modules/IModule.hpp>
 #include <modules/Validate.hpp>
 #include <modules/Dump.hpp>
+#include <modules/Repack.hpp>
 
 namespace cli {
 
@@ -41,13 +42,14 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& v)
 // define all module types
 std::unordered_map<std::string, std::shared_ptr<cli::module::IModule>> modules = {
     {std::string(cli::module::Validate::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Validate())},
-    {std::string(cli::module::Dump::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Dump())}
+    {std::string(cli::module::Dump::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Dump())},
+    {std::string(cli::module::Repack::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Repack())}
 };
 
 } // namespace cli
 
 int main(int argc, char* argv[]) {
-    std::stringstream out;
+    std::ostream &out = std::cout;
     po::variables_map vm; // will contain the parsed options
     po::command_line_parser parser1(argc, argv);
     po::command_line_parser parser2(argc, argv);
@@ -102,10 +104,12 @@ int main(int argc, char* argv[]) {
         auto it = cli::modules.find(name);
         if (it != cli::modules.end()) {
             (*it).second->load(desc);    
-            // process the cmd line input
-            po::store(parser3.options(desc).positional(pdesc).run(), vm);
-            po::notify(vm);
-            out << (*it).second->call(vm, desc);
+            // process the cmd line input again, now that the module options
+            // are known their values are no longer taken as input files
+            po::variables_map module_vm;
+            po::store(parser3.options(desc).positional(pdesc).run(), module_vm);
+            po::notify(module_vm);
+            (*it).second->call(module_vm, desc, out);
         }
         else {
             out << std::endl << "Nix command line tool " <<  "\n\n";
@@ -114,9 +118,6 @@ int main(int argc, char* argv[]) {
             out << "\tUsage: ./nix-tool module [--help] [[module args] input-file] \n\n";
             out << desc << std::endl;
         }
-        
-        // show output
-        std::cout << out.str();
     }
     catch(std::exception& e) {
         std::cerr << "error: " << e.what() << std::endl;
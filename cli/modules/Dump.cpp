@@ -21,8 +21,13 @@
 #include <modules/Dump.hpp>
 #include <limits>
 #include <cstddef>
+#include <cstdio>
+#include <clocale>
+#include <cstring>
+#include <utility>
 
 #include <boost/filesystem.hpp>
+#include <boost/algorithm/string/join.hpp>
 #include <boost/program_options.hpp>
 namespace po = boost::program_options;
 
@@ -37,21 +42,118 @@ const char* yamlstream::scalar_start = ": ";
 const char* yamlstream::scalar_end = "\n";
 const char* yamlstream::item_str = "- ";
 const char* plot_script::plot_file = "dump_plot.gnu";
+const size_t data_export::slab_size = 4 * 1024 * 1024;
+
+namespace {
+
+// decimal digits of integers, independent of the locale
+template<typename T>
+void append_int(T value, std::string &text) {
+    char digits[24];
+    char *end = digits + sizeof(digits), *p = end;
+    bool negative = value < 0;
+    do {
+        int digit = static_cast<int>(value % 10);
+        *--p = static_cast<char>('0' + (negative ? -digit : digit));
+        value /= 10;
+    } while (value != 0);
+    if (negative) {
+        *--p = '-';
+    }
+    text.append(p, end);
+}
+
+// shortest representation that reads back to the same value, always
+// with "." as decimal point
+template<typename T>
+void append_float(T value, int precision, std::string &text) {
+    char digits[32];
+    int n;
+    do {
+        n = std::snprintf(digits, sizeof(digits), "%.*g", precision, static_cast<double>(value));
+    } while (static_cast<T>(std::strtod(digits, nullptr)) != value && value == value &&
+             ++precision <= std::numeric_limits<T>::max_digits10);
+    const char *point = std::localeconv()->decimal_point;
+    if (point[0] != '.' && point[0] != '\0') {
+        std::replace(digits, digits + n, point[0], '.');
+    }
+    text.append(digits, n);
+}
+
+void append_value(bool value, std::string &text)     { text += value ? '1' : '0'; }
+void append_value(char value, std::string &text)     { append_int(static_cast<int>(value), text); }
+void append_value(float value, std::string &text)    { append_float(value, std::numeric_limits<float>::digits10, text); }
+void append_value(double value, std::string &text)   { append_float(value, std::numeric_limits<double>::digits10, text); }
+template<typename T>
+void append_value(T value, std::string &text)        { append_int(value, text); }
+
+std::string shape(const nix::NDSize &extent) {
+    std::string str = "[";
+    for (size_t i = 0; i < extent.size(); i++) {
+        str += (i ? ", " : "") + std::to_string(extent[i]);
+    }
+    return str + "]";
+}
+
+bool little_endian() {
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const char *>(&probe) == 1;
+}
+
+} // anonymous namespace
+
+
+yamlstream::yamlstream(std::ostream &out, size_t max_depth, const std::set<std::string> &only)
+    : level(0), buf(out.rdbuf()), sstream(&buf), depth(0), max_depth(max_depth)
+{
+    // collections that have to be output to reach others
+    static const std::pair<const char*, const char*> containers[] = {
+        {"data_arrays", "blocks"}, {"tags", "blocks"}, {"multi_tags", "blocks"}, {"sources", "blocks"},
+        {"references", "tags"}, {"references", "multi_tags"},
+        {"features", "tags"}, {"features", "multi_tags"},
+        {"properties", "sections"}
+    };
+    std::vector<std::string> known = collections();
+
+    for (auto &kind : only) {
+        if (std::find(known.begin(), known.end(), kind) == known.end()) {
+            throw std::invalid_argument("Unknown collection '" + kind + "'");
+        }
+        this->only.insert(kind);
+    }
+    // collections are nested at most two containers deep
+    for (size_t i = 0; i < 2; i++) {
+        for (auto &c : containers) {
+            if (this->only.count(c.first)) {
+                this->only.insert(c.second);
+            }
+        }
+    }
+}
+
+std::vector<std::string> yamlstream::collections() {
+    return {"blocks", "sections", "properties", "data_arrays", "tags", "multi_tags",
+            "sources", "references", "features"};
+}
 
 void yamlstream::indent_if() {
     // if endl
-    if (!strcmp(&*sstream.str().rbegin(), "\n")) {
+    if (buf.at_line_start()) {
         (*this)[level];
     }
 }
 
 void yamlstream::endl_if() {
     // if _not_ endl
-    if (strcmp(&*sstream.str().rbegin(), "\n")) {
+    if (!buf.at_line_start()) {
         sstream << "\n";
     }
 }
 
+bool yamlstream::expand(const std::string &kind) const {
+    return depth < max_depth && (only.empty() || only.count(kind) > 0);
+}
+
 std::string yamlstream::item() {
     return std::string(level ? item_str : "");
 }
@@ -62,24 +164,12 @@ yamlstream& yamlstream::operator++() {
     return *this;
 }
 
-yamlstream yamlstream::operator++(int) {
-    yamlstream tmp(*this);
-    operator++(); // prefix-increment this instance
-    return tmp;   // return value before increment
-}
-
-yamlstream yamlstream::operator--() {
+yamlstream& yamlstream::operator--() {
     endl_if();
     level--;
     return *this;
 }
 
-yamlstream yamlstream::operator--(int) {
-    yamlstream tmp(*this);
-    operator--(); // prefix-decrement this instance
-    return tmp;   // return value before increment
-}
-
 yamlstream& yamlstream::operator[](const size_t n_indent) {
     endl_if();
     for (size_t i = 0; i < n_indent; i++) {
@@ -109,10 +199,6 @@ std::string yamlstream::t(const time_t &tm) {
     return std::string(tbuff);
 }
 
-std::string yamlstream::str() {
-    return sstream.str();
-}
-
 yamlstream& yamlstream::operator<<(const nix::NDSize &t)
 {
     indent_if();
@@ -199,13 +285,7 @@ yamlstream& yamlstream::operator<<(const nix::Source &source) {
         << "sourceCount" << scalar_start << source.sourceCount() << scalar_end;
 
         // Sources
-        *this << "sources";
-        ++(*this);
-            auto sources = source.sources();
-            for (auto &source : sources) {
-                *this << source;            
-            }
-        --(*this);
+        children("sources", [&source] { return source.sources(); });
     --(*this);
     return *this;
 }
@@ -221,25 +301,13 @@ yamlstream& yamlstream::operator<<(const nix::Section &section) {
         << "propertyCount" << scalar_start << section.propertyCount() << scalar_end
         << "sectionCount" << scalar_start << section.sectionCount() << scalar_end
         << "mapping" << scalar_start << section.mapping() << scalar_end
-        << "repository" << scalar_start << section.repository() << scalar_end
-        << "link"; ++(*this) << section.link(); --(*this);
+        << "repository" << scalar_start << section.repository() << scalar_end;
+        child("link", "sections", section.link());
 
         // Properties
-        *this << "properties";
-        ++(*this);
-            auto properties = section.properties();
-            for (auto &property : properties) {
-                *this << property;
-            }
-        --(*this);
+        children("properties", [&section] { return section.properties(); });
         // Sections
-        *this << "sections";
-        ++(*this);
-            auto sections = section.sections();
-            for (auto &section : sections) {
-                *this << section;            
-            }
-        --(*this);
+        children("sections", [&section] { return section.sections(); });
     --(*this);
     return *this;
 }
@@ -364,21 +432,9 @@ yamlstream& yamlstream::operator<<(const nix::Tag &tag) {
         << "extent" << scalar_start << tag.extent() << scalar_end
         << "position" << scalar_start << tag.position() << scalar_end;
         // References
-        *this << "references";
-        ++(*this);
-            auto refs = tag.references();
-            for (auto &ref : refs) {
-                *this << ref;
-            }
-        --(*this);
+        children("references", [&tag] { return tag.references(); });
         // Features
-        *this << "features";
-        ++(*this);
-            auto features = tag.features();
-            for (auto &feature : features) {
-                *this << feature;
-            }
-        --(*this);
+        children("features", [&tag] { return tag.features(); });
     --(*this);
     return *this;
 }
@@ -397,21 +453,9 @@ yamlstream& yamlstream::operator<<(const nix::MultiTag &multi_tag) {
         << "extents"; ++(*this) << multi_tag.extents(); --(*this)
         << "positions"; ++(*this) << multi_tag.positions(); --(*this);
         // References
-        *this << "references";
-        ++(*this);
-            auto refs = multi_tag.references();
-            for (auto &ref : refs) {
-                *this << ref;
-            }
-        --(*this);
+        children("references", [&multi_tag] { return multi_tag.references(); });
         // Features
-        *this << "features";
-        ++(*this);
-            auto features = multi_tag.features();
-            for (auto &feature : features) {
-                *this << feature;
-            }
-        --(*this);
+        children("features", [&multi_tag] { return multi_tag.features(); });
     --(*this);
     return *this;
 }
@@ -429,37 +473,13 @@ yamlstream& yamlstream::operator<<(const nix::Block &block) {
         << "multiTagCount" << scalar_start << block.multiTagCount() << scalar_end
         << "dataArrayCount" << scalar_start << block.dataArrayCount() << scalar_end;
         // DataArrays
-        *this << "data_arrays";
-        ++(*this);
-            auto data_arrays = block.dataArrays();
-            for (auto &data_array : data_arrays) {
-                *this << data_array;
-            }
-        --(*this);
+        children("data_arrays", [&block] { return block.dataArrays(); });
         // MultiTags
-        *this << "multi_tags";
-        ++(*this);
-            auto multi_tags = block.multiTags();
-            for (auto &multi_tag : multi_tags) {
-                *this << multi_tag;
-            }
-        --(*this);
+        children("multi_tags", [&block] { return block.multiTags(); });
         // Tags
-        *this << "tags";
-        ++(*this);
-            auto tags = block.tags();
-            for (auto &tag : tags) {
-                *this << tag;
-            }
-        --(*this);
+        children("tags", [&block] { return block.tags(); });
         // Sources
-        *this << "sources";
-        ++(*this);
-            auto sources = block.sources();
-            for (auto &source : sources) {
-                *this << source;            
-            }
-        --(*this);
+        children("sources", [&block] { return block.sources(); });
     --(*this);
     return *this;
 }
@@ -480,27 +500,235 @@ yamlstream& yamlstream::operator<<(const nix::File &file) {
         << "blockCount" << scalar_start << file.blockCount() << scalar_end
         << "sectionCount" << scalar_start << file.sectionCount() << scalar_end;
         // Blocks
-        *this << "blocks";
-        ++(*this);
-            auto blocks = file.blocks();
-            for (auto &block : blocks) {
-                *this << block;
-            }
-        --(*this);
+        children("blocks", [&file] { return file.blocks(); });
         // Sections
-        *this << "sections";
-        ++(*this);
-            auto sections = file.sections();
-            for (auto &section : sections) {
-                *this << section;            
-            }
-        --(*this);
+        children("sections", [&file] { return file.sections(); });
     --(*this);
     
     return *this;
 }
 
 
+data_export::Format data_export::format(const std::string &name) {
+    if (name == "raw") {
+        return Format::Raw;
+    } else if (name == "npy") {
+        return Format::Npy;
+    } else if (name == "csv") {
+        return Format::Csv;
+    }
+    throw std::invalid_argument("Unknown data format '" + name + "'");
+}
+
+std::string data_export::extension() const {
+    switch (fmt) {
+        case Format::Raw: return ".bin";
+        case Format::Npy: return ".npy";
+        case Format::Csv: return ".csv";
+    }
+    return "";
+}
+
+bool data_export::selection(const std::string &select, const nix::NDSize &extent,
+                            nix::NDSize &offset, nix::NDSize &count) {
+    offset = nix::NDSize(extent.size(), 0);
+    count = extent;
+    if (select.empty()) {
+        return true;
+    }
+
+    std::vector<std::string> parts;
+    std::stringstream list(select);
+    std::string part;
+    while (std::getline(list, part, ',')) {
+        parts.push_back(part);
+    }
+    if (parts.size() != extent.size()) {
+        return false;
+    }
+
+    auto index = [&select](const std::string &str, nix::ndsize_t fallback) {
+        if (str.empty()) {
+            return fallback;
+        }
+        size_t end = 0;
+        nix::ndsize_t i = 0;
+        try {
+            i = std::stoull(str, &end);
+        } catch (std::exception &) {
+            end = 0;
+        }
+        if (end != str.size() || str[0] == '-') {
+            throw std::invalid_argument("Invalid selection '" + select + "'");
+        }
+        return i;
+    };
+
+    for (size_t i = 0; i < parts.size(); i++) {
+        size_t colon = parts[i].find(':');
+        nix::ndsize_t start, stop;
+        if (colon == std::string::npos) {
+            start = index(parts[i], 0);
+            stop = start + 1;
+        } else {
+            start = index(parts[i].substr(0, colon), 0);
+            stop = index(parts[i].substr(colon + 1), extent[i]);
+        }
+        if (start > stop || stop > extent[i]) {
+            return false;
+        }
+        offset[i] = start;
+        count[i] = stop - start;
+    }
+    return true;
+}
+
+nix::DataType data_export::dataType(const nix::DataArray &array) {
+    nix::DataType dtype = array.dataType();
+    if (dtype == nix::DataType::String || dtype == nix::DataType::Opaque || dtype == nix::DataType::Nothing) {
+        return nix::DataType::Nothing;
+    }
+    if (array.polynomCoefficients().size() || array.expansionOrigin()) {
+        return nix::DataType::Double;
+    }
+    return dtype;
+}
+
+void data_export::npy_header(std::ostream &out, nix::DataType dtype, const nix::NDSize &shape) {
+    std::string descr;
+    switch (dtype) {
+        case nix::DataType::Bool:   descr = "|b1"; break;
+        case nix::DataType::Char:   descr = "|S1"; break;
+        case nix::DataType::Int8:   descr = "|i1"; break;
+        case nix::DataType::UInt8:  descr = "|u1"; break;
+        case nix::DataType::Int16:  descr = "<i2"; break;
+        case nix::DataType::UInt16: descr = "<u2"; break;
+        case nix::DataType::Int32:  descr = "<i4"; break;
+        case nix::DataType::UInt32: descr = "<u4"; break;
+        case nix::DataType::Int64:  descr = "<i8"; break;
+        case nix::DataType::UInt64: descr = "<u8"; break;
+        case nix::DataType::Float:  descr = "<f4"; break;
+        case nix::DataType::Double: descr = "<f8"; break;
+        default: throw std::invalid_argument("Data type cannot be exported to npy");
+    }
+    if (descr[0] == '<' && !little_endian()) {
+        descr[0] = '>';
+    }
+
+    std::string dict = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (";
+    for (size_t i = 0; i < shape.size(); i++) {
+        dict += std::to_string(shape[i]) + (shape.size() == 1 ? "," : i + 1 < shape.size() ? ", " : "");
+    }
+    dict += "), }";
+
+    // magic, version 1.0 and header length; the data starts 64 byte aligned
+    const size_t preamble = 10;
+    size_t length = dict.size() + 1;
+    length += (64 - (preamble + length) % 64) % 64;
+    dict.append(length - dict.size() - 1, ' ');
+    dict += '\n';
+
+    const char magic[] = {'\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0,
+                          static_cast<char>(length & 0xff), static_cast<char>(length >> 8)};
+    out.write(magic, sizeof(magic));
+    out << dict;
+}
+
+template<typename T>
+void data_export::csv(const T *data, size_t n, nix::ndsize_t position, nix::ndsize_t cols, std::string &text) {
+    for (size_t i = 0; i < n; i++) {
+        append_value(data[i], text);
+        text += (++position % cols == 0) ? '\n' : ',';
+    }
+}
+
+nix::ndsize_t data_export::write(const nix::DataArray &array, const nix::NDSize &offset, const nix::NDSize &count,
+                                 const std::string &file_path) const {
+    nix::DataType dtype = dataType(array);
+    if (dtype == nix::DataType::Nothing) {
+        throw std::invalid_argument("Data type " + nix::data_type_to_string(array.dataType()) + " cannot be exported");
+    }
+    std::ofstream fout(file_path, std::ios::binary);
+    if (!fout) {
+        throw std::runtime_error("Cannot write '" + file_path + "'");
+    }
+    if (fmt == Format::Npy) {
+        npy_header(fout, dtype, count);
+    }
+
+    size_t rank = count.size();
+    if (rank == 0 || count.nelms() == 0) {
+        return 0;
+    }
+
+    // a slab holds all of the dimensions after d that fit into slab_size,
+    // and as many indices of dimension d as fit next to them
+    size_t esize = nix::data_type_to_size(dtype);
+    size_t d = rank - 1;
+    nix::ndsize_t inner = 1;
+    while (d > 0 && inner * count[d] * esize <= slab_size) {
+        inner *= count[d];
+        d--;
+    }
+    nix::ndsize_t rows = std::max<nix::ndsize_t>(1, std::min<nix::ndsize_t>(count[d], slab_size / (inner * esize)));
+
+    nix::NDSize slab_count(count), slab_offset(offset);
+    nix::NDSize index(rank, 0);
+    for (size_t i = 0; i < d; i++) {
+        slab_count[i] = 1;
+    }
+    // csv: one value per line for vectors, the last dimension as columns otherwise
+    nix::ndsize_t cols = rank == 1 ? 1 : count[rank - 1];
+    std::vector<char> buffer(static_cast<size_t>(rows * inner * esize));
+    std::string text;
+    nix::ndsize_t written = 0;
+
+    while (index[0] < count[0]) {
+        slab_count[d] = std::min(rows, count[d] - index[d]);
+        for (size_t i = 0; i <= d; i++) {
+            slab_offset[i] = offset[i] + index[i];
+        }
+        array.getData(dtype, buffer.data(), slab_count, slab_offset);
+        size_t n = static_cast<size_t>(slab_count[d] * inner);
+
+        if (fmt == Format::Csv) {
+            text.clear();
+            switch (dtype) {
+                case nix::DataType::Bool:   csv(reinterpret_cast<bool *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::Char:   csv(reinterpret_cast<char *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::Int8:   csv(reinterpret_cast<int8_t *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::UInt8:  csv(reinterpret_cast<uint8_t *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::Int16:  csv(reinterpret_cast<int16_t *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::UInt16: csv(reinterpret_cast<uint16_t *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::Int32:  csv(reinterpret_cast<int32_t *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::UInt32: csv(reinterpret_cast<uint32_t *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::Int64:  csv(reinterpret_cast<int64_t *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::UInt64: csv(reinterpret_cast<uint64_t *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::Float:  csv(reinterpret_cast<float *>(buffer.data()), n, written, cols, text); break;
+                case nix::DataType::Double: csv(reinterpret_cast<double *>(buffer.data()), n, written, cols, text); break;
+                default: break;
+            }
+            fout.write(text.data(), text.size());
+        } else {
+            fout.write(buffer.data(), n * esize);
+        }
+        written += n;
+
+        // next slab, in row major order
+        index[d] += slab_count[d];
+        for (size_t i = d; i > 0 && index[i] >= count[i]; i--) {
+            index[i] = 0;
+            index[i - 1]++;
+        }
+    }
+
+    if (!fout) {
+        throw std::runtime_error("Cannot write '" + file_path + "'");
+    }
+    return written;
+}
+
+
 void Dump::load(po::options_description &desc) const {
     // declare purpose
     desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" + 
@@ -510,13 +738,17 @@ void Dump::load(po::options_description &desc) const {
     opt.add_options()
         (DATA_OPTION, "dump data from all 2D DataArrays")
         (PLOT_OPTION, ("dump & plot (only) data from all 2D DataArrays (linux only, invokes --" + std::string(DATA_OPTION) + ")").c_str())
+        (DEPTH_OPTION, po::value<size_t>(), "dump entities only up to the given depth below the file (0: file only, 1: blocks & sections, ...)")
+        (ONLY_OPTION, po::value<std::string>(), ("dump only the given comma separated collections and those containing them (" +
+                                                 boost::algorithm::join(yamlstream::collections(), ", ") + ")").c_str())
+        (FORMAT_OPTION, po::value<std::string>(), "export data from all DataArrays of any rank as raw, npy or csv files, in bounded slabs")
+        (SELECT_OPTION, po::value<std::string>(), ("export only the given hyperslab, e.g. 0:100,:,5 (with --" + std::string(FORMAT_OPTION) + ")").c_str())
     ;
     desc.add(opt);
 }
 
-std::string Dump::call(const po::variables_map &vm, const po::options_description &desc) {
+void Dump::call(const po::variables_map &vm, const po::options_description &desc, std::ostream &out) {
     std::vector<nix::File> files; // opened nix files
-    std::stringstream out;
     std::ofstream fout;
     nix::File tmp_file;
     std::string file_name;
@@ -530,7 +762,7 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
         po::options_description temp;
         load(temp);
         out << temp << std::endl;
-        return out.str();
+        return;
     }
     // --input-file
     if (vm.count(INPFILE_OPTION)) {
@@ -549,11 +781,49 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
             // save it!
             files.push_back(tmp_file); // ReadOnly, ReadWrite, Overwrite
         }
+        // --depth, --only
+        size_t max_depth = std::numeric_limits<size_t>::max();
+        if (vm.count(DEPTH_OPTION)) {
+            max_depth = vm[DEPTH_OPTION].as<size_t>();
+        }
+        std::set<std::string> only;
+        if (vm.count(ONLY_OPTION)) {
+            std::stringstream list(vm[ONLY_OPTION].as<std::string>());
+            std::string kind;
+            while (std::getline(list, kind, ',')) {
+                if (!kind.empty()) {
+                    only.insert(kind);
+                }
+            }
+        }
         // loop through entities in all files
         for (auto &file : files) {
-            if ( ! (vm.count(DATA_OPTION) || vm.count(PLOT_OPTION)) ) {
+            if (vm.count(FORMAT_OPTION)) {
+                data_export exporter(data_export::format(vm[FORMAT_OPTION].as<std::string>()));
+                std::string select = vm.count(SELECT_OPTION) ? vm[SELECT_OPTION].as<std::string>() : "";
+                for (auto &block : file.blocks()) {
+                    for (auto &data_array : block.dataArrays()) {
+                        nix::NDSize offset, count;
+                        if (data_export::dataType(data_array) == nix::DataType::Nothing) {
+                            out << "skipping data_array " << data_array.id() << ": "
+                                << data_array.dataType() << " data cannot be exported" << std::endl;
+                            continue;
+                        }
+                        if (!data_export::selection(select, data_array.dataExtent(), offset, count)) {
+                            out << "skipping data_array " << data_array.id() << ": "
+                                << "selection does not fit extent " << shape(data_array.dataExtent()) << std::endl;
+                            continue;
+                        }
+                        file_name = "data_array_" + data_array.id() + exporter.extension();
+                        exporter.write(data_array, offset, count, file_name);
+                        out << file_name << ": " << data_export::dataType(data_array) << " " << shape(count) << std::endl;
+                    }
+                }
+            }
+            else if ( ! (vm.count(DATA_OPTION) || vm.count(PLOT_OPTION)) ) {
+                yamlstream yaml(out, max_depth, only);
                 yaml << file;
-                out << yaml.str();
+                out.flush();
             }
             else {
                 // loop through all data_arrays
@@ -583,7 +853,7 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
 
                             #ifndef _WIN32
                             if (vm.count(PLOT_OPTION)) {
-                                std::cout << "press ctrl+c for next plot" << std::endl;
+                                out << "press ctrl+c for next plot" << std::endl;
                                 plot_script script(A_min, A_max, static_cast<size_t>(dim1), static_cast<size_t>(dim2), file_name + ".txt");
                                 fout.open(file_name + ".gnu");
                                 fout << script.str();
@@ -601,8 +871,6 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
     else {
         throw NoInputFile();
     }
-    
-    return out.str();
 }
 
 } // namespace module
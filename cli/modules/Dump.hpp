@@ -22,6 +22,9 @@
 #include <modules/IModule.hpp>
 
 #include <string>
+#include <set>
+#include <limits>
+#include <streambuf>
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
@@ -36,6 +39,10 @@ namespace module {
 
 const char *const DATA_OPTION = "data";
 const char *const PLOT_OPTION = "plot";
+const char *const DEPTH_OPTION = "depth";
+const char *const ONLY_OPTION = "only";
+const char *const FORMAT_OPTION = "format";
+const char *const SELECT_OPTION = "select";
 
 class plot_script {
 private:
@@ -92,6 +99,152 @@ public:
     }
 };
 
+class data_export {
+public:
+    enum class Format {
+        Raw, Npy, Csv
+    };
+
+private:
+    static const size_t slab_size;
+
+    Format fmt;
+
+    /**
+     * @brief write the header of a npy file
+     *
+     * @param out the file to write to
+     * @param dtype data type of the elements
+     * @param shape shape of the exported data
+     * @return void
+     */
+    static void npy_header(std::ostream &out, nix::DataType dtype, const nix::NDSize &shape);
+
+    /**
+     * @brief format elements as csv
+     *
+     * Append n elements to text, separated by "," within and by "\n"
+     * at the end of the rows of the last dimension.
+     *
+     * @param data the elements
+     * @param n number of elements
+     * @param position index of the first element in the export
+     * @param cols elements per row
+     * @param text string to append to
+     * @return void
+     */
+    template<typename T>
+    static void csv(const T *data, size_t n, nix::ndsize_t position, nix::ndsize_t cols, std::string &text);
+
+public:
+    /**
+     * @brief exporter for the given format
+     *
+     * Data is read in slabs of bounded size and written directly to
+     * the file, so memory use does not depend on the size of the data.
+     *
+     * @param fmt the file format
+     */
+    data_export(Format fmt) : fmt(fmt) {}
+
+    /**
+     * @brief parse the name of a format
+     *
+     * @param name one of "raw", "npy" or "csv"
+     * @return the format
+     */
+    static Format format(const std::string &name);
+
+    /**
+     * @brief file name extension of the format
+     *
+     * @return extension including the dot
+     */
+    std::string extension() const;
+
+    /**
+     * @brief parse a hyperslab selection
+     *
+     * The selection has one comma separated entry per dimension, each
+     * either "start:stop" (start or stop may be left out) or a single
+     * index. An empty selection selects all data.
+     *
+     * @param select the selection
+     * @param extent extent of the data
+     * @param offset set to the offset of the selection
+     * @param count set to the count of the selection
+     * @return false if the selection does not fit the extent
+     */
+    static bool selection(const std::string &select, const nix::NDSize &extent,
+                          nix::NDSize &offset, nix::NDSize &count);
+
+    /**
+     * @brief data type that is exported for a DataArray
+     *
+     * The stored data type, or Double if a polynomial or expansion
+     * origin has to be applied; Nothing if the data cannot be exported.
+     *
+     * @param array the DataArray
+     * @return the data type
+     */
+    static nix::DataType dataType(const nix::DataArray &array);
+
+    /**
+     * @brief export a hyperslab of a DataArray into a file
+     *
+     * @param array the DataArray
+     * @param offset offset of the hyperslab
+     * @param count count of the hyperslab
+     * @param file_path the file to write
+     * @return number of elements written
+     */
+    nix::ndsize_t write(const nix::DataArray &array, const nix::NDSize &offset, const nix::NDSize &count,
+                        const std::string &file_path) const;
+};
+
+class linebuf : public std::streambuf {
+    std::streambuf *dest;
+    char last;
+
+public:
+    /**
+     * @brief forward all output to dest
+     *
+     * Forward all output unbuffered to dest and remember the last
+     * character written, so that nothing written has to be read back.
+     */
+    linebuf(std::streambuf *dest) : dest(dest), last('\n') {}
+
+    /**
+     * @brief check if the output is at the start of a line
+     *
+     * @return true if nothing or a "\n" was written last
+     */
+    bool at_line_start() const {
+        return last == '\n';
+    }
+
+protected:
+    int_type overflow(int_type c) {
+        if (traits_type::eq_int_type(c, traits_type::eof())) {
+            return traits_type::not_eof(c);
+        }
+        last = traits_type::to_char_type(c);
+        return dest->sputc(last);
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n) {
+        if (n > 0) {
+            last = s[n - 1];
+        }
+        return dest->sputn(s, n);
+    }
+
+    int sync() {
+        return dest->pubsync();
+    }
+};
+
 class yamlstream {
     static const char* indent_str;
     static const char* scalar_start;
@@ -101,7 +254,12 @@ class yamlstream {
     static const char* item_str;
     
     size_t level;
-    std::stringstream &sstream;
+    linebuf buf;
+    std::ostream sstream;
+
+    size_t depth;
+    size_t max_depth;
+    std::set<std::string> only;
     
     /**
      * @brief apply indentation on sstream if last char is "\n"
@@ -113,53 +271,93 @@ class yamlstream {
     void indent_if();
     
     /**
-     * @brief apply indentation on sstream if last char is "\n"
+     * @brief put "\n" into sstream if last char is not "\n"
      *
-     * Apply indentation on sstream if last char is "\n"
+     * Put "\n" into sstream if last char is not "\n"
      *
      * @return void
      */
     void endl_if();
-    
+
     /**
-     * @brief return item_str if and only if level is not zero
+     * @brief check if entities below the current one are output
      *
-     * Return the item string if and only if we are not outputting to
-     * the base level, but to some sub level
+     * Entities are only output up to the maximum depth, and only if
+     * their collection is selected.
      *
-     * @return string item_str
+     * @param kind name of the collection the entities belong to
+     * @return true if the entities are output
      */
-    std::string item();
-    
+    bool expand(const std::string &kind) const;
+
     /**
-     * @brief start yaml sequence & increase indent level
+     * @brief output a single entity one level below the current one
      *
-     * Put the defined sequ_start into the stream and increase
-     * indentation level.
+     * Output the key and the entity as sequence, if expand(kind)
+     * permits it.
      *
+     * @param key name of the entity
+     * @param kind name of the collection the entity belongs to
+     * @param entity the entity to output
      * @return self
      */
-    yamlstream& operator++();
-    
+    template<typename T>
+    yamlstream& child(const char *key, const char *kind, const T &entity) {
+        if (expand(kind)) {
+            (*this) << key;
+            ++(*this);
+            depth++;
+            (*this) << entity;
+            depth--;
+            --(*this);
+        }
+        return *this;
+    }
+
     /**
-     * @brief start yaml sequence & increase indent level
+     * @brief output a collection of entities one level below the current one
      *
-     * Put the defined sequ_start into the stream and increase
-     * indentation level.
+     * Output the key and all entities as sequence, if expand(key) permits
+     * it. The entities are only retrieved in that case.
      *
+     * @param key name of the collection
+     * @param get function returning the entities
      * @return self
      */
-    yamlstream operator++(int);
-
+    template<typename F>
+    yamlstream& children(const char *key, F get) {
+        if (expand(key)) {
+            (*this) << key;
+            ++(*this);
+            depth++;
+            for (auto &entity : get()) {
+                (*this) << entity;
+            }
+            depth--;
+            --(*this);
+        }
+        return *this;
+    }
+    
     /**
-     * @brief end yaml sequence & decrease indent level
+     * @brief return item_str if and only if level is not zero
      *
-     * Put the defined sequ_end into the stream and decrease 
+     * Return the item string if and only if we are not outputting to
+     * the base level, but to some sub level
+     *
+     * @return string item_str
+     */
+    std::string item();
+    
+    /**
+     * @brief start yaml sequence & increase indent level
+     *
+     * Put the defined sequ_start into the stream and increase
      * indentation level.
      *
      * @return self
      */
-    yamlstream operator--();
+    yamlstream& operator++();
 
     /**
      * @brief end yaml sequence & decrease indent level
@@ -169,7 +367,7 @@ class yamlstream {
      *
      * @return self
      */
-    yamlstream operator--(int);
+    yamlstream& operator--();
 
     /**
      * @brief put yaml indentation into stream
@@ -193,18 +391,25 @@ public:
     /**
      * @brief default ctor
      *
-     * The default constructor.
+     * Output is written directly to the given stream. Entities are
+     * output up to max_depth levels below the file; if only is not
+     * empty, it names the collections that are output (together with
+     * the collections that contain them).
+     *
+     * @param out the stream to write to
+     * @param max_depth maximum depth of entities to output
+     * @param only names of the collections to output
      */
-    yamlstream(std::stringstream &sstream) : level(0), sstream(sstream) {};
+    yamlstream(std::ostream &out,
+               size_t max_depth = std::numeric_limits<size_t>::max(),
+               const std::set<std::string> &only = std::set<std::string>());
 
     /**
-     * @brief return stringstream as string
+     * @brief names of all collections that can be selected
      *
-     * Return string from stringstream
-     *
-     * @return string string content of the stream
+     * @return vector with the collection names
      */
-    std::string str();
+    static std::vector<std::string> collections();
 
     /**
      * @brief default output into stringstream
@@ -277,7 +482,7 @@ public:
      * @param ps pointer to stringstream
      * @return self
      */
-	yamlstream& operator<<(std::stringstream& (*ps)(std::stringstream&))
+	yamlstream& operator<<(std::ostream& (*ps)(std::ostream&))
 	{
         indent_if();
 		sstream << ps;
@@ -332,8 +537,8 @@ public:
     template<typename T>
     yamlstream& operator<<(const nix::base::EntityWithMetadata<T> &entityWithMetadata) {
         (*this)
-        << static_cast<nix::base::NamedEntity<T>>(entityWithMetadata)
-        << "metadata"; ++(*this) << entityWithMetadata.metadata(); --(*this);
+        << static_cast<nix::base::NamedEntity<T>>(entityWithMetadata);
+        child("metadata", "sections", entityWithMetadata.metadata());
         
         return *this;
     }
@@ -500,12 +705,7 @@ public:
 
 class Dump : virtual public IModule {
     
-    yamlstream yaml;
-    std::stringstream sstream;
-    
 public:
-    Dump() : yaml(yamlstream(sstream)) {}
-
     static const char* module_name;
 
     std::string name() const {
@@ -514,7 +714,7 @@ public:
 
     void load(po::options_description &desc) const;
 
-    std::string call(const po::variables_map &vm, const po::options_description &desc);
+    void call(const po::variables_map &vm, const po::options_description &desc, std::ostream &out);
 
 };
 
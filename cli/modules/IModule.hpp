@@ -10,6 +10,7 @@
 #define CLI_IMODULE_H
 
 #include <string>
+#include <ostream>
 
 #include <boost/program_options.hpp>
 namespace po = boost::program_options;
@@ -53,12 +54,14 @@ public:
      *
      * Module caller that will execute all the tasks the module is
      * meant to execute, depending on the options supplied via the
-     * boost::program_options::variables_map object.
+     * boost::program_options::variables_map object. The response for
+     * the user is written to the given stream as it is produced.
      *
      * @param vm boost::program_options::variables_map object
-     * @return string with the module response for the user
+     * @param out stream that receives the module response for the user
+     * @return void
      */
-    virtual std::string call(const po::variables_map &vm, const po::options_description &desc) = 0;
+    virtual void call(const po::variables_map &vm, const po::options_description &desc, std::ostream &out) = 0;
     
 };
 
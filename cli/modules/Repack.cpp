@@ -0,0 +1,225 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <Cli.hpp>
+#include <modules/Repack.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Repack::module_name = "repack";
+const size_t Repack::slab_size = 4 * 1024 * 1024;
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string percent(double part, double whole) {
+    std::stringstream str;
+    str << std::fixed << std::setprecision(1) << (whole > 0 ? 100.0 * (whole - part) / whole : 0.0) << "%";
+    return str.str();
+}
+
+} // anonymous namespace
+
+
+void chunk_table::add(const std::string &spec) {
+    std::string::size_type eq = spec.find('=');
+    if (eq == std::string::npos) {
+        throw std::invalid_argument("chunk shape '" + spec + "' is not of the form [dtype:]rank=c1,c2,...");
+    }
+    std::string key = spec.substr(0, eq);
+    nix::DataType dtype = nix::DataType::Nothing;
+    std::string::size_type colon = key.find(':');
+    if (colon != std::string::npos) {
+        dtype = nix::string_to_data_type(key.substr(0, colon));
+        key = key.substr(colon + 1);
+    }
+
+    size_t rank;
+    std::vector<nix::ndsize_t> chunks;
+    try {
+        size_t pos;
+        rank = std::stoul(key, &pos);
+        if (pos != key.size()) {
+            throw std::invalid_argument(key);
+        }
+        std::stringstream list(spec.substr(eq + 1));
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            chunks.push_back(std::stoull(item, &pos));
+            if (pos != item.size()) {
+                throw std::invalid_argument(item);
+            }
+        }
+    } catch (std::logic_error &) {
+        throw std::invalid_argument("chunk shape '" + spec + "' is not of the form [dtype:]rank=c1,c2,...");
+    }
+    if (rank == 0 || chunks.size() != rank) {
+        throw std::invalid_argument("chunk shape '" + spec + "' does not give one size per dimension");
+    }
+
+    nix::NDSize shape(rank);
+    std::copy(chunks.begin(), chunks.end(), shape.data());
+    shapes[std::make_pair(dtype, rank)] = shape;
+}
+
+
+nix::NDSize chunk_table::operator()(nix::DataType dtype, const nix::NDSize &extent) const {
+    auto it = shapes.find(std::make_pair(dtype, extent.size()));
+    if (it == shapes.end()) {
+        it = shapes.find(std::make_pair(nix::DataType::Nothing, extent.size()));
+    }
+    if (it == shapes.end()) {
+        return nix::NDSize();
+    }
+    nix::NDSize shape = it->second;
+    for (size_t i = 0; i < shape.size(); i++) {
+        if (shape[i] == 0) {
+            shape[i] = std::max<nix::ndsize_t>(extent[i], 1);
+        }
+    }
+    return shape;
+}
+
+
+void Repack::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Copies a nix-file into a new file, reclaiming the space of deleted entities\n\t" +
+                                     "and storing the data with the given chunking, compression and layout.\n\n\t" +
+                                     "Usage: nix-tool repack [options] input-file output-file\n\nSupported options"));
+    po::options_description opt;
+    opt.add_options()
+        (OUTPUT_OPTION, po::value<std::string>(), "the file to write, instead of a second input-file")
+        (CHUNK_OPTION, po::value< std::vector<std::string> >()->composing(),
+         "chunk shape of data of the given rank (and type), e.g. 2=1024,0 or double:1=65536; 0 stands for the whole extent, may be given more than once")
+        (COMPRESSION_OPTION, po::value<int>(), "deflate compression level from 1 to 9, 0 disables compression")
+        (COMPACT_OPTION, po::value<size_t>(), "store data of at most this many bytes in the object header (up to 63 KiB); the extent of such DataArrays can not be changed afterwards")
+        (LATEST_OPTION, "use the latest HDF5 file format, with compact and indexed link storage")
+        (MEASURE_OPTION, "time reading the data of all DataArrays of both files")
+    ;
+    desc.add(opt);
+}
+
+
+double Repack::readTime(const std::string &path) {
+    auto start = std::chrono::steady_clock::now();
+    nix::File file = nix::File::open(path, nix::FileMode::ReadOnly);
+    std::vector<char> buffer;
+    for (const auto &block : file.blocks()) {
+        for (const auto &array : block.dataArrays()) {
+            nix::DataType dtype = array.dataType();
+            nix::NDSize extent = array.dataExtent();
+            if (!nix::data_type_is_numeric(dtype) || extent.size() == 0 || extent.nelms() == 0) {
+                continue;
+            }
+            // whole rows of the first dimension, at least one per slab
+            size_t esize = nix::data_type_to_size(dtype);
+            nix::ndsize_t row = extent.nelms() / extent[0];
+            nix::ndsize_t rows = std::max<nix::ndsize_t>(1, slab_size / (row * esize));
+            nix::NDSize count(extent), offset(extent.size(), 0);
+            for (nix::ndsize_t first = 0; first < extent[0]; first += rows) {
+                offset[0] = first;
+                count[0] = std::min(rows, extent[0] - first);
+                buffer.resize(static_cast<size_t>(count[0] * row * esize));
+                array.getDataDirect(dtype, buffer.data(), count, offset);
+            }
+        }
+    }
+    file.close();
+    return seconds_since(start);
+}
+
+
+void Repack::call(const po::variables_map &vm, const po::options_description &desc, std::ostream &out) {
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return;
+    }
+    if (!vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+
+    // input-file [output-file] | --output
+    std::vector<std::string> paths = vm[INPFILE_OPTION].as< std::vector<std::string> >();
+    if (vm.count(OUTPUT_OPTION)) {
+        paths.push_back(vm[OUTPUT_OPTION].as<std::string>());
+    }
+    if (paths.size() != 2) {
+        throw std::invalid_argument("repack needs exactly one input-file and one output-file");
+    }
+    const std::string &input = paths[0], &output = paths[1];
+    if (!boost::filesystem::exists(input)) {
+        throw FileNotFound(input);
+    }
+    if (boost::filesystem::exists(output)) {
+        throw std::invalid_argument("output file " + output + " exists already");
+    }
+
+    nix::StorageOptions options;
+    if (vm.count(CHUNK_OPTION)) {
+        chunk_table table;
+        for (auto &spec : vm[CHUNK_OPTION].as< std::vector<std::string> >()) {
+            table.add(spec);
+        }
+        options.chunking = table;
+    }
+    if (vm.count(COMPRESSION_OPTION)) {
+        options.compression = vm[COMPRESSION_OPTION].as<int>();
+        if (options.compression < 0 || options.compression > 9) {
+            throw std::invalid_argument("compression level must be between 0 and 9");
+        }
+    }
+    if (vm.count(COMPACT_OPTION)) {
+        options.compact_limit = vm[COMPACT_OPTION].as<size_t>();
+    }
+    options.latest_format = vm.count(LATEST_OPTION) > 0;
+
+    auto start = std::chrono::steady_clock::now();
+    nix::File file = nix::File::open(input, nix::FileMode::ReadOnly);
+    if (!file.isOpen()) {
+        throw FileNotOpen(input);
+    }
+    file.repack(output, options);
+    file.close();
+    double repack_time = seconds_since(start);
+
+    double in_size = static_cast<double>(boost::filesystem::file_size(input));
+    double out_size = static_cast<double>(boost::filesystem::file_size(output));
+    out << "repacked " << input << " into " << output
+        << " in " << std::fixed << std::setprecision(2) << repack_time << " s" << std::endl;
+    out << "size: " << static_cast<uintmax_t>(in_size) << " -> " << static_cast<uintmax_t>(out_size)
+        << " bytes (saved " << percent(out_size, in_size) << ")" << std::endl;
+
+    // --measure
+    if (vm.count(MEASURE_OPTION)) {
+        double in_time = readTime(input);
+        double out_time = readTime(output);
+        out << "read time: " << std::fixed << std::setprecision(3) << in_time << " -> " << out_time
+            << " s (saved " << percent(out_time, in_time) << ")" << std::endl;
+    }
+}
+
+} // namespace module
+} // namespace cli
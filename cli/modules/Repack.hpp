@@ -0,0 +1,80 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef CLI_REPACK_H
+#define CLI_REPACK_H
+
+#include <Cli.hpp>
+#include <modules/IModule.hpp>
+#include <nix.hpp>
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char *const OUTPUT_OPTION = "output";
+const char *const CHUNK_OPTION = "chunk";
+const char *const COMPRESSION_OPTION = "compression";
+const char *const COMPACT_OPTION = "compact";
+const char *const LATEST_OPTION = "latest-format";
+const char *const MEASURE_OPTION = "measure";
+
+/**
+ * Chunk shapes given on the command line as "[dtype:]rank=c1,c2,..."; a
+ * chunk size of 0 stands for the whole extent of that dimension.
+ */
+class chunk_table {
+
+    // keyed by data type and rank, DataType::Nothing matches any type
+    std::map<std::pair<nix::DataType, size_t>, nix::NDSize> shapes;
+
+public:
+
+    void add(const std::string &spec);
+
+    bool empty() const {
+        return shapes.empty();
+    }
+
+    nix::NDSize operator()(nix::DataType dtype, const nix::NDSize &extent) const;
+};
+
+
+class Repack : virtual public IModule {
+
+public:
+
+    static const char* module_name;
+
+    std::string name() const {
+        return std::string(module_name);
+    }
+
+    void load(po::options_description &desc) const;
+
+    void call(const po::variables_map &vm, const po::options_description &desc, std::ostream &out);
+
+private:
+
+    // seconds it takes to read the data of all data arrays of a file
+    static double readTime(const std::string &path);
+
+    static const size_t slab_size;
+};
+
+} // namespace module
+} // namespace cli
+
+#endif
@@ -29,9 +29,8 @@ void Validate::load(po::options_description &desc) const {
     desc.add(opt);
 }
 
-std::string Validate::call(const po::variables_map &vm, const po::options_description &desc) {
+void Validate::call(const po::variables_map &vm, const po::options_description &desc, std::ostream &out) {
     std::vector<nix::File> files; // opened nix files
-    std::stringstream out;
     nix::File tmp_file;
             
     // --help
@@ -39,7 +38,7 @@ std::string Validate::call(const po::variables_map &vm, const po::options_descri
         po::options_description temp;
         load(temp);
         out << temp << std::endl;
-        return out.str();
+        return;
     }
     // --input-file
     if (vm.count(INPFILE_OPTION)) {
@@ -68,13 +67,11 @@ std::string Validate::call(const po::variables_map &vm, const po::options_descri
             }
             out << res;
         }
-        std::cout << std::endl;
+        out << std::endl;
     }
     else {
         throw NoInputFile();
     }
-    
-    return out.str();
 }
 
 } // namespace module
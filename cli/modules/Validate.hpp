@@ -34,7 +34,7 @@ public:
 
     void load(po::options_description &desc) const;
 
-    std::string call(const po::variables_map &vm, const po::options_description &desc);
+    void call(const po::variables_map &vm, const po::options_description &desc, std::ostream &out);
 
 };
 
@@ -14,13 +14,18 @@
 #include <nix/DataArray.hpp>
 #include <nix/MultiTag.hpp>
 #include <nix/Dimensions.hpp>
+#include <nix/AxisView.hpp>
 #include <nix/File.hpp>
+#include <nix/Batch.hpp>
+#include <nix/MetadataSnapshot.hpp>
+#include <nix/StorageOptions.hpp>
 #include <nix/Property.hpp>
 #include <nix/Feature.hpp>
 #include <nix/Section.hpp>
 #include <nix/Tag.hpp>
 #include <nix/Source.hpp>
 #include <nix/Value.hpp>
+#include <nix/ValueColumn.hpp>
 
 
 
@@ -0,0 +1,200 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_AXIS_VIEW_H
+#define NIX_AXIS_VIEW_H
+
+#include <nix/Platform.hpp>
+#include <nix/base/IDimensions.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Read-only view on a range of positions of a SampledDimension or
+ *        the ticks of a RangeDimension.
+ *
+ * Other than axis(), a view does not store the positions: positions of
+ * sampled dimensions are computed on access, ticks of range dimensions are
+ * read in pages of {@link page_size} ticks when they are first accessed.
+ * Only the last page is kept in memory, so accessing the view in order
+ * reads every tick once.
+ *
+ * ~~~
+ * SampledDimension time = array.getDimension(1);
+ * AxisView axis = time.axisView(array.dataExtent()[0]);
+ * for (double t : axis) {
+ *     ...
+ * }
+ * ~~~
+ *
+ * Offset and sampling interval of a sampled dimension are read when the view
+ * is created. Copies of a view share the page, therefore a view and its
+ * copies must not be used from several threads at the same time.
+ */
+class NIXAPI AxisView {
+
+public:
+
+    /**
+     * @brief Random access iterator over the positions of a view.
+     *
+     * Positions are computed or read on access, so the iterator returns
+     * them by value and has no pointer type, like other proxy iterators.
+     */
+    class const_iterator {
+
+    public:
+
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef double                          value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef void                            pointer;
+        typedef double                          reference;
+
+        const_iterator() : view(nullptr), index(0) { }
+
+        const_iterator(const AxisView *view, size_t index) : view(view), index(index) { }
+
+        double operator*() const { return (*view)[index]; }
+
+        double operator[](difference_type n) const { return (*view)[index + n]; }
+
+        const_iterator &operator++() { ++index; return *this; }
+
+        const_iterator operator++(int) { const_iterator tmp(*this); ++index; return tmp; }
+
+        const_iterator &operator--() { --index; return *this; }
+
+        const_iterator operator--(int) { const_iterator tmp(*this); --index; return tmp; }
+
+        const_iterator &operator+=(difference_type n) { index += n; return *this; }
+
+        const_iterator &operator-=(difference_type n) { index -= n; return *this; }
+
+        const_iterator operator+(difference_type n) const { return const_iterator(view, index + n); }
+
+        friend const_iterator operator+(difference_type n, const const_iterator &it) { return it + n; }
+
+        const_iterator operator-(difference_type n) const { return const_iterator(view, index - n); }
+
+        difference_type operator-(const const_iterator &other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const const_iterator &other) const { return index == other.index; }
+
+        bool operator!=(const const_iterator &other) const { return index != other.index; }
+
+        bool operator<(const const_iterator &other) const { return index < other.index; }
+
+        bool operator>(const const_iterator &other) const { return index > other.index; }
+
+        bool operator<=(const const_iterator &other) const { return index <= other.index; }
+
+        bool operator>=(const const_iterator &other) const { return index >= other.index; }
+
+    private:
+
+        const AxisView *view;
+        size_t index;
+    };
+
+    typedef double         value_type;
+    typedef size_t         size_type;
+    typedef const_iterator iterator;
+
+    /**
+     * @brief Number of ticks that are read at once from range dimensions.
+     */
+    static const size_t page_size = 4096;
+
+    /**
+     * @brief Constructor that creates an empty view.
+     */
+    AxisView();
+
+    /**
+     * @brief Constructor for a view on the positions of a sampled dimension.
+     *
+     * @param offset        The offset of the dimension.
+     * @param interval      The sampling interval of the dimension.
+     * @param start         The index of the first position.
+     * @param count         The number of positions.
+     */
+    AxisView(double offset, double interval, size_t start, size_t count);
+
+    /**
+     * @brief Constructor for a view on the ticks of a range dimension.
+     *
+     * @param range         The back-end of the range dimension.
+     * @param start         The index of the first tick.
+     * @param count         The number of ticks.
+     */
+    AxisView(const std::shared_ptr<base::IRangeDimension> &range, size_t start, size_t count);
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     * @brief Get a position of the view without checking the index.
+     */
+    double operator[](size_t index) const {
+        if (!range) {
+            return (index + start) * interval + offset;
+        }
+        return tick(index);
+    }
+
+    /**
+     * @brief Get a position of the view.
+     *
+     * Throws nix::OutOfBounds if the index is not smaller than size().
+     */
+    double at(size_t index) const;
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, count);
+    }
+
+    /**
+     * @brief Copy all positions of the view into a vector.
+     */
+    std::vector<double> toVector() const;
+
+private:
+
+    struct Page {
+        size_t start;
+        std::vector<double> ticks;
+    };
+
+    double offset, interval;
+    size_t start, count;
+    std::shared_ptr<base::IRangeDimension> range;
+    std::shared_ptr<Page> page;
+
+    double tick(size_t index) const;
+};
+
+} // namespace nix
+
+#endif // NIX_AXIS_VIEW_H
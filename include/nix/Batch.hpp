@@ -0,0 +1,113 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BATCH_H
+#define NIX_BATCH_H
+
+#include <nix/base/IFile.hpp>
+#include <nix/Exception.hpp>
+#include <nix/Platform.hpp>
+
+#include <memory>
+
+namespace nix {
+
+/**
+ * @brief Scope object for a batch (edit session) on a {@link nix::File}.
+ *
+ * A batch is started with {@link nix::File::beginBatch} and ends with
+ * {@link commit}. Within a batch the back-end may keep in-memory indices
+ * for duplicate name checks and share timestamps between entities. This
+ * makes the creation of large numbers of entities (e.g. when importing
+ * metadata) considerably faster. Batches may be nested; only the commit
+ * of the outermost batch flushes the file.
+ *
+ * ~~~
+ * File f = File::open("import.h5", FileMode::Overwrite);
+ * Batch batch = f.beginBatch();
+ * Section s = f.createSection("recording", "nix.recording");
+ * for (...) {
+ *     s.createProperty(name, value);
+ * }
+ * batch.commit(); // the file is flushed here
+ * ~~~
+ *
+ * A batch that is destroyed without a commit is abandoned: its indices
+ * are dropped but the changes made within it are not rolled back, they
+ * are written by the next flush or when the file is closed.
+ *
+ * Entities must not be modified through a different File object of the
+ * same file while a batch is active.
+ */
+class NIXAPI Batch {
+
+public:
+
+    /**
+     * @brief Constructor that creates an inactive batch.
+     */
+    Batch() {}
+
+    /**
+     * @brief Starts a new batch on the given file.
+     *
+     * This constructor should only be used by {@link nix::File::beginBatch}.
+     *
+     * @param file      The file the batch operates on.
+     */
+    explicit Batch(const std::shared_ptr<base::IFile> &file);
+
+    /**
+     * @brief Move constructor, the other batch becomes inactive.
+     */
+    Batch(Batch &&other);
+
+    /**
+     * @brief Move assignment, abandons this batch if it is active.
+     */
+    Batch &operator=(Batch &&other);
+
+    Batch(const Batch &other) = delete;
+
+    Batch &operator=(const Batch &other) = delete;
+
+    /**
+     * @brief Check if the batch is still active.
+     *
+     * @return True if the batch was neither committed nor moved from.
+     */
+    bool isActive() const {
+        return file != nullptr;
+    }
+
+    /**
+     * @brief Ends the batch and flushes the file.
+     *
+     * The batch is inactive afterwards, also if the flush fails.
+     * Calling commit on an inactive batch has no effect.
+     *
+     * @throws H5Exception or std::runtime_error if the changes could not
+     *         be written.
+     */
+    void commit();
+
+    /**
+     * @brief Destructor, abandons the batch if it was not committed.
+     */
+    ~Batch();
+
+private:
+
+    void abandon();
+
+    std::shared_ptr<base::IFile> file;
+};
+
+} // namespace nix
+
+#endif // NIX_BATCH_H
@@ -16,6 +16,7 @@
 #include <nix/MultiTag.hpp>
 #include <nix/Tag.hpp>
 #include <nix/Group.hpp>
+#include <nix/util/query.hpp>
 #include <nix/Platform.hpp>
 
 #include <string>
@@ -199,6 +200,18 @@ public:
      */
     std::vector<Source> sources(const util::Filter<Source>::type &filter = util::AcceptAll<Source>()) const;
 
+    /**
+     * @brief Get all root sources that match a query.
+     *
+     * Other than the filter, the query is evaluated by the back-end on the
+     * stored attributes, so that only matching root sources are loaded.
+     *
+     * @param query     The query, see {@link nix::util::Query}.
+     *
+     * @return A vector containing the matching root sources.
+     */
+    std::vector<Source> sources(const util::Query &query) const;
+
     /**
      * @brief Get all sources in this block recursively.
      *
@@ -312,6 +325,18 @@ public:
     std::vector<DataArray> dataArrays(const util::AcceptAll<DataArray>::type &filter
                                       = util::AcceptAll<DataArray>()) const;
 
+    /**
+     * @brief Get all data arrays that match a query.
+     *
+     * Other than the filter, the query is evaluated by the back-end on the
+     * stored attributes, so that only matching data arrays are loaded.
+     *
+     * @param query     The query, see {@link nix::util::Query}.
+     *
+     * @return A vector containing the matching data arrays.
+     */
+    std::vector<DataArray> dataArrays(const util::Query &query) const;
+
     /**
      * @brief Returns the number of all data arrays of the block.
      *
@@ -455,6 +480,18 @@ public:
     std::vector<Tag> tags(const util::Filter<Tag>::type &filter
                           = util::AcceptAll<Tag>()) const;
 
+    /**
+     * @brief Get all tags that match a query.
+     *
+     * Other than the filter, the query is evaluated by the back-end on the
+     * stored attributes, so that only matching tags are loaded.
+     *
+     * @param query     The query, see {@link nix::util::Query}.
+     *
+     * @return A vector containing the matching tags.
+     */
+    std::vector<Tag> tags(const util::Query &query) const;
+
     /**
      * @brief Returns the number of tags within this block.
      *
@@ -560,6 +597,18 @@ public:
     std::vector<MultiTag> multiTags(const util::AcceptAll<MultiTag>::type &filter
                                   = util::AcceptAll<MultiTag>()) const;
 
+    /**
+     * @brief Get all multi tags that match a query.
+     *
+     * Other than the filter, the query is evaluated by the back-end on the
+     * stored attributes, so that only matching multi tags are loaded.
+     *
+     * @param query     The query, see {@link nix::util::Query}.
+     *
+     * @return A vector containing the matching multi tags.
+     */
+    std::vector<MultiTag> multiTags(const util::Query &query) const;
+
     /**
      * @brief Returns the number of multi tags associated with this block.
      *
@@ -666,6 +715,18 @@ public:
     std::vector<Group> groups(const util::AcceptAll<Group>::type &filter
     = util::AcceptAll<Group>()) const;
 
+    /**
+     * @brief Get all groups that match a query.
+     *
+     * Other than the filter, the query is evaluated by the back-end on the
+     * stored attributes, so that only matching groups are loaded.
+     *
+     * @param query     The query, see {@link nix::util::Query}.
+     *
+     * @return A vector containing the matching groups.
+     */
+    std::vector<Group> groups(const util::Query &query) const;
+
     /**
      * @brief Returns the number of groups associated with this block.
      *
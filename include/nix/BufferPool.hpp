@@ -0,0 +1,183 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BUFFER_POOL_H
+#define NIX_BUFFER_POOL_H
+
+#include <nix/Platform.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace nix {
+
+/**
+ * @brief Allocator for memory aligned to Alignment bytes, e.g. for
+ *        buffers that are processed with SIMD instructions.
+ */
+template<typename T, size_t Alignment>
+struct aligned_allocator {
+
+    static_assert(Alignment > 0 && Alignment <= 128 && (Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two of at most 128");
+
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind {
+        typedef aligned_allocator<U, Alignment> other;
+    };
+
+    aligned_allocator() { }
+
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment> &) { }
+
+    T *allocate(size_t n) {
+        if (n > (static_cast<size_t>(-1) - Alignment) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        // the distance to the start of the allocated block is stored in the
+        // byte before the aligned memory, it is between 1 and Alignment
+        unsigned char *raw = static_cast<unsigned char *>(::operator new(n * sizeof(T) + Alignment));
+        size_t shift = Alignment - reinterpret_cast<uintptr_t>(raw) % Alignment;
+        unsigned char *aligned = raw + shift;
+        aligned[-1] = static_cast<unsigned char>(shift);
+        return reinterpret_cast<T *>(aligned);
+    }
+
+    void deallocate(T *p, size_t) {
+        unsigned char *aligned = reinterpret_cast<unsigned char *>(p);
+        ::operator delete(aligned - aligned[-1]);
+    }
+};
+
+
+template<typename T, typename U, size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment> &, const aligned_allocator<U, Alignment> &) {
+    return true;
+}
+
+
+template<typename T, typename U, size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment> &, const aligned_allocator<U, Alignment> &) {
+    return false;
+}
+
+
+/**
+ * @brief Cache of memory blocks for buffers that are allocated and freed
+ *        over and over, e.g. for reading the same slab of data in a loop.
+ *
+ * Blocks are grouped in size classes of powers of two and are aligned to
+ * {@link alignment} bytes. Freed blocks are kept in free lists of the
+ * thread that freed them, so acquiring and releasing does not lock. The
+ * total size of the cached blocks of all threads is limited, blocks that
+ * would exceed the limit are freed immediately. The lists of a thread are
+ * freed when it exits.
+ */
+class NIXAPI BufferPool {
+
+public:
+
+    static const size_t alignment = 64;
+
+    /**
+     * @brief Get a block of at least the given size, the content is
+     *        not initialized.
+     */
+    static void *acquire(size_t bytes);
+
+    /**
+     * @brief Give a block back to the pool.
+     *
+     * @param block     The block from acquire().
+     * @param bytes     The size that was passed to acquire().
+     */
+    static void release(void *block, size_t bytes);
+
+    /**
+     * @brief Set the maximum number of bytes that are cached by all
+     *        threads together, 0 disables caching.
+     */
+    static void limit(size_t bytes);
+
+    static size_t limit();
+
+    /**
+     * @brief Get the number of bytes that are cached by all threads.
+     */
+    static size_t cached();
+
+    /**
+     * @brief Free all blocks that are cached by the calling thread.
+     */
+    static void trim();
+};
+
+
+/**
+ * @brief Allocator that takes memory from the BufferPool.
+ *
+ * Elements that are constructed without arguments are default initialized,
+ * so that e.g. resizing a vector of numbers does not fill it with zeros.
+ */
+template<typename T>
+struct pool_allocator {
+
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind {
+        typedef pool_allocator<U> other;
+    };
+
+    pool_allocator() { }
+
+    template<typename U>
+    pool_allocator(const pool_allocator<U> &) { }
+
+    T *allocate(size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(BufferPool::acquire(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t n) {
+        BufferPool::release(p, n * sizeof(T));
+    }
+
+    template<typename U>
+    void construct(U *p) {
+        ::new (static_cast<void *>(p)) U;
+    }
+
+    template<typename U, typename... Args>
+    void construct(U *p, Args&&... args) {
+        ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+
+template<typename T, typename U>
+bool operator==(const pool_allocator<T> &, const pool_allocator<U> &) {
+    return true;
+}
+
+
+template<typename T, typename U>
+bool operator!=(const pool_allocator<T> &, const pool_allocator<U> &) {
+    return false;
+}
+
+} // namespace nix
+
+#endif // NIX_BUFFER_POOL_H
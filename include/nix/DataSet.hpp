@@ -14,9 +14,12 @@
 
 #include <nix/Dimensions.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/NDArrayView.hpp>
 
 #include <nix/Platform.hpp>
 
+#include <vector>
+
 namespace nix {
 
 class NIXAPI DataSet {
@@ -31,6 +34,14 @@ public:
 
     template<typename T> void setData(const T &value, const NDSize &offset);
 
+    template<typename T> void getData(NDArrayView<T> &view, const NDSize &offset) const;
+
+    template<typename T> void getData(NDArrayView<T> &&view, const NDSize &offset) const {
+        getData(view, offset);
+    }
+
+    template<typename T> void setData(const NDArrayView<T> &view, const NDSize &offset);
+
 
     void getData(DataType dtype,
                          void *data,
@@ -126,6 +137,39 @@ void DataSet::setData(const T &value, const NDSize &offset)
     setData(dtype, hydra.data(), shape, offset);
 }
 
+
+template<typename T>
+void DataSet::getData(NDArrayView<T> &view, const NDSize &offset) const
+{
+    DataType dtype = to_data_type<T>::value;
+    NDSize count = view.shape();
+
+    if (view.isContiguous()) {
+        getData(dtype, view.data(), count, offset);
+    } else {
+        std::vector<T> buffer(check::fits_in_size_t(view.num_elements(), "Cannot read view: too big for memory"));
+        getData(dtype, buffer.data(), count, offset);
+        view.copyFrom(buffer.data());
+    }
+}
+
+
+template<typename T>
+void DataSet::setData(const NDArrayView<T> &view, const NDSize &offset)
+{
+    typedef typename std::remove_const<T>::type element_t;
+    DataType dtype = to_data_type<element_t>::value;
+    NDSize count = view.shape();
+
+    if (view.isContiguous()) {
+        setData(dtype, view.data(), count, offset);
+    } else {
+        std::vector<element_t> buffer(check::fits_in_size_t(view.num_elements(), "Cannot write view: too big for memory"));
+        view.copyTo(buffer.data());
+        setData(dtype, buffer.data(), count, offset);
+    }
+}
+
 }
 
 #endif
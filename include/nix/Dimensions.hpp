@@ -11,6 +11,7 @@
 
 #include <nix/base/ImplContainer.hpp>
 #include <nix/base/IDimensions.hpp>
+#include <nix/AxisView.hpp>
 
 namespace nix {
 class DataArray;
@@ -260,6 +261,19 @@ public:
      */
     std::vector<double> axis(const size_t count, const size_t startIndex = 0) const;
 
+    /**
+     * @brief Returns a view on the positions defined by this dimension.
+     *
+     * The positions are computed when they are accessed, other than with
+     * {@link axis} no memory is allocated for them.
+     *
+     * @param count        The number of indices
+     * @param startIndex   The start index, default = 0
+     *
+     * @returns A view on the respective positions.
+     */
+    AxisView axisView(const size_t count, const size_t startIndex = 0) const;
+
     /**
      * @brief Assignment operator.
      *
@@ -632,6 +646,27 @@ public:
      * @return The index.
      */
     size_t indexOf(const double position) const;
+
+    /**
+     * @brief Returns the indices of several positions.
+     *
+     * Other than calling {@link indexOf} for each position, the ticks
+     * are searched only once for all positions.
+     *
+     * @param positions   The positions.
+     *
+     * @return The index of each position.
+     */
+    std::vector<size_t> indexOf(const std::vector<double> &positions) const;
+
+    /**
+     * @brief Get the number of ticks.
+     *
+     * @return The number of ticks.
+     */
+    ndsize_t tickCount() const {
+        return backend()->tickCount();
+    }
     
     /**
      * @brief Returns a vector containing a number of ticks
@@ -649,6 +684,22 @@ public:
      */
     std::vector<double> axis(const size_t count, const size_t startIndex = 0) const;
 
+    /**
+     * @brief Returns a view on a number of ticks.
+     *
+     * Ticks are read in pages when they are accessed, other than with
+     * {@link axis} they are not all loaded at once.
+     *
+     * @param count       The number of ticks.
+     * @param startIndex  The starting index. Default 0.
+     *
+     * @return A view on the ticks.
+     *
+     * Method will throw a nix::OutOfBounds exception if startIndex + count is beyond
+     * the number of ticks.
+     */
+    AxisView axisView(const size_t count, const size_t startIndex = 0) const;
+
     /**
      * @brief Assignment operator.
      *
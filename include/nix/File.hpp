@@ -13,6 +13,9 @@
 #include <nix/base/IFile.hpp>
 #include <nix/Block.hpp>
 #include <nix/Section.hpp>
+#include <nix/Batch.hpp>
+#include <nix/MetadataSnapshot.hpp>
+#include <nix/StorageOptions.hpp>
 #include <nix/Platform.hpp>
 
 #include <nix/valid/validate.hpp>
@@ -186,6 +189,18 @@ public:
      */
     std::vector<Block> blocks(const util::Filter<Block>::type &filter) const;
 
+    /**
+     * @brief Get all blocks that match a query.
+     *
+     * Other than the filter, the query is evaluated by the back-end on the
+     * stored attributes, so that only matching blocks are loaded.
+     *
+     * @param query     The query, see {@link nix::util::Query}.
+     *
+     * @return A vector containing the matching blocks.
+     */
+    std::vector<Block> blocks(const util::Query &query) const;
+
     /**
      * @brief Get all blocks within this file.
      *
@@ -269,6 +284,18 @@ public:
      * @return A vector of filtered Section entities.
      */
     std::vector<Section> sections(const util::Filter<Section>::type &filter) const;
+
+    /**
+     * @brief Get all root sections that match a query.
+     *
+     * Other than the filter, the query is evaluated by the back-end on the
+     * stored attributes, so that only matching root sections are loaded.
+     *
+     * @param query     The query, see {@link nix::util::Query}.
+     *
+     * @return A vector containing the matching root sections.
+     */
+    std::vector<Section> sections(const util::Query &query) const;
     
 
     /**
@@ -435,10 +462,63 @@ public:
         backend()->forceCreatedAt(t);
     }
 
+    //------------------------------------------------------
+    // Batch operations
+    //------------------------------------------------------
+
+    /**
+     * @brief Start a batch (edit session) on the file.
+     *
+     * Until the returned {@link nix::Batch} is committed, duplicate name
+     * checks for new sections and properties are answered from in-memory
+     * indices and timestamps are shared; the file is flushed once by the
+     * commit. Use this when creating large numbers of entities.
+     *
+     * @return The scope object of the batch.
+     */
+    Batch beginBatch();
+
+    //------------------------------------------------------
+    // Metadata snapshot
+    //------------------------------------------------------
+
+    /**
+     * @brief Read the whole metadata tree of the file into memory.
+     *
+     * Queries on the sections of the returned {@link nix::MetadataSnapshot}
+     * are answered from memory. The snapshot becomes invalid as soon as the
+     * file is modified.
+     *
+     * @return The snapshot of the metadata.
+     */
+    MetadataSnapshot metadataSnapshot() const;
+
     //------------------------------------------------------
     // Operators and other functions
     //------------------------------------------------------
 
+    /**
+     * @brief Write all pending changes to the storage.
+     *
+     * Back-ends may delay writes, e.g. the filesystem back-end keeps changed
+     * attributes of entities in memory until they are no longer used.
+     */
+    void flush();
+
+    /**
+     * @brief Write a copy of the file with all data laid out anew.
+     *
+     * All groups, entities and attributes are copied unchanged, numeric
+     * data is rewritten according to the options in bounded slabs. The
+     * copy does not contain the space that was freed by deleting entities
+     * or values. An existing file at path is replaced.
+     *
+     * @param path      The path of the copy; must differ from the location
+     *                  of this file.
+     * @param options   The storage options of the copy.
+     */
+    void repack(const std::string &path, const StorageOptions &options = StorageOptions()) const;
+
     /**
      * @brief Close the file.
      */
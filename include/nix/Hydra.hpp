@@ -15,6 +15,8 @@
 #include <type_traits>
 #include <limits>
 #include <valarray>
+#include <array>
+#include <utility>
 
 #ifndef NIX_HYDRA_H
 #define NIX_HYDRA_H
@@ -236,6 +238,91 @@ public:
     }
 };
 
+template<typename T, size_t N>
+class data_traits<std::array<T, N>> {
+public:
+
+    typedef std::array<T, N>     value_type;
+    typedef value_type&          reference;
+    typedef const value_type&    const_reference;
+
+    typedef T        element_type;
+    typedef T*       element_pointer;
+    typedef const T* const_element_pointer;
+
+    static DataType data_type(const_reference val) {
+        return to_data_type<element_type>::value;
+    }
+
+    static NDSize shape(const_reference value) {
+        return NDSize{N};
+    }
+
+    static size_t num_elements(const_reference value) {
+        return N;
+    }
+
+    static const_element_pointer get_data(const_reference value) {
+        return value.data();
+    }
+
+    static element_pointer get_data(reference value) {
+        return value.data();
+    }
+
+    static void resize(reference value, const NDSize &dims) {
+        if (dims.nelms() != N) {
+            throw InvalidRank("Cannot resize std::array");
+        }
+        //NOOP
+    }
+};
+
+/**
+ * Memory owned by the caller, given as pointer and shape, e.g.
+ * std::make_pair(buffer.data() + offset, NDSize{100, 4}). The shape
+ * can be changed to another one with the same number of elements.
+ */
+template<typename T>
+class data_traits<std::pair<T*, NDSize>> {
+public:
+
+    typedef std::pair<T*, NDSize> value_type;
+    typedef value_type&           reference;
+    typedef const value_type&     const_reference;
+
+    typedef typename std::remove_const<T>::type element_type;
+    typedef T*       element_pointer;
+    typedef const T* const_element_pointer;
+
+    static DataType data_type(const_reference val) {
+        return to_data_type<element_type>::value;
+    }
+
+    static NDSize shape(const_reference value) {
+        return value.second;
+    }
+
+    static ndsize_t num_elements(const_reference value) {
+        return value.second.nelms();
+    }
+
+    static const_element_pointer get_data(const_reference value) {
+        return value.first;
+    }
+
+    static element_pointer get_data(reference value) {
+        return value.first;
+    }
+
+    static void resize(reference value, const NDSize &dims) {
+        if (dims.nelms() != value.second.nelms()) {
+            throw InvalidRank("Cannot resize memory of the caller");
+        }
+        value.second = dims;
+    }
+};
+
 /* *** */
 
 template<typename T>
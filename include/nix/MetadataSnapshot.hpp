@@ -0,0 +1,134 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_METADATA_SNAPSHOT_H
+#define NIX_METADATA_SNAPSHOT_H
+
+#include <nix/base/IFile.hpp>
+#include <nix/Section.hpp>
+#include <nix/Platform.hpp>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nix {
+
+namespace snapshot {
+struct Tree;
+}
+
+/**
+ * @brief Read-only in-memory copy of the metadata tree of a {@link nix::File}.
+ *
+ * A snapshot is created with {@link nix::File::metadataSnapshot}. It reads all
+ * sections and properties of the file (names, types, ids, links and values)
+ * in a single pass and keeps them in memory. The sections returned by the
+ * snapshot are backed by this copy, so queries such as
+ * {@link nix::Section::findSections}, {@link nix::Section::findRelated} or
+ * {@link nix::Section::inheritedProperties} run without accessing the file.
+ *
+ * ~~~
+ * MetadataSnapshot snap = file.metadataSnapshot();
+ * for (const Section &s : snap.findSections(util::TypeFilter<Section>("nix.trial"))) {
+ *     std::vector<Section> rel = s.findRelated(util::TypeFilter<Section>("nix.subject"));
+ *     ...
+ * }
+ * ~~~
+ *
+ * Sections and properties of a snapshot can not be modified. Any change made
+ * to the file after the snapshot was taken invalidates it: all further
+ * queries on the snapshot or on entities obtained from it throw a
+ * std::runtime_error and a new snapshot has to be created.
+ */
+class NIXAPI MetadataSnapshot {
+
+public:
+
+    /**
+     * @brief Constructor that creates an empty snapshot.
+     */
+    MetadataSnapshot() {}
+
+    /**
+     * @brief Reads the metadata tree of the given file.
+     *
+     * This constructor should only be used by {@link nix::File::metadataSnapshot}.
+     *
+     * @param file      The file to read the metadata from.
+     */
+    explicit MetadataSnapshot(const std::shared_ptr<base::IFile> &file);
+
+    /**
+     * @brief Check if the snapshot still reflects the content of the file.
+     *
+     * @return False if the snapshot is empty or the file was modified
+     *         after the snapshot was taken.
+     */
+    bool isCurrent() const;
+
+    /**
+     * @brief The number of sections in the snapshot, including all
+     *        sub-sections.
+     *
+     * @return The number of sections.
+     */
+    ndsize_t sectionCount() const;
+
+    /**
+     * @brief The number of properties in the snapshot.
+     *
+     * @return The number of properties.
+     */
+    ndsize_t propertyCount() const;
+
+    /**
+     * @brief Get the root sections of the file.
+     *
+     * @param filter    A filter function.
+     *
+     * @return A vector of filtered root sections.
+     */
+    std::vector<Section> sections(const util::Filter<Section>::type &filter = util::AcceptAll<Section>()) const;
+
+    /**
+     * @brief Get a section of any depth by its id.
+     *
+     * Other than {@link nix::File::findSections} with an IdFilter this
+     * is a single lookup in a hash table.
+     *
+     * @param id        The id of the section.
+     *
+     * @return The section or an uninitialized section if there is none.
+     */
+    Section getSection(const std::string &id) const;
+
+    /**
+     * @brief Get all sections of the snapshot recursively.
+     *
+     * Behaves like {@link nix::File::findSections}.
+     *
+     * @param filter       A filter function.
+     * @param max_depth    The maximum depth of traversal.
+     *
+     * @return A vector containing the matching sections.
+     */
+    std::vector<Section> findSections(const util::Filter<Section>::type &filter = util::AcceptAll<Section>(),
+                                      size_t max_depth = std::numeric_limits<size_t>::max()) const;
+
+private:
+
+    std::shared_ptr<const snapshot::Tree> tree;
+
+    const snapshot::Tree &current() const;
+};
+
+} // namespace nix
+
+#endif // NIX_METADATA_SNAPSHOT_H
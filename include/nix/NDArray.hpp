@@ -13,6 +13,8 @@
 
 #include <nix/Hydra.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/NDArrayView.hpp>
+#include <nix/BufferPool.hpp>
 #include <nix/Platform.hpp>
 
 #include <vector>
@@ -27,8 +29,28 @@ public:
 
     typedef uint8_t byte_type;
 
+    /**
+     * @brief Alignment of the data in bytes.
+     */
+    static const size_t alignment = BufferPool::alignment;
+
+    /**
+     * @brief Initialization of new elements.
+     *
+     * Uninitialized elements must be written before they are read, e.g.
+     * by reading data into the array.
+     */
+    enum class Init : int {
+        Zero, Uninitialized
+    };
+
     NDArray(DataType dtype, NDSize dims);
 
+    /**
+     * @brief Constructor, the storage is taken from the BufferPool.
+     */
+    NDArray(DataType dtype, NDSize dims, Init init);
+
     size_t rank() const { return extends.size(); }
     ndsize_t num_elements() const { return extends.nelms(); }
     NDSize  shape() const { return extends; }
@@ -43,19 +65,35 @@ public:
     byte_type *data() { return dstore.data(); }
     const byte_type *data() const { return dstore.data(); }
 
-    void resize(const NDSize &new_size);
+    /**
+     * @brief Change the shape, the capacity is reused if it is large enough.
+     */
+    void resize(const NDSize &new_size, Init init = Init::Zero);
+
+    /**
+     * @brief The number of bytes the array can hold without a new allocation.
+     */
+    size_t capacity() const { return dstore.capacity(); }
 
     size_t sub2index(const NDSize &sub) const;
 
+    /**
+     * @brief Typed view on all elements, T must match the data type.
+     */
+    template<typename T> NDArrayView<T> view();
+    template<typename T> NDArrayView<const T> view() const;
+
 private:
 
     DataType  dataType;
-    void allocate_space();
+    void allocate_space(Init init);
     void calc_strides();
 
+    void check_view_type(DataType dtype) const;
+
     NDSize                  extends;
     NDSize                  strides;
-    std::vector<byte_type> dstore;
+    std::vector<byte_type, pool_allocator<byte_type>> dstore;
 
 };
 
@@ -94,6 +132,22 @@ void NDArray::set(const NDSize &index, T value)
     set(pos, value);
 }
 
+
+template<typename T>
+NDArrayView<T> NDArray::view()
+{
+    check_view_type(to_data_type<T>::value);
+    return NDArrayView<T>(reinterpret_cast<T *>(dstore.data()), extends, strides);
+}
+
+
+template<typename T>
+NDArrayView<const T> NDArray::view() const
+{
+    check_view_type(to_data_type<T>::value);
+    return NDArrayView<const T>(reinterpret_cast<const T *>(dstore.data()), extends, strides);
+}
+
 /* ****************************************** */
 
 template<>
@@ -128,7 +182,8 @@ struct data_traits<NDArray> {
     }
 
     static void resize(reference value, const NDSize &dims) {
-        value.resize(dims);
+        // the data is read into the array right after
+        value.resize(dims, NDArray::Init::Uninitialized);
     }
 
 };
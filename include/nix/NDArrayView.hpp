@@ -0,0 +1,349 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_NDARRAY_VIEW_H
+#define NIX_NDARRAY_VIEW_H
+
+#include <nix/Hydra.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Exception.hpp>
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace nix {
+
+/**
+ * @brief Typed view with strides on memory owned by someone else, e.g.
+ *        an NDArray or a std::vector.
+ *
+ * Slicing, sub-blocks and transposition create new views on the same
+ * memory and never copy. Strides are given in elements, a view without
+ * explicit strides is contiguous in row major order.
+ *
+ * ~~~
+ * NDArray array(DataType::Double, {100, 8});
+ * NDArrayView<double> channel = array.view<double>().slice(1, 3, 1);
+ * data_array.getData(channel, {0, 3});
+ * ~~~
+ *
+ * Views can be passed to getData and setData like other containers. Data
+ * is read into and written from contiguous views directly, other views go
+ * through a temporary buffer.
+ */
+template<typename T>
+class NDArrayView {
+
+public:
+
+    typedef T         value_type;
+    typedef T        *pointer;
+    typedef T        &reference;
+
+    NDArrayView()
+        : ptr(nullptr)
+    {
+    }
+
+    /**
+     * @brief Contiguous view in row major order.
+     */
+    NDArrayView(T *data, const NDSize &shape)
+        : ptr(data), extent(shape), stride(row_major(shape))
+    {
+    }
+
+    /**
+     * @brief View with arbitrary strides, given in elements.
+     */
+    NDArrayView(T *data, const NDSize &shape, const NDSize &strides)
+        : ptr(data), extent(shape), stride(strides)
+    {
+        if (shape.size() != strides.size()) {
+            throw IncompatibleDimensions("Shape and strides must have the same rank", "NDArrayView");
+        }
+    }
+
+    /**
+     * @brief A view on const elements from a view on mutable elements.
+     */
+    template<typename U, typename = typename std::enable_if<std::is_same<const U, T>::value &&
+                                                            !std::is_same<U, T>::value>::type>
+    NDArrayView(const NDArrayView<U> &other)
+        : ptr(other.data()), extent(other.shape()), stride(other.strides())
+    {
+    }
+
+    size_t rank() const { return extent.size(); }
+
+    ndsize_t num_elements() const { return extent.nelms(); }
+
+    const NDSize &shape() const { return extent; }
+
+    const NDSize &strides() const { return stride; }
+
+    T *data() const { return ptr; }
+
+    /**
+     * @brief Check if the elements are stored without gaps in row
+     *        major order, i.e. if the view can be used as plain buffer.
+     */
+    bool isContiguous() const {
+        ndsize_t expected = 1;
+        for (size_t i = extent.size(); i > 0; --i) {
+            if (extent[i - 1] != 1 && stride[i - 1] != expected) {
+                return false;
+            }
+            expected *= extent[i - 1];
+        }
+        return true;
+    }
+
+    /**
+     * @brief Access an element without checking the index.
+     */
+    T &operator()(const NDSize &index) const {
+        return ptr[stride.dot(index)];
+    }
+
+    template<typename... Index>
+    T &operator()(Index... index) const {
+        static_assert(sizeof...(Index) > 0, "NDArrayView: index required");
+        const ndsize_t idx[] = {static_cast<ndsize_t>(index)...};
+        ndsize_t pos = 0;
+        for (size_t i = 0; i < sizeof...(Index); i++) {
+            pos += idx[i] * stride[i];
+        }
+        return ptr[pos];
+    }
+
+    /**
+     * @brief Access an element, throws OutOfBounds for invalid indices.
+     */
+    T &at(const NDSize &index) const {
+        if (index.size() != extent.size()) {
+            throw IncompatibleDimensions("Index must have the rank of the view", "NDArrayView::at");
+        }
+        for (size_t i = 0; i < index.size(); i++) {
+            if (index[i] >= extent[i]) {
+                throw OutOfBounds("NDArrayView::at: Index out of bounds", index[i]);
+            }
+        }
+        return (*this)(index);
+    }
+
+    /**
+     * @brief View on a range of one dimension.
+     *
+     * @param dim       The dimension.
+     * @param start     The first index in the dimension.
+     * @param count     The number of indices.
+     */
+    NDArrayView slice(size_t dim, ndsize_t start, ndsize_t count) const {
+        if (dim >= extent.size()) {
+            throw OutOfBounds("NDArrayView::slice: Dimension out of bounds", dim);
+        }
+        if (start + count > extent[dim]) {
+            throw OutOfBounds("NDArrayView::slice: Slice out of bounds", start + count);
+        }
+        NDSize shape(extent);
+        shape[dim] = count;
+        return NDArrayView(ptr + start * stride[dim], shape, stride);
+    }
+
+    /**
+     * @brief View on a block of all dimensions.
+     *
+     * @param offset    The first index in every dimension.
+     * @param count     The number of indices in every dimension.
+     */
+    NDArrayView subBlock(const NDSize &offset, const NDSize &count) const {
+        if (offset.size() != extent.size() || count.size() != extent.size()) {
+            throw IncompatibleDimensions("Offset and count must have the rank of the view", "NDArrayView::subBlock");
+        }
+        if (offset + count > extent) {
+            throw OutOfBounds("NDArrayView::subBlock: Block out of bounds");
+        }
+        return NDArrayView(ptr + stride.dot(offset), count, stride);
+    }
+
+    /**
+     * @brief View with the order of the dimensions reversed.
+     */
+    NDArrayView transpose() const {
+        size_t n = extent.size();
+        NDSize shape(n), strides(n);
+        for (size_t i = 0; i < n; i++) {
+            shape[i] = extent[n - 1 - i];
+            strides[i] = stride[n - 1 - i];
+        }
+        return NDArrayView(ptr, shape, strides);
+    }
+
+    /**
+     * @brief View with two dimensions exchanged.
+     */
+    NDArrayView swapAxes(size_t a, size_t b) const {
+        if (a >= extent.size() || b >= extent.size()) {
+            throw OutOfBounds("NDArrayView::swapAxes: Dimension out of bounds");
+        }
+        NDSize shape(extent), strides(stride);
+        std::swap(shape[a], shape[b]);
+        std::swap(strides[a], strides[b]);
+        return NDArrayView(ptr, shape, strides);
+    }
+
+    /**
+     * @brief Call a function for every element in row major order.
+     */
+    template<typename F>
+    void forEach(F fn) const {
+        if (ptr == nullptr || extent.nelms() == 0) {
+            return;
+        }
+        visit(0, ptr, fn);
+    }
+
+    /**
+     * @brief Copy the elements from a contiguous buffer in row major order.
+     */
+    void copyFrom(const typename std::remove_const<T>::type *source) const {
+        if (isContiguous()) {
+            std::memcpy(ptr, source, static_cast<size_t>(num_elements()) * sizeof(T));
+            return;
+        }
+        forEach([&source](T &value) {
+            value = *source++;
+        });
+    }
+
+    /**
+     * @brief Copy the elements into a contiguous buffer in row major order.
+     */
+    void copyTo(typename std::remove_const<T>::type *dest) const {
+        if (isContiguous()) {
+            std::memcpy(dest, ptr, static_cast<size_t>(num_elements()) * sizeof(T));
+            return;
+        }
+        forEach([&dest](const T &value) {
+            *dest++ = value;
+        });
+    }
+
+private:
+
+    static NDSize row_major(const NDSize &shape) {
+        size_t n = shape.size();
+        NDSize strides(n, 1);
+        for (size_t i = n; i > 1; --i) {
+            strides[i - 2] = strides[i - 1] * shape[i - 1];
+        }
+        return strides;
+    }
+
+    template<typename F>
+    void visit(size_t dim, T *base, F &fn) const {
+        if (dim == extent.size()) {
+            fn(*base);
+            return;
+        }
+
+        const ndsize_t n = extent[dim], step = stride[dim];
+        if (dim + 1 == extent.size()) {
+            for (ndsize_t i = 0; i < n; i++) {
+                fn(base[i * step]);
+            }
+            return;
+        }
+        for (ndsize_t i = 0; i < n; i++) {
+            visit(dim + 1, base + i * step, fn);
+        }
+    }
+
+    T *ptr;
+    NDSize extent;
+    NDSize stride;
+};
+
+
+template<typename T>
+class data_traits<NDArrayView<T>> {
+public:
+
+    typedef NDArrayView<T>     value_type;
+    typedef value_type&        reference;
+    typedef const value_type&  const_reference;
+
+    typedef T        element_type;
+    typedef T*       element_pointer;
+    typedef const T* const_element_pointer;
+
+    static DataType data_type(const_reference value) {
+        return to_data_type<element_type>::value;
+    }
+
+    static NDSize shape(const_reference value) {
+        return value.shape();
+    }
+
+    static ndsize_t num_elements(const_reference value) {
+        return value.num_elements();
+    }
+
+    static const_element_pointer get_data(const_reference value) {
+        check_contiguous(value);
+        return value.data();
+    }
+
+    static element_pointer get_data(reference value) {
+        check_contiguous(value);
+        return value.data();
+    }
+
+    static void resize(reference value, const NDSize &dims) {
+        if (dims != value.shape()) {
+            throw InvalidRank("Cannot resize a view");
+        }
+    }
+
+    static void check_contiguous(const_reference value) {
+        if (!value.isContiguous()) {
+            throw std::invalid_argument("Cannot use a strided view as buffer");
+        }
+    }
+};
+
+
+/**
+ * @brief A view on memory of the caller, e.g. a part of a larger buffer.
+ *
+ * ~~~
+ * std::vector<double> ring(8192);
+ * data_array.getData(make_span(ring.data() + head, {512}), {position});
+ * ~~~
+ */
+template<typename T>
+using span = NDArrayView<T>;
+
+
+template<typename T>
+span<T> make_span(T *data, const NDSize &shape) {
+    return span<T>(data, shape);
+}
+
+
+template<typename T>
+span<T> make_span(T *data, const NDSize &shape, const NDSize &strides) {
+    return span<T>(data, shape, strides);
+}
+
+
+} // namespace nix
+
+#endif // NIX_NDARRAY_VIEW_H
@@ -58,21 +58,26 @@ public:
     typedef size_t   difference_type;
     typedef size_t   size_type;
 
+    /**
+     * @brief The largest rank that is stored without a heap allocation.
+     */
+    static const size_t inline_rank = 6;
+
     NDSizeBase()
-        : rank(0), dims(nullptr)
+        : rank(0), dims(local)
     {
     }
 
 
     explicit NDSizeBase(size_t rank)
-        : rank(rank), dims(nullptr)
+        : rank(rank), dims(local)
     {
         allocate();
     }
 
 
     explicit NDSizeBase(size_t rank, T fill_value)
-        : rank(rank), dims(nullptr)
+        : rank(rank), dims(local)
     {
         allocate();
         fill(fill_value);
@@ -80,7 +85,7 @@ public:
 
     template<typename U>
     NDSizeBase(std::initializer_list<U> args)
-        : rank(args.size())
+        : rank(args.size()), dims(local)
     {
         allocate();
 
@@ -100,7 +105,7 @@ public:
 
     template<typename U>
     NDSizeBase(const std::vector<U> &args)
-        : rank(args.size())
+        : rank(args.size()), dims(local)
     {
         allocate();
 
@@ -119,23 +124,41 @@ public:
 
     //copy
     NDSizeBase(const NDSizeBase &other)
-        : rank(other.rank), dims(nullptr)
+        : rank(other.rank), dims(local)
     {
         allocate();
         nd_copy(other.dims, rank, dims);
     }
 
-    //move (not tested due to: http://llvm.org/bugs/show_bug.cgi?id=12208)
-    NDSizeBase(NDSizeBase &&other)
-        : rank(other.rank), dims(other.dims)
+    //move, leaves other empty
+    NDSizeBase(NDSizeBase &&other) NOEXCEPT
+        : rank(0), dims(local)
     {
-        other.dims = nullptr;
-        other.rank = 0;
+        steal(other);
+    }
+
+    //copy assignment, reuses the storage if it is large enough
+    NDSizeBase& operator=(const NDSizeBase &other) {
+        if (this != &other) {
+            if (other.rank > inline_rank && other.rank != rank) {
+                T *storage = new T[other.rank];
+                release();
+                dims = storage;
+            } else if (other.rank <= inline_rank) {
+                release();
+            }
+            rank = other.rank;
+            nd_copy(other.dims, rank, dims);
+        }
+        return *this;
     }
 
-    //copy and move assignment operator (not tested, see above)
-    NDSizeBase& operator=(NDSizeBase other) {
-        swap(other);
+    //move assignment, leaves other empty
+    NDSizeBase& operator=(NDSizeBase &&other) NOEXCEPT {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
         return *this;
     }
 
@@ -241,10 +264,15 @@ public:
     }
 
 
-    void swap(NDSizeBase &other) {
-        using std::swap;
-        swap(dims, other.dims);
-        rank = other.rank;
+    void swap(NDSizeBase &other) NOEXCEPT {
+        if (on_heap() && other.on_heap()) {
+            std::swap(dims, other.dims);
+            std::swap(rank, other.rank);
+        } else {
+            NDSizeBase tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
     }
 
 
@@ -314,7 +342,7 @@ public:
 
 
     ~NDSizeBase() {
-        delete[] dims;
+        release();
     }
 
 
@@ -335,17 +363,53 @@ public:
 
 private:
 
+    bool on_heap() const {
+        return dims != local;
+    }
+
     void allocate() {
-        if (rank > 0) {
+        if (rank > inline_rank) {
             dims = new T[rank];
         }
     }
 
+    void release() {
+        if (on_heap()) {
+            delete[] dims;
+            dims = local;
+        }
+    }
+
+    // expects that this does not own heap storage
+    void steal(NDSizeBase &other) {
+        rank = other.rank;
+        if (other.on_heap()) {
+            dims = other.dims;
+            other.dims = other.local;
+        } else {
+            nd_copy(other.local, rank, local);
+        }
+        other.rank = 0;
+    }
+
+    // ranks up to inline_rank are stored in local, larger ones on the heap
     size_t   rank;
     T *dims;
+    T  local[inline_rank];
 };
 
 
+template<typename T>
+const size_t NDSizeBase<T>::inline_rank;
+
+
+template<typename T>
+inline void swap(NDSizeBase<T> &lhs, NDSizeBase<T> &rhs) NOEXCEPT
+{
+    lhs.swap(rhs);
+}
+
+
 template<typename T>
 NDSizeBase<T> operator-(NDSizeBase<T> lhs, const NDSizeBase<T> &rhs)
 {
@@ -0,0 +1,26 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_OBJECT_TYPE_H
+#define NIX_OBJECT_TYPE_H
+
+#include <nix/Platform.hpp>
+
+namespace nix {
+
+/**
+ * @brief Enumeration of the entity types that are stored in collections
+ *        of a file or block.
+ */
+enum class ObjectType {
+    Block, Section, Source, DataArray, Tag, MultiTag, Group
+};
+
+} // namespace nix
+
+#endif // NIX_OBJECT_TYPE_H
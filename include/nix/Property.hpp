@@ -12,6 +12,7 @@
 #include <nix/base/Entity.hpp>
 #include <nix/base/IProperty.hpp>
 #include <nix/Value.hpp>
+#include <nix/ValueColumn.hpp>
 
 #include <nix/Platform.hpp>
 
@@ -237,6 +238,19 @@ public:
         return backend()->values();
     }
 
+    /**
+     * @brief Get all values of the property as a single column.
+     *
+     * Unlike {@link values}, which creates one {@link nix::Value} for
+     * every entry, the column stores all entries in a few arrays and
+     * is the faster choice for properties with many values.
+     *
+     * @return The values of the property.
+     */
+    ValueColumn valueColumn() const {
+        return backend()->valueColumn();
+    }
+
     /**
      * @brief Deletes all values from the property.
      */
@@ -16,6 +16,7 @@
 #include <nix/DataType.hpp>
 #include <nix/Platform.hpp>
 
+#include <map>
 #include <memory>
 #include <functional>
 #include <string>
@@ -389,6 +390,22 @@ public:
      */
     std::vector<Property> inheritedProperties() const;
 
+    /**
+     * @brief Read the values of all properties of the section in one pass.
+     *
+     * The values are keyed by the path of the property relative to this
+     * section, e.g. "rate" for a property of this section and "trial/setup/rate"
+     * for a property of a sub-section. Links are not followed.
+     *
+     * @param max_depth     The depth up to which properties of sub-sections are
+     *                      included; 0 reads only the properties of this section.
+     *
+     * @return A map from property paths to the values of the properties.
+     */
+    std::map<std::string, std::vector<Value>> propertyValues(size_t max_depth = 0) const {
+        return backend()->propertyValues(max_depth);
+    }
+
     /**
      * @brief Add a new Property that does not have any Values to this Section.
      *
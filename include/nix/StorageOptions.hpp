@@ -0,0 +1,67 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_STORAGE_OPTIONS_H
+#define NIX_STORAGE_OPTIONS_H
+
+#include <nix/DataType.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+#include <functional>
+
+namespace nix {
+
+/**
+ * @brief How the data of a file is laid out when it is written anew,
+ *        see {@link nix::File::repack}.
+ *
+ * The options apply to all numeric data sets, i.e. the data of data arrays
+ * as well as positions, extents, ticks and coefficients. Back-ends ignore
+ * options they have no equivalent for.
+ */
+struct NIXAPI StorageOptions {
+
+    /**
+     * @brief Chunk shape for data of the given type and extent.
+     *
+     * An empty NDSize, or no function at all, keeps the chunk shape of the
+     * existing data. Chunks are clipped to data of fixed extent.
+     */
+    std::function<NDSize(DataType dtype, const NDSize &extent)> chunking;
+
+    /**
+     * @brief Deflate compression level from 1 to 9, 0 disables compression.
+     *
+     * Compressed data is always chunked.
+     */
+    int compression = 0;
+
+    /**
+     * @brief Data of at most this many bytes is stored in the object
+     *        header (compact layout); 0 disables compact storage.
+     *
+     * HDF5 limits compact data to 64 KiB. The extent of compact data is
+     * fixed: setting the data extent of such a DataArray in the copy
+     * throws, so only use it for data that is not resized any more.
+     */
+    size_t compact_limit = 0;
+
+    /**
+     * @brief Use the latest file format, with compact and indexed
+     *        link storage for groups.
+     *
+     * Files in the latest format can not be read by older versions of
+     * the HDF5 library.
+     */
+    bool latest_format = false;
+};
+
+} // namespace nix
+
+#endif // NIX_STORAGE_OPTIONS_H
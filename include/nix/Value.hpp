@@ -16,6 +16,9 @@
 #include <nix/None.hpp>
 #include <nix/Variant.hpp>
 
+#include <string>
+#include <utility>
+
 namespace nix {
 
 
@@ -55,8 +58,10 @@ public:
         reference = other.reference;
     }
 
-    Value(Value &&other) NOEXCEPT : data() {
-        swap(other);
+    Value(Value &&other) NOEXCEPT
+        : data(std::move(other.data)), uncertainty(other.uncertainty),
+          reference(std::move(other.reference)), filename(std::move(other.filename)),
+          encoder(std::move(other.encoder)), checksum(std::move(other.checksum)) {
     }
 
     Value &operator=(Value other) {
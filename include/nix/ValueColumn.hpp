@@ -0,0 +1,203 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_VALUE_COLUMN_H
+#define NIX_VALUE_COLUMN_H
+
+#include <nix/DataType.hpp>
+#include <nix/Platform.hpp>
+#include <nix/Value.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Column oriented storage of the values of a {@link nix::Property}.
+ *
+ * Instead of one {@link nix::Value} per entry, a column keeps all values in a
+ * single typed array, all uncertainties in an array of doubles and all
+ * strings (string values, reference, filename, encoder and checksum) in one
+ * shared buffer. Reading a property with many values into a column therefore
+ * needs a handful of allocations instead of several per value.
+ *
+ * ~~~
+ * ValueColumn column = property.valueColumn();
+ * const double *values = column.data<double>();
+ * for (size_t i = 0; i < column.size(); i++) {
+ *     sum += values[i];
+ * }
+ * ~~~
+ *
+ * All values of a column have the same type. The type of an empty column
+ * without type is set by the first value appended to it.
+ */
+class NIXAPI ValueColumn {
+
+public:
+
+    /**
+     * @brief Constructor that creates an empty column.
+     *
+     * @param dtype     The type of the values.
+     */
+    explicit ValueColumn(DataType dtype = DataType::Nothing);
+
+    /**
+     * @brief Constructor that copies values into a column.
+     *
+     * @param values    The values, all of the same type.
+     */
+    explicit ValueColumn(const std::vector<Value> &values);
+
+    DataType dataType() const {
+        return dtype;
+    }
+
+    size_t size() const {
+        return uncertainty_data.size();
+    }
+
+    bool empty() const {
+        return uncertainty_data.empty();
+    }
+
+    /**
+     * @brief Reserve memory for a number of values.
+     *
+     * @param count         The number of values.
+     * @param text_bytes    The total length of all strings.
+     */
+    void reserve(size_t count, size_t text_bytes = 0);
+
+    /**
+     * @brief Append a value and its uncertainty and strings.
+     */
+    void push_back(const Value &value);
+
+    /**
+     * @brief Append a value given by its parts, without creating a
+     *        {@link nix::Value}. Strings may be null for empty strings.
+     */
+    template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    void append(T value, double uncertainty, const char *reference, const char *filename,
+                const char *encoder, const char *checksum) {
+        adopt_type(to_data_type<T>::value);
+        append_raw(&value, sizeof(T));
+        append_text(uncertainty, reference, filename, encoder, checksum);
+    }
+
+    void append(const char *value, double uncertainty, const char *reference, const char *filename,
+                const char *encoder, const char *checksum);
+
+    void append(none_t, double uncertainty, const char *reference, const char *filename,
+                const char *encoder, const char *checksum);
+
+    /**
+     * @brief The values as array, the type must match the type of the column.
+     *
+     * Not available for string columns, use {@link string} instead.
+     */
+    template<typename T>
+    const T *data() const {
+        if (to_data_type<T>::value != dtype) {
+            throw std::invalid_argument("Incompatible DataType");
+        }
+        return reinterpret_cast<const T *>(value_data.data());
+    }
+
+    /**
+     * @brief A value of a numeric or bool column.
+     */
+    template<typename T>
+    T get(size_t index) const {
+        check_index(index);
+        return data<T>()[index];
+    }
+
+    /**
+     * @brief A value of a string column.
+     */
+    const char *string(size_t index) const;
+
+    double uncertainty(size_t index) const {
+        check_index(index);
+        return uncertainty_data[index];
+    }
+
+    const std::vector<double> &uncertainties() const {
+        return uncertainty_data;
+    }
+
+    const char *reference(size_t index) const {
+        return text(index, 0);
+    }
+
+    const char *filename(size_t index) const {
+        return text(index, 1);
+    }
+
+    const char *encoder(size_t index) const {
+        return text(index, 2);
+    }
+
+    const char *checksum(size_t index) const {
+        return text(index, 3);
+    }
+
+    /**
+     * @brief Create the {@link nix::Value} at an index.
+     */
+    Value value(size_t index) const;
+
+    /**
+     * @brief Create {@link nix::Value} entities for all values.
+     */
+    std::vector<Value> toValues() const;
+
+private:
+
+    static const size_t text_fields = 4;
+
+    void adopt_type(DataType type);
+
+    void append_raw(const void *value, size_t size) {
+        const char *bytes = static_cast<const char *>(value);
+        value_data.insert(value_data.end(), bytes, bytes + size);
+    }
+
+    void append_text(double uncertainty, const char *reference, const char *filename,
+                     const char *encoder, const char *checksum);
+
+    size_t store(const char *str);
+
+    const char *text(size_t index, size_t field) const {
+        check_index(index);
+        return arena.data() + text_offsets[index * text_fields + field];
+    }
+
+    void check_index(size_t index) const;
+
+    DataType dtype;
+
+    // values of numeric types in their native representation, for
+    // string columns the offsets of the strings in the arena
+    std::vector<char> value_data;
+    std::vector<double> uncertainty_data;
+    std::vector<size_t> text_offsets;
+
+    // all strings with their terminating null, starts with the empty string
+    std::vector<char> arena;
+};
+
+} // namespace nix
+
+#endif // NIX_VALUE_COLUMN_H
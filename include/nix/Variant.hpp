@@ -16,6 +16,7 @@
 #include <nix/None.hpp>
 
 #include <string>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <iostream>
@@ -23,10 +24,22 @@
 namespace nix {
 /**
  * @brief Class that can hold either a bool, double, (u)int(34|64) or a string.
+ *
+ * Strings of up to {@link small_capacity} characters are stored inside the
+ * variant itself, only longer strings are allocated on the heap. Moving a
+ * variant never allocates.
  */
 class NIXAPI Variant {
+public:
+
+    /**
+     * @brief The maximal length of strings that are stored without allocation.
+     */
+    static const size_t small_capacity = 23;
+
 private:
     DataType dtype;
+    bool is_small;
 
     union {
         bool v_bool;
@@ -36,26 +49,27 @@ private:
         uint64_t v_uint64;
         int64_t v_int64;
         char *v_string;
+        char v_small[small_capacity + 1];
     };
 
 public:
-    Variant() : dtype(DataType::Nothing), v_bool(false) { }
+    Variant() : dtype(DataType::Nothing), is_small(false), v_bool(false) { }
 
-    explicit Variant(char *value) : dtype(DataType::Nothing) {
+    explicit Variant(char *value) : Variant() {
         set(value);
     }
 
-    explicit Variant(const char *value) : dtype(DataType::Nothing) {
+    explicit Variant(const char *value) : Variant() {
         set(value);
     }
 
     template<typename T>
-    explicit Variant(const T &value) : dtype(DataType::Nothing) {
+    explicit Variant(const T &value) : Variant() {
         set(value);
     }
 
     template<size_t N>
-    explicit Variant(const char (&value)[N]) : dtype(DataType::Nothing) {
+    explicit Variant(const char (&value)[N]) : Variant() {
         set(value, N);
     }
 
@@ -64,18 +78,21 @@ public:
     }
 
     Variant(Variant &&other) NOEXCEPT : Variant() {
-        if (other.dtype == DataType::String) {
-            v_string = other.v_string;
-            dtype = DataType::String;
-            other.dtype = DataType::Nothing;
-            other.v_string = nullptr;
-        } else {
+        steal(other);
+    }
+
+    Variant &operator=(const Variant &other) {
+        if (this != &other) {
             assign_variant_from(other);
         }
+        return *this;
     }
 
-    Variant &operator=(Variant other) {
-        assign_variant_from(other);
+    Variant &operator=(Variant &&other) NOEXCEPT {
+        if (this != &other) {
+            maybe_deallocte_string();
+            steal(other);
+        }
         return *this;
     }
 
@@ -114,14 +131,27 @@ public:
         return dtype;
     }
 
-    void swap(Variant &other);
+    /**
+     * @brief Check if a string is stored on the heap.
+     */
+    bool on_heap() const {
+        return dtype == DataType::String && !is_small;
+    }
+
+    void swap(Variant &other) NOEXCEPT;
 
     static bool supports_type(DataType dtype);
 
 private:
 
+    const char *str() const {
+        return is_small ? v_small : v_string;
+    }
+
     void assign_variant_from(const Variant &other);
 
+    void steal(Variant &other) NOEXCEPT;
+
     void maybe_deallocte_string();
 
     inline void check_argument_type(DataType check) const {
@@ -135,7 +165,7 @@ private:
 template<>
 inline const char *Variant::get<const char *>() const {
     check_argument_type(DataType::String);
-    return v_string;
+    return str();
 }
 
 template<>
@@ -16,6 +16,8 @@
 #include <nix/base/IMultiTag.hpp>
 #include <nix/base/IGroup.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/ObjectType.hpp>
+#include <nix/util/query.hpp>
 
 #include <string>
 #include <vector>
@@ -139,6 +141,12 @@ public:
 
     virtual bool deleteGroup(const std::string &name_or_id) = 0;
 
+    //--------------------------------------------------
+    // Queries
+    //--------------------------------------------------
+
+    virtual std::vector<std::string> matchingNames(ObjectType type, const util::Query &query) const = 0;
+
 
     virtual ~IBlock() {}
 };
@@ -163,6 +163,22 @@ public:
     virtual void ticks(const std::vector<double> &ticks) = 0;
 
 
+    virtual ndsize_t tickCount() const = 0;
+
+    /**
+     * @brief Read a range of ticks without loading all ticks.
+     *
+     * The range must be within the stored ticks.
+     */
+    virtual std::vector<double> ticks(ndsize_t start, ndsize_t count) const = 0;
+
+    /**
+     * @brief Get the index of the first tick that is not less than each
+     *        position, clamped to the range of ticks.
+     */
+    virtual std::vector<ndsize_t> indexOf(const std::vector<double> &positions) const = 0;
+
+
     virtual ~IRangeDimension() {}
 
 };
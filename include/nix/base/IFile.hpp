@@ -11,6 +11,7 @@
 
 #include <nix/base/ISection.hpp>
 #include <nix/base/IBlock.hpp>
+#include <nix/StorageOptions.hpp>
 #include <nix/Platform.hpp>
 
 #include <string>
@@ -112,12 +113,33 @@ public:
     virtual void close() = 0;
 
 
+    virtual void flush() = 0;
+
+
+    virtual void repack(const std::string &path, const StorageOptions &options) const = 0;
+
+
     virtual bool isOpen() const = 0;
 
 
     virtual FileMode fileMode() const = 0;
 
 
+    virtual void beginBatch() = 0;
+
+
+    virtual void endBatch() = 0;
+
+
+    virtual void abandonBatch() = 0;
+
+
+    virtual size_t revision() const = 0;
+
+
+    virtual std::vector<std::string> matchingNames(ObjectType type, const util::Query &query) const = 0;
+
+
     virtual ~IFile() {}
 
 };
@@ -10,6 +10,7 @@
 #define NIX_I_PROPERTY_H
 
 #include <nix/Value.hpp>
+#include <nix/ValueColumn.hpp>
 #include <nix/base/INamedEntity.hpp>
 
 #include <nix/NDSize.hpp>
@@ -75,6 +76,9 @@ public:
     virtual std::vector<Value> values(void) const = 0;
 
 
+    virtual ValueColumn valueColumn() const = 0;
+
+
     virtual void values(const boost::none_t t) = 0;
 
 
@@ -17,6 +17,7 @@
 #include <nix/Value.hpp>
 #include <nix/NDSize.hpp>
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -117,6 +118,9 @@ public:
     virtual bool deleteProperty(const std::string &name_or_id) = 0;
 
 
+    virtual std::map<std::string, std::vector<Value>> propertyValues(size_t max_depth) const = 0;
+
+
     virtual ~ISection() {}
 
 };
@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <vector>
+#include <string>
 #include <list>
 #include <functional>
 #include <utility>
@@ -76,6 +77,34 @@ protected:
         return entities;
     }
 
+    /**
+     * Low level helper to get entities by name via a getter function,
+     * e.g. for the names that matched a query in the back-end.
+     *
+     * @param getEntity         Function of return type TENT that accepts
+     *                          the name of the entity.
+     * @param names             Names of the entities to get.
+     *
+     * @return A vector with all entities that exist.
+     */
+    template<typename TENT, typename TFUNC>
+    std::vector<TENT> getEntities(
+        TFUNC const &getEntity,
+        const std::vector<std::string> &names) const
+    {
+        std::vector<TENT> entities;
+        entities.reserve(names.size());
+
+        for (const std::string &name : names) {
+            TENT candidate = getEntity(name);
+            if (candidate) {
+                entities.push_back(candidate);
+            }
+        }
+
+        return entities;
+    }
+
 public:
 
     ImplContainer()
@@ -22,6 +22,7 @@
 #include <nix/Tag.hpp>
 
 #include <ctime>
+#include <vector>
 
 namespace nix {
 namespace util {
@@ -94,6 +95,23 @@ NIXAPI void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &of
 
 NIXAPI void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_t index, NDSize &offsets, NDSize &counts);
 
+/**
+ * @brief Get the offsets and counts of all positions of a MultiTag in a
+ *        referenced DataArray.
+ *
+ * Other than calling {@link getOffsetAndCount} for every position, the
+ * positions, extents and dimension descriptors are read only once and units
+ * are converted once per dimension.
+ *
+ * @param tag           The multi tag.
+ * @param array         A referenced data array.
+ * @param[out] offsets  The offsets, one row of array.dimensionCount() values
+ *                      per position.
+ * @param[out] counts   The counts, in the same layout as the offsets.
+ */
+NIXAPI void getOffsetsAndCounts(const MultiTag &tag, const DataArray &array,
+                                std::vector<ndsize_t> &offsets, std::vector<ndsize_t> &counts);
+
 /**
  * @brief Retrieve the data referenced by the given position and extent of the MultiTag.
  *
@@ -105,6 +123,20 @@ NIXAPI void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_
  */
 NIXAPI DataView retrieveData(const MultiTag &tag, size_t position_index, size_t reference_index);
 
+/**
+ * @brief Retrieve the data referenced by several positions and extents of the MultiTag.
+ *
+ * Positions, extents and dimension descriptors are read only once for all positions.
+ *
+ * @param tag                   The multi tag.
+ * @param position_indices      The indices of the positions.
+ * @param reference_index       The index of the reference from which data should be returned.
+ *
+ * @return The data referenced by each position and extent.
+ */
+NIXAPI std::vector<DataView> retrieveData(const MultiTag &tag, const std::vector<size_t> &position_indices,
+                                          size_t reference_index);
+
 /**
  * @brief Retrieve the data referenced by the given position and extent of the Tag.
  *
@@ -157,6 +189,18 @@ NIXAPI DataView retrieveFeatureData(const Tag &tag, size_t feature_index=0);
  */
 NIXAPI DataView retrieveFeatureData(const MultiTag &tag, size_t position_index, size_t feature_index=0);
 
+/**
+ * @brief Returns the feature data accosiated with several positions of a MultiTag.
+ *
+ * @param tag               The MultiTag whos feature data is requested.
+ * @param position_indices  The indices of the selected positions.
+ * @param feature_index     The index of the desired feature. Default is 0.
+ *
+ * @return The associated data for each position.
+ */
+NIXAPI std::vector<DataView> retrieveFeatureData(const MultiTag &tag, const std::vector<size_t> &position_indices,
+                                                 size_t feature_index=0);
+
 }
 }
 #endif // NIX_DATAACCESS_H
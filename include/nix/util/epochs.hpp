@@ -0,0 +1,195 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_EPOCHS_H
+#define NIX_EPOCHS_H
+
+#include <nix/NDArray.hpp>
+#include <nix/DataArray.hpp>
+#include <nix/MultiTag.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief Mean and variance of the epochs around many events.
+ *
+ * Both arrays have the shape (window x channels). Since windows at the
+ * borders of the data are incomplete, the number of epochs that contributed
+ * is counted for every sample of the window. Samples without epochs are NaN,
+ * the variance is NaN for samples with fewer than two epochs.
+ */
+struct NIXAPI EpochAverage {
+
+    EpochAverage(const NDSize &shape)
+        : mean(DataType::Double, shape), variance(DataType::Double, shape), counts(shape[0], 0)
+    { }
+
+    NDArray mean;
+    NDArray variance;
+    std::vector<ndsize_t> counts;
+};
+
+
+/**
+ * @brief Cuts windows of fixed length around the positions of a MultiTag
+ *        out of referenced data and stacks them.
+ *
+ * The first dimension of the data must be a SampledDimension; the first
+ * column of the positions gives the events on it, in the first unit of
+ * the tag. Data may have a second dimension, e.g. channels, which is
+ * copied completely. The epochs are returned as one NDArray of doubles
+ * with the shape (events x window x channels), samples outside of the data
+ * are NaN.
+ *
+ * All windows are computed at once. Windows that overlap or are close to
+ * each other are read from the data with a single read, so that data is
+ * read at most once.
+ *
+ * For many events, average() reduces the epochs to their mean and variance
+ * without keeping them in memory, and histogram() counts the times of other
+ * events, e.g. spikes, around every event.
+ *
+ * ~~~
+ * util::EpochExtractor epochs(spikes, 0.01, 0.02);
+ * epochs.baseline(-0.01, 0.0);
+ * NDArray stacked = epochs.extract(0);
+ * ~~~
+ */
+class NIXAPI EpochExtractor {
+
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param tag       The multi tag holding the events.
+     * @param pre       The length of the window before each event.
+     * @param post      The length of the window after each event.
+     */
+    EpochExtractor(const MultiTag &tag, double pre, double post);
+
+    /**
+     * @brief Apply the polynomial calibration of the data array to the
+     *        samples of every epoch.
+     */
+    EpochExtractor &calibrate(bool apply = true);
+
+    /**
+     * @brief Subtract the mean of an interval of every epoch and channel
+     *        from it.
+     *
+     * @param start     The start of the interval relative to the event.
+     * @param end       The end of the interval relative to the event.
+     */
+    EpochExtractor &baseline(double start, double end);
+
+    /**
+     * @brief Set the number of samples two windows may be apart to
+     *        be read with a single read. The default is the window length.
+     */
+    EpochExtractor &maxGap(ndsize_t samples);
+
+    /**
+     * @brief Extract the epochs of all events from a referenced data array.
+     *
+     * @param reference_index   The index of the reference.
+     */
+    NDArray extract(size_t reference_index) const;
+
+    /**
+     * @brief Extract the epochs of all events from a data array.
+     */
+    NDArray extract(const DataArray &array) const;
+
+    /**
+     * @brief Extract the epochs of some events from a data array.
+     *
+     * @param array     The data array.
+     * @param events    The indices of the events, i.e. of the positions.
+     */
+    NDArray extract(const DataArray &array, const std::vector<size_t> &events) const;
+
+    /**
+     * @brief Average the epochs of all events of a referenced data array.
+     *
+     * @param reference_index   The index of the reference.
+     */
+    EpochAverage average(size_t reference_index) const;
+
+    /**
+     * @brief Average the epochs of all events of a data array.
+     */
+    EpochAverage average(const DataArray &array) const;
+
+    /**
+     * @brief Average the epochs of some events of a data array.
+     *
+     * The epochs are calibrated and baseline corrected one by one and
+     * then added to the running mean and variance, so that memory use
+     * does not depend on the number of events. The data is read in a
+     * single pass like for extract().
+     *
+     * @param array     The data array.
+     * @param events    The indices of the events, i.e. of the positions.
+     */
+    EpochAverage average(const DataArray &array, const std::vector<size_t> &events) const;
+
+    /**
+     * @brief Count times around all events in bins of the window, e.g.
+     *        for a peri-stimulus time histogram.
+     *
+     * The times are read in blocks with a single pass over the array.
+     *
+     * @param times     A 1-D array of times, in the unit of the positions.
+     * @param bin_width The width of the bins, the last bin may be shorter.
+     *
+     * @return The counts of all bins, the first bin starts at -pre.
+     */
+    std::vector<ndsize_t> histogram(const DataArray &times, double bin_width) const;
+
+private:
+
+    struct Layout {
+        NDSize extent;
+        double scaling, offset, interval;
+        ndsize_t window, channels;
+        size_t first_base, last_base;
+        std::vector<double> coefficients;
+        double origin;
+    };
+
+    typedef std::function<void(size_t epoch, ndsize_t first, const double *data, ndsize_t count)> window_fn;
+
+    Layout layout(const DataArray &array) const;
+
+    void readWindows(const DataArray &array, const Layout &layout,
+                     const std::vector<size_t> &events, const window_fn &fn) const;
+
+    void correct(double *epochs, size_t count, const Layout &layout) const;
+
+    std::vector<double> eventPositions() const;
+
+    std::vector<size_t> allEvents() const;
+
+    MultiTag tag;
+    double pre, post;
+    bool apply_calibration;
+    bool subtract_baseline;
+    double baseline_start, baseline_end;
+    bool have_max_gap;
+    ndsize_t max_gap;
+};
+
+} // namespace util
+} // namespace nix
+
+#endif // NIX_EPOCHS_H
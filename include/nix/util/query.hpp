@@ -0,0 +1,191 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_QUERY_H
+#define NIX_QUERY_H
+
+#include <nix/Platform.hpp>
+
+#include <boost/optional.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief Declarative query on the attributes of entities.
+ *
+ * Other than the filters in filter.hpp, which are functions that are applied
+ * to fully constructed entities, a query only describes conditions on the
+ * name, type, id, definition and metadata of entities. This allows back-ends
+ * to evaluate it against the stored attributes while iterating over a
+ * collection, so that entities are only constructed for matches:
+ *
+ * ~~~
+ * using util::Query;
+ * std::vector<DataArray> spikes = block.dataArrays(Query::type("nix.spike") && !Query::namePrefix("tmp_"));
+ * ~~~
+ *
+ * Queries can also be used wherever a filter is expected, in that case
+ * they are evaluated on the entities like any other filter.
+ */
+class NIXAPI Query {
+
+public:
+
+    /**
+     * @brief The attributes of an entity a query can refer to.
+     *
+     * Metadata is the id of the section linked as metadata.
+     */
+    enum class Field : int {
+        Name, Type, Id, Definition, Metadata
+    };
+
+    /**
+     * @brief Function that provides the value of a field of one entity,
+     *        an unset optional if the entity does not have the field.
+     */
+    typedef std::function<boost::optional<std::string>(Field)> accessor_t;
+
+    /**
+     * @brief Constructor for a query that matches all entities.
+     */
+    Query();
+
+    static Query all() {
+        return Query();
+    }
+
+    static Query name(const std::string &name);
+
+    static Query namePrefix(const std::string &prefix);
+
+    static Query type(const std::string &type);
+
+    static Query typePrefix(const std::string &prefix);
+
+    static Query id(const std::string &id);
+
+    static Query ids(const std::vector<std::string> &ids);
+
+    static Query definition(const std::string &definition);
+
+    /**
+     * @brief Matches entities that have the section with the given
+     *        id as metadata.
+     */
+    static Query metadata(const std::string &section_id);
+
+    /**
+     * @brief Matches entities with a field equal to one of the values.
+     */
+    static Query equals(Field field, const std::vector<std::string> &values);
+
+    /**
+     * @brief Matches entities with a field that starts with the prefix.
+     */
+    static Query prefix(Field field, const std::string &prefix);
+
+    Query operator&&(const Query &other) const;
+
+    Query operator||(const Query &other) const;
+
+    Query operator!() const;
+
+    /**
+     * @brief Check if the query matches all entities, i.e. it has no
+     *        conditions.
+     */
+    bool acceptsAll() const;
+
+    /**
+     * @brief Get the values a field must have for an entity to match.
+     *
+     * Back-ends can use this to look up candidates in an index and
+     * evaluate the query on these only.
+     *
+     * @param field     The field.
+     *
+     * @return The sorted values or an unset optional if the query does
+     *         not restrict the field to a set of values.
+     */
+    boost::optional<std::vector<std::string>> allowedValues(Field field) const;
+
+    /**
+     * @brief Evaluate the query for one entity.
+     *
+     * Fields are requested from the accessor only if they are needed
+     * and at most once.
+     *
+     * @param get       Accessor for the fields of the entity.
+     *
+     * @return True if the entity matches.
+     */
+    bool matches(const accessor_t &get) const;
+
+    /**
+     * @brief Evaluate the query on a frontend entity, so that a query
+     *        can be used as filter.
+     */
+    template<typename T>
+    bool operator()(const T &entity) const {
+        return matches([&entity](Field f) {
+            return field_value(entity, f);
+        });
+    }
+
+private:
+
+    struct Node;
+
+    std::shared_ptr<const Node> root;
+
+    explicit Query(const std::shared_ptr<const Node> &root);
+
+    static bool eval(const Node &node, const accessor_t &get);
+
+    static boost::optional<std::vector<std::string>> allowed(const Node &node, Field field);
+
+    template<typename T>
+    static boost::optional<std::string> field_value(const T &entity, Field f) {
+        switch (f) {
+            case Field::Name: return entity.name();
+            case Field::Type: return entity.type();
+            case Field::Id:   return entity.id();
+            case Field::Definition: return entity.definition();
+            case Field::Metadata: return metadata_id(entity, 0);
+        }
+        return boost::none;
+    }
+
+    template<typename T>
+    static auto metadata_id(const T &entity, int) -> decltype(entity.metadata().id(), boost::optional<std::string>()) {
+        boost::optional<std::string> ret;
+        auto section = entity.metadata();
+        if (section) {
+            ret = section.id();
+        }
+        return ret;
+    }
+
+    template<typename T>
+    static boost::optional<std::string> metadata_id(const T &entity, long) {
+        return boost::none;
+    }
+};
+
+
+} // namespace util
+} // namespace nix
+
+#endif // NIX_QUERY_H
@@ -0,0 +1,76 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/AxisView.hpp>
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace nix {
+
+
+const size_t AxisView::page_size;
+
+
+AxisView::AxisView()
+    : offset(0.0), interval(1.0), start(0), count(0)
+{
+}
+
+
+AxisView::AxisView(double offset, double interval, size_t start, size_t count)
+    : offset(offset), interval(interval), start(start), count(count)
+{
+}
+
+
+AxisView::AxisView(const shared_ptr<base::IRangeDimension> &range, size_t start, size_t count)
+    : offset(0.0), interval(1.0), start(start), count(count), range(range), page(make_shared<Page>())
+{
+}
+
+
+double AxisView::at(size_t index) const {
+    if (index >= count) {
+        throw OutOfBounds("AxisView::at: Given index is out of bounds!", index);
+    }
+    return (*this)[index];
+}
+
+
+vector<double> AxisView::toVector() const {
+    if (range) {
+        return count > 0 ? range->ticks(start, count) : vector<double>();
+    }
+
+    vector<double> axis(count);
+    for (size_t i = 0; i < count; ++i) {
+        axis[i] = (i + start) * interval + offset;
+    }
+    return axis;
+}
+
+
+double AxisView::tick(size_t index) const {
+    size_t position = start + index;
+    Page &p = *page;
+
+    if (p.ticks.empty() || position < p.start || position - p.start >= p.ticks.size()) {
+        size_t first = index - index % page_size;
+        p.ticks = range->ticks(start + first, min(page_size, count - first));
+        p.start = start + first;
+    }
+
+    return p.ticks[position - p.start];
+}
+
+
+} // namespace nix
@@ -0,0 +1,62 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/Batch.hpp>
+
+namespace nix {
+
+
+Batch::Batch(const std::shared_ptr<base::IFile> &file)
+    : file(file)
+{
+    if (!file) {
+        throw UninitializedEntity();
+    }
+    file->beginBatch();
+}
+
+
+Batch::Batch(Batch &&other)
+    : file(std::move(other.file))
+{
+    other.file = nullptr;
+}
+
+
+Batch &Batch::operator=(Batch &&other) {
+    if (this != &other) {
+        abandon();
+        file = std::move(other.file);
+        other.file = nullptr;
+    }
+    return *this;
+}
+
+
+void Batch::commit() {
+    if (file) {
+        std::shared_ptr<base::IFile> tmp = std::move(file);
+        file = nullptr;
+        tmp->endBatch();
+    }
+}
+
+
+void Batch::abandon() {
+    if (file) {
+        file->abandonBatch();
+        file = nullptr;
+    }
+}
+
+
+Batch::~Batch() {
+    abandon();
+}
+
+} // namespace nix
@@ -11,6 +11,13 @@
 
 namespace nix {
 
+// type filters are answered by a query, so that the back-end can look up
+// the matching entities in its type index
+template<typename T>
+static const util::TypeFilter<T> *as_type_filter(const typename util::Filter<T>::type &filter) {
+    return filter.template target<util::TypeFilter<T>>();
+}
+
 Source Block::createSource(const std::string &name, const std::string &type){
     util::checkEntityNameAndType(name, type);
     if (backend()->hasSource(name)) {
@@ -48,10 +55,19 @@ Source Block::getSource(ndsize_t index) const {
 }
 
 std::vector<Source> Block::sources(const util::Filter<Source>::type &filter) const {
+    const util::TypeFilter<Source> *type_filter = as_type_filter<Source>(filter);
+    if (type_filter) {
+        return sources(util::Query::type(type_filter->type));
+    }
     auto f = [this](ndsize_t i) { return getSource(i); };
     return getEntities<Source>(f, sourceCount(), filter);
 }
 
+std::vector<Source> Block::sources(const util::Query &query) const {
+    auto f = [this] (const std::string &name) { return getSource(name); };
+    return getEntities<Source>(f, backend()->matchingNames(ObjectType::Source, query));
+}
+
 bool Block::deleteSource(const Source &source) {
     if (!util::checkEntityInput(source, false)) {
         return false;
@@ -76,10 +92,19 @@ bool Block::hasDataArray(const DataArray &data_array) const {
 }
 
 std::vector<DataArray> Block::dataArrays(const util::AcceptAll<DataArray>::type &filter) const {
+    const util::TypeFilter<DataArray> *type_filter = as_type_filter<DataArray>(filter);
+    if (type_filter) {
+        return dataArrays(util::Query::type(type_filter->type));
+    }
     auto f = [this] (size_t i) { return getDataArray(i); };
     return getEntities<DataArray>(f, dataArrayCount(), filter);
 }
 
+std::vector<DataArray> Block::dataArrays(const util::Query &query) const {
+    auto f = [this] (const std::string &name) { return getDataArray(name); };
+    return getEntities<DataArray>(f, backend()->matchingNames(ObjectType::DataArray, query));
+}
+
 bool Block::deleteDataArray(const DataArray &data_array) {
     if (!util::checkEntityInput(data_array, false)) {
         return false;
@@ -110,10 +135,19 @@ Tag Block::getTag(ndsize_t index) const {
 }
 
 std::vector<Tag> Block::tags(const util::Filter<Tag>::type &filter) const {
+    const util::TypeFilter<Tag> *type_filter = as_type_filter<Tag>(filter);
+    if (type_filter) {
+        return tags(util::Query::type(type_filter->type));
+    }
     auto f = [this] (ndsize_t i) { return getTag(i); };
     return getEntities<Tag>(f, tagCount(), filter);
 }
 
+std::vector<Tag> Block::tags(const util::Query &query) const {
+    auto f = [this] (const std::string &name) { return getTag(name); };
+    return getEntities<Tag>(f, backend()->matchingNames(ObjectType::Tag, query));
+}
+
 bool Block::deleteTag(const Tag &tag) {
     if (!util::checkEntityInput(tag, false)) {
         return false;
@@ -148,10 +182,19 @@ bool Block::hasMultiTag(const MultiTag &multi_tag) const {
 }
 
 std::vector<MultiTag> Block::multiTags(const util::AcceptAll<MultiTag>::type &filter) const {
+    const util::TypeFilter<MultiTag> *type_filter = as_type_filter<MultiTag>(filter);
+    if (type_filter) {
+        return multiTags(util::Query::type(type_filter->type));
+    }
     auto f = [this] (ndsize_t i) { return getMultiTag(i); };
     return getEntities<MultiTag>(f, multiTagCount(), filter);
 }
 
+std::vector<MultiTag> Block::multiTags(const util::Query &query) const {
+    auto f = [this] (const std::string &name) { return getMultiTag(name); };
+    return getEntities<MultiTag>(f, backend()->matchingNames(ObjectType::MultiTag, query));
+}
+
 bool Block::deleteMultiTag(const MultiTag &multi_tag) {
     if (!util::checkEntityInput(multi_tag, false)) {
         return false;
@@ -175,10 +218,19 @@ bool Block::hasGroup(const Group &group) const {
 }
 
 std::vector<Group> Block::groups(const util::AcceptAll<Group>::type &filter) const {
+    const util::TypeFilter<Group> *type_filter = as_type_filter<Group>(filter);
+    if (type_filter) {
+        return groups(util::Query::type(type_filter->type));
+    }
     auto f = [this] (ndsize_t i) { return getGroup(i); };
     return getEntities<Group>(f, groupCount(), filter);
 }
 
+std::vector<Group> Block::groups(const util::Query &query) const {
+    auto f = [this] (const std::string &name) { return getGroup(name); };
+    return getEntities<Group>(f, backend()->matchingNames(ObjectType::Group, query));
+}
+
 bool Block::deleteGroup(const Group &group) {
     if (!util::checkEntityInput(group, false)) {
         return false;
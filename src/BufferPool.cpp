@@ -0,0 +1,162 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/BufferPool.hpp>
+
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+namespace nix {
+
+
+const size_t BufferPool::alignment;
+
+
+namespace {
+
+// blocks of 2^min_class to 2^max_class bytes are cached, larger ones not
+const size_t min_class = 6;
+const size_t max_class = 30;
+
+typedef aligned_allocator<unsigned char, BufferPool::alignment> block_allocator;
+
+atomic<size_t> cached_bytes(0);
+atomic<size_t> cache_limit(size_t(256) << 20);
+
+
+size_t size_class(size_t bytes) {
+    size_t c = min_class;
+    while (c < max_class && (size_t(1) << c) < bytes) {
+        ++c;
+    }
+    return c;
+}
+
+
+size_t block_size(size_t bytes) {
+    size_t c = size_class(bytes);
+    return (size_t(1) << c) >= bytes ? size_t(1) << c : bytes;
+}
+
+
+bool cacheable(size_t bytes) {
+    return bytes <= (size_t(1) << max_class);
+}
+
+
+struct FreeLists {
+
+    vector<void *> lists[max_class - min_class + 1];
+
+    void clear() {
+        block_allocator alloc;
+        for (size_t i = 0; i <= max_class - min_class; ++i) {
+            size_t size = size_t(1) << (i + min_class);
+            for (void *block : lists[i]) {
+                alloc.deallocate(static_cast<unsigned char *>(block), size);
+                cached_bytes -= size;
+            }
+            lists[i].clear();
+        }
+    }
+
+    ~FreeLists();
+};
+
+
+// blocks that are released after the lists of a thread are destroyed,
+// e.g. by static objects, are freed directly
+enum class ListState : int { Unused, Alive, Destroyed };
+
+thread_local ListState list_state = ListState::Unused;
+thread_local FreeLists free_lists;
+
+
+FreeLists::~FreeLists() {
+    list_state = ListState::Destroyed;
+    clear();
+}
+
+
+FreeLists *thread_lists() {
+    if (list_state == ListState::Destroyed) {
+        return nullptr;
+    }
+    FreeLists *lists = &free_lists;
+    list_state = ListState::Alive;
+    return lists;
+}
+
+} // namespace
+
+
+void *BufferPool::acquire(size_t bytes) {
+    size_t size = block_size(bytes);
+
+    FreeLists *lists = cacheable(size) ? thread_lists() : nullptr;
+    if (lists != nullptr) {
+        vector<void *> &list = lists->lists[size_class(size) - min_class];
+        if (!list.empty()) {
+            void *block = list.back();
+            list.pop_back();
+            cached_bytes -= size;
+            return block;
+        }
+    }
+
+    return block_allocator().allocate(size);
+}
+
+
+void BufferPool::release(void *block, size_t bytes) {
+    if (block == nullptr) {
+        return;
+    }
+
+    size_t size = block_size(bytes);
+    FreeLists *lists = cacheable(size) && cached_bytes + size <= cache_limit ? thread_lists() : nullptr;
+    if (lists != nullptr) {
+        try {
+            lists->lists[size_class(size) - min_class].push_back(block);
+            cached_bytes += size;
+            return;
+        } catch (const std::bad_alloc &) {
+            // free the block below
+        }
+    }
+
+    block_allocator().deallocate(static_cast<unsigned char *>(block), size);
+}
+
+
+void BufferPool::limit(size_t bytes) {
+    cache_limit = bytes;
+}
+
+
+size_t BufferPool::limit() {
+    return cache_limit;
+}
+
+
+size_t BufferPool::cached() {
+    return cached_bytes;
+}
+
+
+void BufferPool::trim() {
+    FreeLists *lists = thread_lists();
+    if (lists != nullptr) {
+        lists->clear();
+    }
+}
+
+
+} // namespace nix
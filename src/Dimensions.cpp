@@ -195,13 +195,14 @@ double SampledDimension::positionAt(const size_t index) const {
 
 
 vector<double> SampledDimension::axis(const size_t count, const size_t startIndex) const {
-    vector<double> axis(count);
+    return axisView(count, startIndex).toVector();
+}
+
+
+AxisView SampledDimension::axisView(const size_t count, const size_t startIndex) const {
     double offset =  backend()->offset() ? *(backend()->offset()) : 0.0;
     double sampling_interval = backend()->samplingInterval();
-    for (size_t i = 0; i < axis.size(); ++i) {
-        axis[i] = (i + startIndex) * sampling_interval + offset;
-    }
-    return axis;
+    return AxisView(offset, sampling_interval, startIndex, count);
 }
 
 
@@ -344,34 +345,35 @@ void RangeDimension::ticks(const std::vector<double> &ticks) {
 
 
 double RangeDimension::tickAt(const size_t index) const {
-    vector<double> ticks = this->ticks();
-    if (index >= ticks.size()) {
+    if (index >= backend()->tickCount()) {
         throw nix::OutOfBounds("RangeDimension::tickAt: Given index is out of bounds!", index);
     }
-    return ticks[index];
+    return backend()->ticks(index, 1)[0];
 }
 
 
 size_t RangeDimension::indexOf(const double position) const {
-    vector<double> ticks = this->ticks();
-    if (position < *ticks.begin()) {
-        return 0;
-    } else if (position > *prev(ticks.end())) {
-        return prev(ticks.end()) - ticks.begin();
-    }
-    vector<double>::iterator low = std::lower_bound (ticks.begin(), ticks.end(), position);
-    return low - ticks.begin();
+    return indexOf(vector<double>{position})[0];
+}
+
+
+vector<size_t> RangeDimension::indexOf(const vector<double> &positions) const {
+    vector<ndsize_t> indices = backend()->indexOf(positions);
+    return vector<size_t>(indices.begin(), indices.end());
 }
 
 
 vector<double> RangeDimension::axis(const size_t count, const size_t startIndex) const {
-    vector<double> ticks = this->ticks();
-    if ((startIndex + count) > ticks.size()) {
+    return axisView(count, startIndex).toVector();
+}
+
+
+AxisView RangeDimension::axisView(const size_t count, const size_t startIndex) const {
+    ndsize_t tick_count = backend()->tickCount();
+    if (startIndex > tick_count || count > tick_count - startIndex) {
         throw nix::OutOfBounds("RangeDimension::axis: Count is invalid, reaches beyond the ticks stored in this dimension.");
-    } 
-    vector<double>::const_iterator first = ticks.begin() + startIndex;
-    vector<double> axis(first, first + count);
-    return axis;
+    }
+    return AxisView(impl(), startIndex, count);
 }
 
 
@@ -66,6 +66,13 @@ std::vector<Block> File::blocks(const util::Filter<Block>::type &filter) const
 }
 
 
+std::vector<Block> File::blocks(const util::Query &query) const
+{
+    auto f = [this] (const std::string &name) { return getBlock(name); };
+    return getEntities<Block>(f, backend()->matchingNames(ObjectType::Block, query));
+}
+
+
 Section File::createSection(const std::string &name, const std::string &type) {
     util::checkEntityNameAndType(name, type);
     if (backend()->hasSection(name)) {
@@ -90,6 +97,13 @@ std::vector<Section> File::sections(const util::Filter<Section>::type &filter) c
 }
 
 
+std::vector<Section> File::sections(const util::Query &query) const
+{
+    auto f = [this] (const std::string &name) { return getSection(name); };
+    return getEntities<Section>(f, backend()->matchingNames(ObjectType::Section, query));
+}
+
+
 bool File::deleteSection(const Section &section) {
     if(!util::checkEntityInput(section, false)) {
         return false;
@@ -182,6 +196,26 @@ valid::Result File::validate() const {
 }
 
 
+Batch File::beginBatch() {
+    return Batch(impl());
+}
+
+
+MetadataSnapshot File::metadataSnapshot() const {
+    return MetadataSnapshot(impl());
+}
+
+
+void File::flush() {
+    backend()->flush();
+}
+
+
+void File::repack(const std::string &path, const StorageOptions &options) const {
+    backend()->repack(path, options);
+}
+
+
 void File::close() {
     if (!isNone()) {
         backend()->close();
@@ -0,0 +1,479 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/MetadataSnapshot.hpp>
+
+#include <nix/File.hpp>
+#include <nix/base/ISection.hpp>
+#include <nix/base/IProperty.hpp>
+
+#include <stdexcept>
+#include <unordered_map>
+
+namespace nix {
+namespace snapshot {
+
+const size_t npos = std::numeric_limits<size_t>::max();
+
+
+struct SectionNode {
+    std::string id, name, type;
+    boost::optional<std::string> definition, repository, mapping;
+    time_t created_at, updated_at;
+
+    size_t parent;      // npos for root sections
+    size_t link;        // npos if there is no (resolvable) link
+
+    // children and properties are stored contiguously in the tree
+    size_t first_child, child_count;
+    size_t first_property, property_count;
+};
+
+
+struct PropertyNode {
+    std::string id, name;
+    boost::optional<std::string> definition, mapping, unit;
+    DataType data_type;
+    std::vector<Value> values;
+    time_t created_at, updated_at;
+};
+
+
+struct Tree {
+    std::shared_ptr<base::IFile> file;
+    size_t revision;
+
+    // sections in breadth first order, the root sections come first
+    std::vector<SectionNode> sections;
+    size_t root_count;
+    std::vector<PropertyNode> properties;
+
+    std::unordered_map<std::string, size_t> section_ids;
+
+    bool current() const {
+        return file->revision() == revision;
+    }
+
+    void check() const {
+        if (!current()) {
+            throw std::runtime_error("MetadataSnapshot: the file was modified after the snapshot was taken");
+        }
+    }
+};
+
+
+[[noreturn]] static void read_only() {
+    throw std::runtime_error("MetadataSnapshot: entities of a snapshot can not be modified");
+}
+
+
+/**
+ * Implementation of IProperty that is served from a snapshot.
+ */
+class PropertySnapshot : virtual public base::IProperty {
+
+    std::shared_ptr<const Tree> tree;
+    size_t index;
+
+    const PropertyNode &node() const {
+        tree->check();
+        return tree->properties[index];
+    }
+
+public:
+
+    PropertySnapshot(const std::shared_ptr<const Tree> &tree, size_t index)
+        : tree(tree), index(index)
+    {
+    }
+
+    std::string id() const { return node().id; }
+
+    time_t updatedAt() const { return node().updated_at; }
+
+    time_t createdAt() const { return node().created_at; }
+
+    void setUpdatedAt() { read_only(); }
+
+    void forceUpdatedAt() { read_only(); }
+
+    void setCreatedAt() { read_only(); }
+
+    void forceCreatedAt(time_t t) { read_only(); }
+
+    bool isValidEntity() const { return tree->current(); }
+
+    std::string name() const { return node().name; }
+
+    void definition(const std::string &definition) { read_only(); }
+
+    boost::optional<std::string> definition() const { return node().definition; }
+
+    void definition(const none_t t) { read_only(); }
+
+    void mapping(const std::string &mapping) { read_only(); }
+
+    boost::optional<std::string> mapping() const { return node().mapping; }
+
+    void mapping(const none_t t) { read_only(); }
+
+    DataType dataType() const { return node().data_type; }
+
+    void unit(const std::string &unit) { read_only(); }
+
+    boost::optional<std::string> unit() const { return node().unit; }
+
+    void unit(const none_t t) { read_only(); }
+
+    void deleteValues() { read_only(); }
+
+    ndsize_t valueCount() const { return node().values.size(); }
+
+    void values(const std::vector<Value> &values) { read_only(); }
+
+    std::vector<Value> values(void) const { return node().values; }
+
+    ValueColumn valueColumn() const { return ValueColumn(node().values); }
+
+    void values(const boost::none_t t) { read_only(); }
+};
+
+
+/**
+ * Implementation of ISection that is served from a snapshot.
+ */
+class SectionSnapshot : virtual public base::ISection {
+
+    std::shared_ptr<const Tree> tree;
+    size_t index;
+
+    const SectionNode &node() const {
+        tree->check();
+        return tree->sections[index];
+    }
+
+    std::shared_ptr<base::ISection> section(size_t i) const {
+        std::shared_ptr<base::ISection> sec;
+        if (i != npos) {
+            sec = std::make_shared<SectionSnapshot>(tree, i);
+        }
+        return sec;
+    }
+
+    size_t findChild(const std::string &name_or_id) const {
+        const SectionNode &n = node();
+        for (size_t i = n.first_child; i < n.first_child + n.child_count; i++) {
+            const SectionNode &child = tree->sections[i];
+            if (child.name == name_or_id || child.id == name_or_id) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    size_t findProperty(const std::string &name_or_id) const {
+        const SectionNode &n = node();
+        for (size_t i = n.first_property; i < n.first_property + n.property_count; i++) {
+            const PropertyNode &prop = tree->properties[i];
+            if (prop.name == name_or_id || prop.id == name_or_id) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+public:
+
+    SectionSnapshot(const std::shared_ptr<const Tree> &tree, size_t index)
+        : tree(tree), index(index)
+    {
+    }
+
+    std::string id() const { return node().id; }
+
+    time_t updatedAt() const { return node().updated_at; }
+
+    time_t createdAt() const { return node().created_at; }
+
+    void setUpdatedAt() { read_only(); }
+
+    void forceUpdatedAt() { read_only(); }
+
+    void setCreatedAt() { read_only(); }
+
+    void forceCreatedAt(time_t t) { read_only(); }
+
+    bool isValidEntity() const { return tree->current(); }
+
+    void type(const std::string &type) { read_only(); }
+
+    std::string type() const { return node().type; }
+
+    std::string name() const { return node().name; }
+
+    void definition(const std::string &definition) { read_only(); }
+
+    boost::optional<std::string> definition() const { return node().definition; }
+
+    void definition(const none_t t) { read_only(); }
+
+    int compare(const std::shared_ptr<base::INamedEntity> &other) const {
+        int cmp = 0;
+        if (!name().empty() && !other->name().empty()) {
+            cmp = name().compare(other->name());
+        }
+        if (cmp == 0) {
+            cmp = id().compare(other->id());
+        }
+        return cmp;
+    }
+
+    void repository(const std::string &repository) { read_only(); }
+
+    boost::optional<std::string> repository() const { return node().repository; }
+
+    void repository(const boost::none_t t) { read_only(); }
+
+    void link(const std::string &id) { read_only(); }
+
+    std::shared_ptr<base::ISection> link() const { return section(node().link); }
+
+    void link(const none_t t) { read_only(); }
+
+    void mapping(const std::string &mapping) { read_only(); }
+
+    boost::optional<std::string> mapping() const { return node().mapping; }
+
+    void mapping(const none_t t) { read_only(); }
+
+    std::shared_ptr<base::ISection> parent() const { return section(node().parent); }
+
+    ndsize_t sectionCount() const { return node().child_count; }
+
+    bool hasSection(const std::string &name_or_id) const { return findChild(name_or_id) != npos; }
+
+    std::shared_ptr<base::ISection> getSection(const std::string &name_or_id) const {
+        return section(findChild(name_or_id));
+    }
+
+    std::shared_ptr<base::ISection> getSection(ndsize_t index) const {
+        const SectionNode &n = node();
+        if (index >= n.child_count) {
+            throw OutOfBounds("Trying to access section with invalid index.", index);
+        }
+        return section(n.first_child + index);
+    }
+
+    std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type) { read_only(); }
+
+    bool deleteSection(const std::string &name_or_id) { read_only(); }
+
+    ndsize_t propertyCount() const { return node().property_count; }
+
+    bool hasProperty(const std::string &name_or_id) const { return findProperty(name_or_id) != npos; }
+
+    std::shared_ptr<base::IProperty> getProperty(const std::string &name_or_id) const {
+        std::shared_ptr<base::IProperty> prop;
+        size_t i = findProperty(name_or_id);
+        if (i != npos) {
+            prop = std::make_shared<PropertySnapshot>(tree, i);
+        }
+        return prop;
+    }
+
+    std::shared_ptr<base::IProperty> getProperty(ndsize_t index) const {
+        const SectionNode &n = node();
+        if (index >= n.property_count) {
+            throw OutOfBounds("Trying to access property with invalid index.", index);
+        }
+        return std::make_shared<PropertySnapshot>(tree, n.first_property + index);
+    }
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const DataType &dtype) { read_only(); }
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const Value &value) { read_only(); }
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const std::vector<Value> &values) { read_only(); }
+
+    bool deleteProperty(const std::string &name_or_id) { read_only(); }
+
+    std::map<std::string, std::vector<Value>> propertyValues(size_t max_depth) const {
+        std::map<std::string, std::vector<Value>> values;
+        collect(index, "", max_depth, values);
+        return values;
+    }
+
+private:
+
+    void collect(size_t i, const std::string &prefix, size_t depth,
+                 std::map<std::string, std::vector<Value>> &values) const {
+        tree->check();
+        const SectionNode &n = tree->sections[i];
+
+        for (size_t k = n.first_property; k < n.first_property + n.property_count; k++) {
+            values[prefix + tree->properties[k].name] = tree->properties[k].values;
+        }
+
+        if (depth > 0) {
+            for (size_t k = n.first_child; k < n.first_child + n.child_count; k++) {
+                collect(k, prefix + tree->sections[k].name + "/", depth - 1, values);
+            }
+        }
+    }
+};
+
+
+static SectionNode read_section(const Section &s, size_t parent) {
+    SectionNode n;
+    n.id = s.id();
+    n.name = s.name();
+    n.type = s.type();
+    n.definition = s.definition();
+    n.repository = s.repository();
+    n.mapping = s.mapping();
+    n.created_at = s.createdAt();
+    n.updated_at = s.updatedAt();
+    n.parent = parent;
+    n.link = npos;
+    n.first_child = n.child_count = 0;
+    n.first_property = n.property_count = 0;
+    return n;
+}
+
+
+static PropertyNode read_property(const Property &p) {
+    PropertyNode n;
+    n.id = p.id();
+    n.name = p.name();
+    n.definition = p.definition();
+    n.mapping = p.mapping();
+    n.unit = p.unit();
+    n.data_type = p.dataType();
+    n.values = p.values();
+    n.created_at = p.createdAt();
+    n.updated_at = p.updatedAt();
+    return n;
+}
+
+} // namespace snapshot
+
+
+MetadataSnapshot::MetadataSnapshot(const std::shared_ptr<base::IFile> &file) {
+    if (!file) {
+        throw UninitializedEntity();
+    }
+
+    auto t = std::make_shared<snapshot::Tree>();
+    t->file = file;
+    t->revision = file->revision();
+
+    // the handles of the sections of the file, parallel to t->sections
+    std::vector<Section> handles = File(file).sections();
+    std::vector<std::string> links;
+
+    t->root_count = handles.size();
+    for (const Section &s : handles) {
+        t->sections.push_back(snapshot::read_section(s, snapshot::npos));
+    }
+
+    // breadth first, so that the children of each section end up next to each other
+    for (size_t i = 0; i < handles.size(); i++) {
+        Section s = handles[i];
+
+        std::vector<Section> children = s.sections();
+        t->sections[i].first_child = t->sections.size();
+        t->sections[i].child_count = children.size();
+        for (const Section &child : children) {
+            t->sections.push_back(snapshot::read_section(child, i));
+            handles.push_back(child);
+        }
+
+        std::vector<Property> props = s.properties();
+        t->sections[i].first_property = t->properties.size();
+        t->sections[i].property_count = props.size();
+        for (const Property &p : props) {
+            t->properties.push_back(snapshot::read_property(p));
+        }
+
+        Section link = s.link();
+        links.push_back(link ? link.id() : "");
+    }
+
+    for (size_t i = 0; i < t->sections.size(); i++) {
+        t->section_ids.emplace(t->sections[i].id, i);
+    }
+
+    for (size_t i = 0; i < links.size(); i++) {
+        auto it = t->section_ids.find(links[i]);
+        if (it != t->section_ids.end()) {
+            t->sections[i].link = it->second;
+        }
+    }
+
+    tree = t;
+}
+
+
+bool MetadataSnapshot::isCurrent() const {
+    return tree && tree->current();
+}
+
+
+ndsize_t MetadataSnapshot::sectionCount() const {
+    return current().sections.size();
+}
+
+
+ndsize_t MetadataSnapshot::propertyCount() const {
+    return current().properties.size();
+}
+
+
+std::vector<Section> MetadataSnapshot::sections(const util::Filter<Section>::type &filter) const {
+    std::vector<Section> result;
+    for (size_t i = 0; i < current().root_count; i++) {
+        Section s(std::make_shared<snapshot::SectionSnapshot>(tree, i));
+        if (filter(s)) {
+            result.push_back(s);
+        }
+    }
+    return result;
+}
+
+
+Section MetadataSnapshot::getSection(const std::string &id) const {
+    Section s;
+    auto it = current().section_ids.find(id);
+    if (it != tree->section_ids.end()) {
+        s = Section(std::make_shared<snapshot::SectionSnapshot>(tree, it->second));
+    }
+    return s;
+}
+
+
+std::vector<Section> MetadataSnapshot::findSections(const util::Filter<Section>::type &filter,
+                                                    size_t max_depth) const
+{
+    std::vector<Section> results;
+    for (const Section &root : sections()) {
+        std::vector<Section> found = root.findSections(filter, max_depth);
+        results.insert(results.end(), found.begin(), found.end());
+    }
+    return results;
+}
+
+
+const snapshot::Tree &MetadataSnapshot::current() const {
+    if (!tree) {
+        throw UninitializedEntity();
+    }
+    tree->check();
+    return *tree;
+}
+
+} // namespace nix
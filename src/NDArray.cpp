@@ -12,24 +12,38 @@
 namespace nix {
 
 
+const size_t NDArray::alignment;
+
+
 NDArray::NDArray(DataType dtype, NDSize dims) : dataType(dtype), extends(dims) {
-    allocate_space();
+    allocate_space(Init::Zero);
+}
+
+
+NDArray::NDArray(DataType dtype, NDSize dims, Init init) : dataType(dtype), extends(dims) {
+    allocate_space(init);
 }
 
 
-void NDArray::allocate_space() {
+void NDArray::allocate_space(Init init) {
     size_t type_size = data_type_to_size(dataType);
 	ndsize_t bytes = extends.nelms() * type_size;
 	size_t alloc_size = check::fits_in_size_t(bytes, "Cannot allocate storage (exceeds memory)");
+
+    // the allocator does not initialize the bytes, only new ones are zeroed
+    size_t old_size = dstore.size();
     dstore.resize(alloc_size);
+    if (init == Init::Zero && alloc_size > old_size) {
+        memset(dstore.data() + old_size, 0, alloc_size - old_size);
+    }
 
     calc_strides();
 }
 
 
-void NDArray::resize(const NDSize &new_size) {
+void NDArray::resize(const NDSize &new_size, Init init) {
     extends = new_size;
-    allocate_space();
+    allocate_space(init);
 }
 
 
@@ -52,4 +66,11 @@ size_t NDArray::sub2index(const NDSize &sub) const {
     return idx;
 }
 
+
+void NDArray::check_view_type(DataType dtype) const {
+    if (dtype != dataType) {
+        throw std::invalid_argument("NDArray::view: Type does not match the data type of the array");
+    }
+}
+
 } // namespace nix
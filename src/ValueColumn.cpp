@@ -0,0 +1,190 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/ValueColumn.hpp>
+
+#include <nix/Exception.hpp>
+
+#include <cassert>
+
+using namespace std;
+
+namespace nix {
+
+
+const size_t ValueColumn::text_fields;
+
+
+ValueColumn::ValueColumn(DataType dtype)
+    : dtype(dtype), arena(1, '\0')
+{
+    if (!Value::supports_type(dtype)) {
+        throw std::invalid_argument("Unsupported DataType");
+    }
+}
+
+
+ValueColumn::ValueColumn(const vector<Value> &values)
+    : ValueColumn()
+{
+    reserve(values.size());
+    for (const Value &value : values) {
+        push_back(value);
+    }
+}
+
+
+void ValueColumn::reserve(size_t count, size_t text_bytes) {
+    size_t value_size = dtype == DataType::String ? sizeof(size_t) :
+                        dtype == DataType::Nothing ? 0 : data_type_to_size(dtype);
+
+    value_data.reserve(count * value_size);
+    uncertainty_data.reserve(count);
+    text_offsets.reserve(count * text_fields);
+    arena.reserve(text_bytes + 1);
+}
+
+
+void ValueColumn::push_back(const Value &value) {
+    const char *reference = value.reference.c_str();
+    const char *filename = value.filename.c_str();
+    const char *encoder = value.encoder.c_str();
+    const char *checksum = value.checksum.c_str();
+
+    switch (value.type()) {
+        case DataType::Bool:
+            append(value.get<bool>(), value.uncertainty, reference, filename, encoder, checksum);
+            break;
+        case DataType::Int32:
+            append(value.get<int32_t>(), value.uncertainty, reference, filename, encoder, checksum);
+            break;
+        case DataType::UInt32:
+            append(value.get<uint32_t>(), value.uncertainty, reference, filename, encoder, checksum);
+            break;
+        case DataType::Int64:
+            append(value.get<int64_t>(), value.uncertainty, reference, filename, encoder, checksum);
+            break;
+        case DataType::UInt64:
+            append(value.get<uint64_t>(), value.uncertainty, reference, filename, encoder, checksum);
+            break;
+        case DataType::Double:
+            append(value.get<double>(), value.uncertainty, reference, filename, encoder, checksum);
+            break;
+        case DataType::String:
+            append(value.get<const char *>(), value.uncertainty, reference, filename, encoder, checksum);
+            break;
+        case DataType::Nothing:
+            append(none, value.uncertainty, reference, filename, encoder, checksum);
+            break;
+        default:
+            throw std::invalid_argument("Unsupported DataType");
+    }
+}
+
+
+void ValueColumn::append(const char *value, double uncertainty, const char *reference, const char *filename,
+                         const char *encoder, const char *checksum) {
+    adopt_type(DataType::String);
+    size_t offset = store(value);
+    append_raw(&offset, sizeof(offset));
+    append_text(uncertainty, reference, filename, encoder, checksum);
+}
+
+
+void ValueColumn::append(none_t, double uncertainty, const char *reference, const char *filename,
+                         const char *encoder, const char *checksum) {
+    adopt_type(DataType::Nothing);
+    append_text(uncertainty, reference, filename, encoder, checksum);
+}
+
+
+const char *ValueColumn::string(size_t index) const {
+    check_index(index);
+    if (dtype != DataType::String) {
+        throw std::invalid_argument("Incompatible DataType");
+    }
+    size_t offset;
+    memcpy(&offset, value_data.data() + index * sizeof(size_t), sizeof(size_t));
+    return arena.data() + offset;
+}
+
+
+Value ValueColumn::value(size_t index) const {
+    Value value;
+
+    switch (dtype) {
+        case DataType::Bool:    value.set(get<bool>(index));     break;
+        case DataType::Int32:   value.set(get<int32_t>(index));  break;
+        case DataType::UInt32:  value.set(get<uint32_t>(index)); break;
+        case DataType::Int64:   value.set(get<int64_t>(index));  break;
+        case DataType::UInt64:  value.set(get<uint64_t>(index)); break;
+        case DataType::Double:  value.set(get<double>(index));   break;
+        case DataType::String:  value.set(string(index));        break;
+        case DataType::Nothing: check_index(index);              break;
+        default: assert(false);
+    }
+
+    value.uncertainty = uncertainty_data[index];
+    value.reference = reference(index);
+    value.filename = filename(index);
+    value.encoder = encoder(index);
+    value.checksum = checksum(index);
+    return value;
+}
+
+
+vector<Value> ValueColumn::toValues() const {
+    vector<Value> values;
+    values.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+        values.push_back(value(i));
+    }
+    return values;
+}
+
+
+void ValueColumn::adopt_type(DataType type) {
+    if (type == dtype) {
+        return;
+    }
+    if (dtype != DataType::Nothing || !empty()) {
+        throw std::invalid_argument("Incompatible DataType");
+    }
+    dtype = type;
+}
+
+
+void ValueColumn::append_text(double uncertainty, const char *reference, const char *filename,
+                              const char *encoder, const char *checksum) {
+    uncertainty_data.push_back(uncertainty);
+    text_offsets.push_back(store(reference));
+    text_offsets.push_back(store(filename));
+    text_offsets.push_back(store(encoder));
+    text_offsets.push_back(store(checksum));
+}
+
+
+size_t ValueColumn::store(const char *str) {
+    // empty strings all share the null at the start of the arena
+    if (str == nullptr || *str == '\0') {
+        return 0;
+    }
+    size_t offset = arena.size();
+    arena.insert(arena.end(), str, str + strlen(str) + 1);
+    return offset;
+}
+
+
+void ValueColumn::check_index(size_t index) const {
+    if (index >= size()) {
+        throw OutOfBounds("ValueColumn: Index out of bounds", index);
+    }
+}
+
+
+} // namespace nix
@@ -13,13 +13,19 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 
 namespace nix {
 
+const size_t Variant::small_capacity;
+
 void Variant::maybe_deallocte_string() {
     if (dtype == DataType::String) {
-        std::free(v_string);
+        if (!is_small) {
+            std::free(v_string);
+        }
         dtype = DataType::Nothing;
+        is_small = false;
     }
 }
 
@@ -80,20 +86,29 @@ void Variant::set(const std::string &value) {
 }
 
 void Variant::set(const char *value, const size_t len) {
-
-    const size_t len_plus_null = len + 1;
-    void *data;
-
-    if (dtype != DataType::String) {
-        dtype = DataType::String;
-        data = std::malloc(len_plus_null);
+    // value may point into the current string, so it is copied
+    // before the old string is released
+    if (len <= small_capacity) {
+        char buffer[small_capacity + 1];
+        if (len > 0) {
+            std::memcpy(buffer, value, len);
+        }
+        maybe_deallocte_string();
+        std::memcpy(v_small, buffer, len);
+        v_small[len] = '\0';
+        is_small = true;
     } else {
-        data = std::realloc(v_string, len_plus_null);
+        char *data = static_cast<char *>(std::malloc(len + 1));
+        if (data == nullptr) {
+            throw std::bad_alloc();
+        }
+        std::memcpy(data, value, len);
+        data[len] = '\0';
+        maybe_deallocte_string();
+        v_string = data;
     }
 
-    std::memcpy(data, value, len);
-    v_string = static_cast<char *>(data);
-    v_string[len] = '\0';
+    dtype = DataType::String;
 }
 
 void Variant::set(const char *value) {
@@ -140,7 +155,7 @@ void Variant::get(double &value) const {
 
 void Variant::get(std::string &value) const {
     check_argument_type(DataType::String);
-    value = v_string;
+    value = str();
 }
 
 /* swap and swap helpers */
@@ -152,12 +167,24 @@ void Variant::get(std::string &value) const {
 
 #define DATATYPE_SUPPORT_NOT_IMPLEMENTED false
 
-void Variant::swap(Variant &other) {
+void Variant::swap(Variant &other) NOEXCEPT {
     Variant tmp(std::move(*this));
-    assign_variant_from(other);
+    *this = std::move(other);
     other = std::move(tmp);
 }
 
+void Variant::steal(Variant &other) NOEXCEPT {
+    // the union is copied as a whole, which moves both small strings
+    // and the pointer to heap strings; other is left empty
+    dtype = other.dtype;
+    is_small = other.is_small;
+    std::memcpy(v_small, other.v_small, sizeof(v_small));
+
+    other.dtype = DataType::Nothing;
+    other.is_small = false;
+    other.v_bool = false;
+}
+
 void Variant::assign_variant_from(const Variant &other) {
     switch (other.dtype) {
         case DataType::Bool:    set(other.v_bool);   break;
@@ -166,7 +193,7 @@ void Variant::assign_variant_from(const Variant &other) {
         case DataType::Int64:   set(other.v_int64);  break;
         case DataType::UInt64:  set(other.v_uint64); break;
         case DataType::Double:  set(other.v_double); break;
-        case DataType::String:  set(other.v_string); break;
+        case DataType::String:  set(other.str());    break;
         case DataType::Nothing: set(none);           break;
 
 #ifndef CHECK_SUPPORTED_VALUES
@@ -254,7 +281,7 @@ bool operator==(const Variant &a, const Variant &b)
         case DataType::Int64:  return a.get<int64_t>() == b.get<int64_t>();
         case DataType::UInt64: return a.get<uint64_t>() == b.get<uint64_t>();
         case DataType::Double: return a.get<double>() == b.get<double>();
-        case DataType::String: return a.get<std::string>() == b.get<std::string>();
+        case DataType::String: return std::strcmp(a.get<const char *>(), b.get<const char *>()) == 0;
 #ifndef CHECK_SUPPORTED_VALUES
         default: assert(DATATYPE_SUPPORT_NOT_IMPLEMENTED); return false;
 #endif
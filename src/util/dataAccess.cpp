@@ -23,72 +23,122 @@ namespace nix {
 namespace util {
 
 
-int positionToIndex(double position, const string &unit, const Dimension &dimension) {
-    size_t pos;
-    if (dimension.dimensionType() == nix::DimensionType::Sample) {
-        SampledDimension dim;
-        dim = dimension;
-        pos = positionToIndex(position, unit, dim);
-    } else if (dimension.dimensionType() == nix::DimensionType::Set) {
-        SetDimension dim;
-        dim = dimension;
-        pos = positionToIndex(position, unit, dim);
-    } else {
-        RangeDimension dim;
-        dim = dimension;
-        pos = positionToIndex(position, unit, dim);
+namespace {
+
+/*
+ * Converts positions given in one unit into indices of a dimension; the
+ * dimension descriptor is read once, so that many positions can be
+ * converted at the cost of one. Range dimensions look up all positions
+ * with a single batched indexOf. All positionToIndex overloads use it.
+ */
+class PositionIndexer {
+
+public:
+
+    PositionIndexer(const Dimension &dimension, const string &unit)
+        : type(dimension.dimensionType()), scaling(1.0), offset(0.0), interval(1.0), label_count(0)
+    {
+        if (type == DimensionType::Sample) {
+            SampledDimension dim;
+            dim = dimension;
+            boost::optional<string> dim_unit = dim.unit();
+            if (!dim_unit && unit != "none") {
+                throw nix::IncompatibleDimensions("Units of position and SampledDimension must both be given!", "nix::util::positionToIndex");
+            }
+            if (dim_unit && unit != "none") {
+                try {
+                    scaling = util::getSIScaling(unit, *dim_unit);
+                } catch (...) {
+                    throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "nix::util::positionToIndex");
+                }
+            }
+            boost::optional<double> dim_offset = dim.offset();
+            offset = dim_offset ? *dim_offset : 0.0;
+            interval = dim.samplingInterval();
+        } else if (type == DimensionType::Set) {
+            if (unit.length() > 0 && unit != "none") {
+                throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "nix::util::positionToIndex");
+            }
+            SetDimension dim;
+            dim = dimension;
+            label_count = dim.labels().size();
+        } else {
+            range = dimension;
+            boost::optional<string> dim_unit = range.unit();
+            if (dim_unit && unit != "none") {
+                try {
+                    scaling = util::getSIScaling(unit, *dim_unit);
+                } catch (...) {
+                    throw nix::IncompatibleDimensions("Provided units are not scalable!", "nix::util::positionToIndex");
+                }
+            }
+        }
+    }
+
+    vector<ndsize_t> indices(const vector<double> &positions) const {
+        vector<ndsize_t> result(positions.size());
+        if (type == DimensionType::Range) {
+            vector<double> scaled(positions.size());
+            for (size_t i = 0; i < positions.size(); ++i) {
+                scaled[i] = positions[i] * scaling;
+            }
+            vector<size_t> found = range.indexOf(scaled);
+            std::copy(found.begin(), found.end(), result.begin());
+        } else {
+            for (size_t i = 0; i < positions.size(); ++i) {
+                result[i] = index(positions[i]);
+            }
+        }
+        return result;
+    }
+
+    ndsize_t index(double position) const {
+        if (type == DimensionType::Range) {
+            return range.indexOf(position * scaling);
+        }
+        if (type == DimensionType::Sample) {
+            ssize_t index = static_cast<ssize_t>(round((position * scaling - offset) / interval));
+            if (index < 0) {
+                throw nix::OutOfBounds("Position is out of bounds of this dimension!", 0);
+            }
+            return static_cast<ndsize_t>(index);
+        }
+        size_t index = static_cast<size_t>(round(position));
+        if (label_count > 0 && index > label_count) {
+            throw nix::OutOfBounds("Position is out of bounds in setDimension.", static_cast<int>(position));
+        }
+        return index;
     }
 
+private:
+
+    DimensionType type;
+    double scaling, offset, interval;
+    RangeDimension range;
+    size_t label_count;
+};
+
+} // anonymous namespace
+
+
+int positionToIndex(double position, const string &unit, const Dimension &dimension) {
+    size_t pos = PositionIndexer(dimension, unit).index(position);
     return static_cast<int>(pos); //FIXME: int, really? 
 }
 
 
 size_t positionToIndex(double position, const string &unit, const SampledDimension &dimension) {
-    size_t index;
-    boost::optional<string> dim_unit = dimension.unit();
-    double scaling = 1.0;
-    if (!dim_unit && unit != "none") {
-        throw nix::IncompatibleDimensions("Units of position and SampledDimension must both be given!", "nix::util::positionToIndex");
-    }
-    if (dim_unit && unit != "none") {
-        try {
-            scaling = util::getSIScaling(unit, *dim_unit);
-        } catch (...) {
-            throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "nix::util::positionToIndex");
-        }
-    }
-    index = dimension.indexOf(position * scaling); 
-    return index;
+    return PositionIndexer(dimension, unit).index(position);
 }
 
 
 size_t positionToIndex(double position, const string &unit, const SetDimension &dimension) {
-    size_t index;
-    if (unit.length() > 0 && unit != "none") {
-        // TODO check here for the content
-        // convert unit and the go looking for it, see range dimension
-        throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "nix::util::positionToIndex");
-    }
-    index = static_cast<size_t>(round(position));
-    if (dimension.labels().size() > 0 && index > dimension.labels().size()) {
-        throw nix::OutOfBounds("Position is out of bounds in setDimension.", static_cast<int>(position));
-    }
-    return index;
+    return PositionIndexer(dimension, unit).index(position);
 }
 
 
 size_t positionToIndex(double position, const string &unit, const RangeDimension &dimension) {
-    boost::optional<string> dim_unit = dimension.unit();
-    double scaling = 1.0;
-
-    if (dim_unit && unit != "none") {
-        try {
-            scaling = util::getSIScaling(unit, *dim_unit);
-        } catch (...) {
-            throw nix::IncompatibleDimensions("Provided units are not scalable!", "nix::util::positionToIndex");
-        }
-    }
-    return dimension.indexOf(position * scaling);
+    return PositionIndexer(dimension, unit).index(position);
 }
 
 
@@ -102,11 +152,17 @@ void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &offset, N
     if (array.dimensionCount() != position.size() || (extent.size() > 0 && extent.size() != array.dimensionCount())) {
         throw std::runtime_error("Dimensionality of position or extent vector does not match dimensionality of data!");
     }
+    vector<Dimension> dimensions = array.dimensions();
     for (size_t i = 0; i < position.size(); ++i) {
-        Dimension dim = array.getDimension(i+1);
-        temp_offset[i] = positionToIndex(position[i], i >= units.size() ? "none" : units[i], dim);
+        PositionIndexer indexer(dimensions[i], i >= units.size() ? "none" : units[i]);
+        vector<double> positions = {position[i]};
+        if (i < extent.size()) {
+            positions.push_back(position[i] + extent[i]);
+        }
+        vector<ndsize_t> index = indexer.indices(positions);
+        temp_offset[i] = index[0];
         if (i < extent.size()) {
-            ndsize_t c = positionToIndex(position[i] + extent[i], i >= units.size() ? "none" : units[i], dim) - temp_offset[i];
+            ndsize_t c = index[1] - temp_offset[i];
             temp_count[i] = (c > 1) ? c : 1;
         }
     }
@@ -115,7 +171,16 @@ void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &offset, N
 }
 
 
-void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_t index, NDSize &offsets, NDSize &counts) {
+namespace {
+
+/*
+ * Offsets and counts of the given positions of a multi tag in the array,
+ * one row of rank values per position. Only the rows of the positions and
+ * extents between the smallest and the largest index are read, and all
+ * dimension descriptors and units are read once.
+ */
+size_t offsets_and_counts(const MultiTag &tag, const DataArray &array, const vector<size_t> &indices,
+                          vector<ndsize_t> &offsets, vector<ndsize_t> &counts) {
     DataArray positions = tag.positions();
     DataArray extents = tag.extents();
     NDSize position_size, extent_size;
@@ -129,16 +194,19 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_t index
         extent_size = extents.dataExtent();
     }
 
-    if (!positions || index >= position_size[0]) {
+    size_t first = indices.empty() ? 0 : *std::min_element(indices.begin(), indices.end());
+    size_t last = indices.empty() ? 0 : *std::max_element(indices.begin(), indices.end());
+
+    if (!positions || (!indices.empty() && last >= position_size[0])) {
         throw nix::OutOfBounds("Index out of bounds of positions!", 0);
     }
 
-    if (extents && index >= extent_size[0]) {
+    if (extents && !indices.empty() && last >= extent_size[0]) {
         throw nix::OutOfBounds("Index out of bounds of positions or extents!", 0);
     }
-    
+
     if (position_size.size() == 1 && dimension_count != 1) {
-        throw nix::IncompatibleDimensions("Number of dimensions in positions does not match dimensionality of data", 
+        throw nix::IncompatibleDimensions("Number of dimensions in positions does not match dimensionality of data",
                                           "util::getOffsetAndCount");
     }
 
@@ -146,107 +214,163 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_t index
         throw nix::IncompatibleDimensions("Number of dimensions in positions does not match dimensionality of data",
                                           "util::getOffsetAndCount");
     }
-    
+
     if (extents && extent_size.size() > 1 && extent_size[1] > dimension_count) {
         throw nix::IncompatibleDimensions("Number of dimensions in extents does not match dimensionality of data",
                                           "util::getOffsetAndCount");
     }
 
-    NDSize temp_offset = NDSize{static_cast<NDSize::value_type>(index), static_cast<NDSize::value_type>(0)};
-    NDSize temp_count{static_cast<NDSize::value_type>(1), static_cast<NDSize::value_type>(dimension_count)};
-    vector<double> offset;
-    positions.getData(offset, temp_count, temp_offset);
+    size_t rank = check::fits_in_size_t(dimension_count, "getOffsetAndCount() failed; dimension count > size_t.");
+    offsets.assign(indices.size() * rank, 0);
+    counts.assign(indices.size() * rank, 1);
+    if (indices.empty()) {
+        return rank;
+    }
+
+    size_t rows = last - first + 1;
+    auto read_rows = [first, rows](const DataArray &da, const NDSize &size, size_t &columns) {
+        columns = size.size() > 1 ? static_cast<size_t>(size[1]) : 1;
+        vector<double> values(rows * columns);
+        NDSize count = size.size() > 1 ? NDSize({rows, columns}) : NDSize({rows});
+        NDSize offset = size.size() > 1 ? NDSize({first, static_cast<size_t>(0)}) : NDSize({first});
+        da.getDataDirect(DataType::Double, values.data(), count, offset);
+        return values;
+    };
 
-    size_t dc_sizet = check::fits_in_size_t(dimension_count, "getOffsetAndCount() failed; dimension count > size_t.");
-    NDSize data_offset(dc_sizet, static_cast<ndsize_t>(0));
-    NDSize data_count(dc_sizet, static_cast<ndsize_t>(1));
+    size_t p_columns = 0, e_columns = 0;
+    vector<double> position_values = read_rows(positions, position_size, p_columns);
+    vector<double> extent_values;
+    if (extents) {
+        extent_values = read_rows(extents, extent_size, e_columns);
+    }
+
+    vector<Dimension> dimensions = array.dimensions();
     vector<string> units = tag.units();
-    
-    for (size_t i = 0; i < offset.size(); ++i) {
-        Dimension dimension = array.getDimension(i+1);
-        string unit = "none";
-        if (i <= units.size() && units.size() > 0) {
-            unit = units[i];
+    vector<PositionIndexer> indexers;
+    for (size_t i = 0; i < std::max(p_columns, e_columns); ++i) {
+        indexers.emplace_back(dimensions[i], i < units.size() ? units[i] : "none");
+    }
+
+    vector<double> values(indices.size());
+    for (size_t i = 0; i < p_columns; ++i) {
+        for (size_t k = 0; k < indices.size(); ++k) {
+            values[k] = position_values[(indices[k] - first) * p_columns + i];
+        }
+        vector<ndsize_t> index = indexers[i].indices(values);
+        for (size_t k = 0; k < indices.size(); ++k) {
+            offsets[k * rank + i] = index[k];
         }
-        data_offset[i] = positionToIndex(offset[i], unit, dimension);
     }
-    
-    if (extents) {
-        vector<double> extent;
-        extents.getData(extent, temp_count, temp_offset);
-        for (size_t i = 0; i < extent.size(); ++i) {
-            Dimension dimension = array.getDimension(i+1);
-            string unit = "none";
-            if (i <= units.size() && units.size() > 0) {
-                unit = units[i];
-            }
-            ndsize_t c = positionToIndex(offset[i] + extent[i], unit, dimension) - data_offset[i];
-            data_count[i] = (c > 1) ? c : 1;
+
+    for (size_t i = 0; i < e_columns; ++i) {
+        for (size_t k = 0; k < indices.size(); ++k) {
+            size_t row = indices[k] - first;
+            double position = i < p_columns ? position_values[row * p_columns + i] : 0.0;
+            values[k] = position + extent_values[row * e_columns + i];
+        }
+        vector<ndsize_t> end = indexers[i].indices(values);
+        for (size_t k = 0; k < indices.size(); ++k) {
+            ndsize_t offset = offsets[k * rank + i];
+            counts[k * rank + i] = end[k] > offset + 1 ? end[k] - offset : 1;
         }
     }
 
-    offsets = data_offset;
-    counts = data_count;
+    return rank;
 }
 
 
-bool positionInData(const DataArray &data, const NDSize &position) {
-    NDSize data_size = data.dataExtent();
-    bool valid = true;
+NDSize row(const vector<ndsize_t> &values, size_t k, size_t rank) {
+    return NDSize(vector<ndsize_t>(values.begin() + k * rank, values.begin() + (k + 1) * rank));
+}
 
-    if (!(data_size.size() == position.size())) {
+
+bool position_in_extent(const NDSize &data_size, const NDSize &position) {
+    if (data_size.size() != position.size()) {
         return false;
     }
     for (size_t i = 0; i < data_size.size(); i++) {
-        valid &= position[i] < data_size[i];
+        if (position[i] >= data_size[i]) {
+            return false;
+        }
     }
-    return valid;
+    return true;
 }
 
 
-bool positionAndExtentInData(const DataArray &data, const NDSize &position, const NDSize &count) {
-    NDSize pos = position + count;
+bool slice_in_extent(const NDSize &data_size, const NDSize &offset, const NDSize &count) {
+    NDSize pos = offset + count;
     pos -= 1;
-    return positionInData(data, pos);
+    return position_in_extent(data_size, pos);
 }
 
 
-DataView retrieveData(const MultiTag &tag, size_t position_index, size_t reference_index) {
-    DataArray positions = tag.positions();
-    DataArray extents = tag.extents();
-    vector<DataArray> refs = tag.references();
+vector<DataView> tagged_views(const MultiTag &tag, const DataArray &array, const vector<size_t> &indices,
+                              const string &error) {
+    vector<ndsize_t> offsets, counts;
+    size_t rank = offsets_and_counts(tag, array, indices, offsets, counts);
+    NDSize data_size = array.dataExtent();
 
-    if (refs.size() == 0) { // Do I need this?
-        throw nix::OutOfBounds("There are no references in this tag!", 0);
-    }
-    if (position_index >= positions.dataExtent()[0] ||
-        (extents && position_index >= extents.dataExtent()[0])) {
-        throw nix::OutOfBounds("Index out of bounds of positions or extents!", 0);
-    }
-    if (!(reference_index < tag.referenceCount())) {
-        throw nix::OutOfBounds("Reference index out of bounds.", 0);
+    vector<DataView> views;
+    views.reserve(indices.size());
+    for (size_t k = 0; k < indices.size(); ++k) {
+        NDSize offset = row(offsets, k, rank);
+        NDSize count = row(counts, k, rank);
+        if (!slice_in_extent(data_size, offset, count)) {
+            throw nix::OutOfBounds(error, 0);
+        }
+        views.emplace_back(array, count, offset);
     }
+    return views;
+}
 
-    ndsize_t dimension_count = refs[reference_index].dimensionCount();
-    if (positions.dataExtent().size() == 1 && dimension_count != 1) {
-        throw nix::IncompatibleDimensions("Number of dimensions in position or extent do not match dimensionality of data",
-                                          "util::retrieveData");
-    } else if (positions.dataExtent().size() > 1) {
-        if (positions.dataExtent()[1] > dimension_count ||
-            (extents && extents.dataExtent()[1] > dimension_count)) {
-            throw nix::IncompatibleDimensions("Number of dimensions in position or extent do not match dimensionality of data",
-                                              "util::retrieveData");
-        }
+} // anonymous namespace
+
+
+void getOffsetAndCount(const MultiTag &tag, const DataArray &array, size_t index, NDSize &offsets, NDSize &counts) {
+    vector<ndsize_t> offset, count;
+    size_t rank = offsets_and_counts(tag, array, {index}, offset, count);
+    offsets = row(offset, 0, rank);
+    counts = row(count, 0, rank);
+}
+
+
+void getOffsetsAndCounts(const MultiTag &tag, const DataArray &array, vector<ndsize_t> &offsets, vector<ndsize_t> &counts) {
+    DataArray positions = tag.positions();
+    size_t n = positions ? check::fits_in_size_t(positions.dataExtent()[0], "getOffsetsAndCounts() failed; too many positions.") : 0;
+    vector<size_t> indices(n);
+    for (size_t i = 0; i < n; ++i) {
+        indices[i] = i;
     }
+    offsets_and_counts(tag, array, indices, offsets, counts);
+}
 
-    NDSize offset, count;
-    getOffsetAndCount(tag, refs[reference_index], position_index, offset, count);
 
-    if (!positionAndExtentInData(refs[reference_index], offset, count)) {
-        throw nix::OutOfBounds("References data slice out of the extent of the DataArray!", 0);
+bool positionInData(const DataArray &data, const NDSize &position) {
+    return position_in_extent(data.dataExtent(), position);
+}
+
+
+bool positionAndExtentInData(const DataArray &data, const NDSize &position, const NDSize &count) {
+    return slice_in_extent(data.dataExtent(), position, count);
+}
+
+
+DataView retrieveData(const MultiTag &tag, size_t position_index, size_t reference_index) {
+    return retrieveData(tag, vector<size_t>{position_index}, reference_index)[0];
+}
+
+
+vector<DataView> retrieveData(const MultiTag &tag, const vector<size_t> &position_indices, size_t reference_index) {
+    ndsize_t reference_count = tag.referenceCount();
+    if (reference_count == 0) {
+        throw nix::OutOfBounds("There are no references in this tag!", 0);
     }
-    DataView io = DataView(refs[reference_index], count, offset);
-    return io;
+    if (!(reference_index < reference_count)) {
+        throw nix::OutOfBounds("Reference index out of bounds.", 0);
+    }
+
+    DataArray reference = tag.getReference(reference_index);
+    return tagged_views(tag, reference, position_indices, "References data slice out of the extent of the DataArray!");
 }
 
 
@@ -305,6 +429,11 @@ DataView retrieveFeatureData(const Tag &tag, size_t feature_index) {
 
 
 DataView retrieveFeatureData(const MultiTag &tag, size_t position_index, size_t feature_index) {
+    return retrieveFeatureData(tag, vector<size_t>{position_index}, feature_index)[0];
+}
+
+
+vector<DataView> retrieveFeatureData(const MultiTag &tag, const vector<size_t> &position_indices, size_t feature_index) {
     if (tag.featureCount() == 0) {
        throw nix::OutOfBounds("There are no features associated with this tag!", 0);
     }
@@ -315,38 +444,33 @@ DataView retrieveFeatureData(const MultiTag &tag, size_t position_index, size_t
     DataArray data = feat.data();
     if (data == nix::none) {
         throw nix::UninitializedEntity();
-        //return NDArray(nix::DataType::Float,{0});
     }
     if (feat.linkType() == nix::LinkType::Tagged) {
-        NDSize offset, count;
-        getOffsetAndCount(tag, data, position_index, offset, count);
-        
-        if (!positionAndExtentInData(data, offset, count)) {
-            throw nix::OutOfBounds("Requested data slice out of the extent of the Feature!", 0);
-        }
-        DataView io = DataView(data, count, offset);
-        return io;
-    } else if (feat.linkType() == nix::LinkType::Indexed) {
-        //FIXME does the feature data to have a setdimension in the first dimension for the indexed case?
-        //For now it will just be a slice across the first dim.
-        if (position_index > data.dataExtent()[0]){
-            throw nix::OutOfBounds("Position is larger than the data stored in the feature.", 0);
-        }
-        NDSize offset(data.dataExtent().size(), 0);
-        offset[0] = position_index;
-        NDSize count(data.dataExtent());
-        count[0] = 1;
-        
-        if (!positionAndExtentInData(data, offset, count)) {
-            throw nix::OutOfBounds("Requested data slice out of the extent of the Feature!", 0);
+        return tagged_views(tag, data, position_indices, "Requested data slice out of the extent of the Feature!");
+    }
+
+    NDSize data_size = data.dataExtent();
+    vector<DataView> views;
+    views.reserve(position_indices.size());
+    for (size_t position_index : position_indices) {
+        NDSize offset(data_size.size(), 0);
+        NDSize count(data_size);
+        if (feat.linkType() == nix::LinkType::Indexed) {
+            //FIXME does the feature data to have a setdimension in the first dimension for the indexed case?
+            //For now it will just be a slice across the first dim.
+            if (position_index > data_size[0]) {
+                throw nix::OutOfBounds("Position is larger than the data stored in the feature.", 0);
+            }
+            offset[0] = position_index;
+            count[0] = 1;
+            if (!slice_in_extent(data_size, offset, count)) {
+                throw nix::OutOfBounds("Requested data slice out of the extent of the Feature!", 0);
+            }
         }
-        DataView io = DataView(data, count, offset);
-        return io;
+        // FIXME is this expected behavior? In the untagged case all data is returned
+        views.emplace_back(data, count, offset);
     }
-    // FIXME is this expected behavior? In the untagged case all data is returned
-    NDSize offset(data.dataExtent().size(), 0);
-    DataView io = DataView(data, data.dataExtent(), offset);
-    return io;
+    return views;
 }
 
 
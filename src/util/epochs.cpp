@@ -0,0 +1,412 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/epochs.hpp>
+
+#include <nix/util/util.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+
+using namespace std;
+
+namespace nix {
+namespace util {
+
+
+namespace {
+
+/*
+ * Largest number of elements that is read at once when windows are merged.
+ */
+const ndsize_t max_read = 1 << 22;
+
+
+struct Window {
+    size_t epoch;
+    int64_t start;
+};
+
+
+/*
+ * Scaling from the unit of the tag to the unit of the sampled dimension,
+ * like positionToIndex does it.
+ */
+double unit_scaling(const SampledDimension &dim, const string &unit) {
+    boost::optional<string> dim_unit = dim.unit();
+    if (!dim_unit && unit != "none") {
+        throw nix::IncompatibleDimensions("Units of position and SampledDimension must both be given!", "nix::util::EpochExtractor");
+    }
+    if (dim_unit && unit != "none") {
+        try {
+            return util::getSIScaling(unit, *dim_unit);
+        } catch (...) {
+            throw nix::IncompatibleDimensions("Provided units are not scalable!", "nix::util::EpochExtractor");
+        }
+    }
+    return 1.0;
+}
+
+} // namespace
+
+
+EpochExtractor::EpochExtractor(const MultiTag &tag, double pre, double post)
+    : tag(tag), pre(pre), post(post), apply_calibration(false), subtract_baseline(false),
+      baseline_start(0.0), baseline_end(0.0), have_max_gap(false), max_gap(0)
+{
+    if (!(pre + post > 0)) {
+        throw std::invalid_argument("EpochExtractor: The window must have a positive length!");
+    }
+}
+
+
+EpochExtractor &EpochExtractor::calibrate(bool apply) {
+    apply_calibration = apply;
+    return *this;
+}
+
+
+EpochExtractor &EpochExtractor::baseline(double start, double end) {
+    if (!(start < end)) {
+        throw std::invalid_argument("EpochExtractor: The baseline start must be before its end!");
+    }
+    subtract_baseline = true;
+    baseline_start = start;
+    baseline_end = end;
+    return *this;
+}
+
+
+EpochExtractor &EpochExtractor::maxGap(ndsize_t samples) {
+    have_max_gap = true;
+    max_gap = samples;
+    return *this;
+}
+
+
+NDArray EpochExtractor::extract(size_t reference_index) const {
+    if (!(reference_index < tag.referenceCount())) {
+        throw nix::OutOfBounds("Reference index out of bounds.", 0);
+    }
+    return extract(tag.getReference(reference_index));
+}
+
+
+NDArray EpochExtractor::extract(const DataArray &array) const {
+    return extract(array, allEvents());
+}
+
+
+NDArray EpochExtractor::extract(const DataArray &array, const vector<size_t> &events) const {
+    Layout l = layout(array);
+    ndsize_t stride = l.window * l.channels;
+
+    NDArray result(DataType::Double, NDSize({static_cast<ndsize_t>(events.size()), l.window, l.channels}));
+    double *out = reinterpret_cast<double *>(result.data());
+    fill(out, out + result.num_elements(), numeric_limits<double>::quiet_NaN());
+
+    readWindows(array, l, events, [&](size_t epoch, ndsize_t first, const double *data, ndsize_t count) {
+        memcpy(out + epoch * stride + first * l.channels, data, count * l.channels * sizeof(double));
+    });
+
+    correct(out, events.size(), l);
+    return result;
+}
+
+
+EpochAverage EpochExtractor::average(size_t reference_index) const {
+    if (!(reference_index < tag.referenceCount())) {
+        throw nix::OutOfBounds("Reference index out of bounds.", 0);
+    }
+    return average(tag.getReference(reference_index));
+}
+
+
+EpochAverage EpochExtractor::average(const DataArray &array) const {
+    return average(array, allEvents());
+}
+
+
+EpochAverage EpochExtractor::average(const DataArray &array, const vector<size_t> &events) const {
+    Layout l = layout(array);
+    size_t channels = static_cast<size_t>(l.channels);
+
+    EpochAverage result(NDSize({l.window, l.channels}));
+    double *mean = reinterpret_cast<double *>(result.mean.data());
+    double *m2 = reinterpret_cast<double *>(result.variance.data());
+    fill(mean, mean + result.mean.num_elements(), 0.0);
+    fill(m2, m2 + result.variance.num_elements(), 0.0);
+    ndsize_t *counts = result.counts.data();
+
+    vector<double> epoch(l.window * l.channels);
+    readWindows(array, l, events, [&](size_t, ndsize_t first, const double *data, ndsize_t count) {
+        double *samples = epoch.data() + first * channels;
+        fill(epoch.begin(), epoch.end(), numeric_limits<double>::quiet_NaN());
+        memcpy(samples, data, count * channels * sizeof(double));
+        correct(epoch.data(), 1, l);
+
+        // Welford's update, one row of channels at a time
+        for (ndsize_t k = first; k < first + count; ++k) {
+            double n = static_cast<double>(++counts[k]);
+            double *row_mean = mean + k * channels;
+            double *row_m2 = m2 + k * channels;
+            const double *x = epoch.data() + k * channels;
+            for (size_t c = 0; c < channels; ++c) {
+                double delta = x[c] - row_mean[c];
+                row_mean[c] += delta / n;
+                row_m2[c] += delta * (x[c] - row_mean[c]);
+            }
+        }
+    });
+
+    for (ndsize_t k = 0; k < l.window; ++k) {
+        for (size_t c = 0; c < channels; ++c) {
+            size_t i = k * channels + c;
+            if (counts[k] == 0) {
+                mean[i] = numeric_limits<double>::quiet_NaN();
+            }
+            m2[i] = counts[k] > 1 ? m2[i] / (counts[k] - 1) : numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    return result;
+}
+
+
+vector<ndsize_t> EpochExtractor::histogram(const DataArray &times, double bin_width) const {
+    if (!(bin_width > 0)) {
+        throw std::invalid_argument("EpochExtractor: The bin width must be positive!");
+    }
+    NDSize extent = times.dataExtent();
+    if (extent.size() != 1) {
+        throw nix::IncompatibleDimensions("Times must be stored in a 1-D array!", "nix::util::EpochExtractor::histogram");
+    }
+
+    vector<double> positions = eventPositions();
+    sort(positions.begin(), positions.end());
+    size_t bins = static_cast<size_t>(ceil((pre + post) / bin_width));
+    vector<ndsize_t> counts(bins, 0);
+
+    vector<double> block;
+    for (ndsize_t start = 0; start < extent[0]; start += max_read) {
+        ndsize_t count = min<ndsize_t>(max_read, extent[0] - start);
+        block.resize(count);
+        times.getDataDirect(DataType::Double, block.data(), NDSize({count}), NDSize({start}));
+
+        // every time lies in the windows of the events in (t - post, t + pre]
+        for (double t : block) {
+            auto first = upper_bound(positions.begin(), positions.end(), t - post);
+            auto last = upper_bound(first, positions.end(), t + pre);
+            for (auto it = first; it != last; ++it) {
+                double relative = t - *it + pre;
+                if (relative < 0) {
+                    continue;
+                }
+                size_t bin = static_cast<size_t>(relative / bin_width);
+                if (bin < bins) {
+                    ++counts[bin];
+                }
+            }
+        }
+    }
+
+    return counts;
+}
+
+
+EpochExtractor::Layout EpochExtractor::layout(const DataArray &array) const {
+    Layout l;
+    l.extent = array.dataExtent();
+    if (l.extent.size() < 1 || l.extent.size() > 2) {
+        throw nix::IncompatibleDimensions("Epochs can only be extracted from 1-D or 2-D data!", "nix::util::EpochExtractor");
+    }
+    Dimension dimension = array.getDimension(1);
+    if (dimension.dimensionType() != DimensionType::Sample) {
+        throw nix::IncompatibleDimensions("The first dimension of the data must be a SampledDimension!", "nix::util::EpochExtractor");
+    }
+
+    SampledDimension time;
+    time = dimension;
+    vector<string> units = tag.units();
+    l.scaling = unit_scaling(time, units.size() > 0 ? units[0] : "none");
+    boost::optional<double> dim_offset = time.offset();
+    l.offset = dim_offset ? *dim_offset : 0.0;
+    l.interval = time.samplingInterval();
+
+    l.window = static_cast<ndsize_t>(round((pre + post) * l.scaling / l.interval));
+    if (l.window == 0) {
+        throw std::invalid_argument("EpochExtractor: The window is shorter than one sample!");
+    }
+    l.channels = l.extent.size() > 1 ? l.extent[1] : 1;
+
+    l.first_base = l.last_base = 0;
+    if (subtract_baseline) {
+        double b0 = round((baseline_start + pre) * l.scaling / l.interval);
+        double b1 = round((baseline_end + pre) * l.scaling / l.interval);
+        if (b0 < 0 || b1 > static_cast<double>(l.window) || !(b0 < b1)) {
+            throw nix::OutOfBounds("EpochExtractor: The baseline is not within the window!");
+        }
+        l.first_base = static_cast<size_t>(b0);
+        l.last_base = static_cast<size_t>(b1);
+    }
+
+    l.origin = 0.0;
+    if (apply_calibration) {
+        l.coefficients = array.polynomCoefficients();
+        boost::optional<double> origin = array.expansionOrigin();
+        l.origin = origin ? *origin : 0.0;
+    }
+
+    return l;
+}
+
+
+void EpochExtractor::readWindows(const DataArray &array, const Layout &l,
+                                 const vector<size_t> &events, const window_fn &fn) const {
+    vector<double> positions = eventPositions();
+
+    vector<Window> windows;
+    windows.reserve(events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (events[i] >= positions.size()) {
+            throw nix::OutOfBounds("EpochExtractor: Event index out of bounds!", events[i]);
+        }
+        double start = round(((positions[events[i]] - pre) * l.scaling - l.offset) / l.interval);
+        windows.push_back(Window{i, static_cast<int64_t>(start)});
+    }
+    sort(windows.begin(), windows.end(), [](const Window &a, const Window &b) {
+        return a.start < b.start;
+    });
+
+    // clipped first and last sample of a window in the data
+    const int64_t window = static_cast<int64_t>(l.window);
+    const int64_t data_end = static_cast<int64_t>(l.extent[0]);
+    auto clip_start = [](const Window &w) { return max<int64_t>(w.start, 0); };
+    auto clip_end = [&](const Window &w) { return min<int64_t>(w.start + window, data_end); };
+
+    ndsize_t gap = have_max_gap ? max_gap : l.window;
+    ndsize_t max_samples = max<ndsize_t>(max_read / max<ndsize_t>(l.channels, 1), l.window);
+    vector<double> buffer;
+
+    size_t first = 0;
+    while (first < windows.size()) {
+        if (clip_end(windows[first]) <= clip_start(windows[first])) {
+            ++first;
+            continue;
+        }
+
+        // merge the following windows that are close enough into one read
+        int64_t run_start = clip_start(windows[first]);
+        int64_t run_end = clip_end(windows[first]);
+        size_t last = first + 1;
+        for (; last < windows.size(); ++last) {
+            int64_t s = clip_start(windows[last]);
+            int64_t e = clip_end(windows[last]);
+            if (e <= s) {
+                continue;
+            }
+            int64_t merged_end = max(run_end, e);
+            if (s > run_end + static_cast<int64_t>(gap) ||
+                static_cast<ndsize_t>(merged_end - run_start) > max_samples) {
+                break;
+            }
+            run_end = merged_end;
+        }
+
+        ndsize_t run_length = static_cast<ndsize_t>(run_end - run_start);
+        buffer.resize(run_length * l.channels);
+        NDSize count = l.extent, start(l.extent.size(), 0);
+        count[0] = run_length;
+        start[0] = static_cast<ndsize_t>(run_start);
+        array.getDataDirect(DataType::Double, buffer.data(), count, start);
+
+        for (size_t i = first; i < last; ++i) {
+            const Window &w = windows[i];
+            int64_t s = clip_start(w);
+            int64_t e = clip_end(w);
+            if (e <= s) {
+                continue;
+            }
+            fn(w.epoch, static_cast<ndsize_t>(s - w.start), buffer.data() + (s - run_start) * l.channels,
+               static_cast<ndsize_t>(e - s));
+        }
+        first = last;
+    }
+}
+
+
+void EpochExtractor::correct(double *epochs, size_t count, const Layout &l) const {
+    size_t window = static_cast<size_t>(l.window);
+    size_t channels = static_cast<size_t>(l.channels);
+
+    if (apply_calibration) {
+        applyPolynomial(l.coefficients, l.origin, epochs, epochs, count * window * channels);
+    }
+
+    if (subtract_baseline) {
+        for (size_t e = 0; e < count; ++e) {
+            double *epoch = epochs + e * window * channels;
+            for (size_t c = 0; c < channels; ++c) {
+                double sum = 0.0;
+                size_t n = 0;
+                for (size_t k = l.first_base; k < l.last_base; ++k) {
+                    double value = epoch[k * channels + c];
+                    if (!std::isnan(value)) {
+                        sum += value;
+                        ++n;
+                    }
+                }
+                if (n == 0) {
+                    continue;
+                }
+                double mean = sum / n;
+                for (size_t k = 0; k < window; ++k) {
+                    epoch[k * channels + c] -= mean;
+                }
+            }
+        }
+    }
+}
+
+
+vector<double> EpochExtractor::eventPositions() const {
+    // read all positions with one read, the first column holds the events
+    DataArray positions = tag.positions();
+    NDSize extent = positions.dataExtent();
+    vector<double> data(extent.nelms());
+    if (data.size() > 0) {
+        positions.getDataDirect(DataType::Double, data.data(), extent, NDSize(extent.size(), 0));
+    }
+
+    size_t stride = extent.size() > 1 ? static_cast<size_t>(extent[1]) : 1;
+    if (stride > 1) {
+        for (size_t i = 0; i < data.size() / stride; ++i) {
+            data[i] = data[i * stride];
+        }
+        data.resize(data.size() / stride);
+    }
+    return data;
+}
+
+
+vector<size_t> EpochExtractor::allEvents() const {
+    size_t count = static_cast<size_t>(tag.positions().dataExtent()[0]);
+    vector<size_t> events(count);
+    for (size_t i = 0; i < count; ++i) {
+        events[i] = i;
+    }
+    return events;
+}
+
+
+} // namespace util
+} // namespace nix
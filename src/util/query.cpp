@@ -0,0 +1,238 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/query.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+namespace nix {
+namespace util {
+
+
+struct Query::Node {
+    enum class Kind {
+        Equals, Prefix, And, Or, Not
+    };
+
+    Kind kind;
+    Field field;
+    std::vector<std::string> values;
+    std::shared_ptr<const Node> lhs, rhs;
+};
+
+
+Query::Query() {}
+
+
+Query::Query(const std::shared_ptr<const Node> &root)
+    : root(root)
+{
+}
+
+
+Query Query::name(const std::string &name) {
+    return equals(Field::Name, {name});
+}
+
+
+Query Query::namePrefix(const std::string &prefix) {
+    return Query::prefix(Field::Name, prefix);
+}
+
+
+Query Query::type(const std::string &type) {
+    return equals(Field::Type, {type});
+}
+
+
+Query Query::typePrefix(const std::string &prefix) {
+    return Query::prefix(Field::Type, prefix);
+}
+
+
+Query Query::id(const std::string &id) {
+    return equals(Field::Id, {id});
+}
+
+
+Query Query::ids(const std::vector<std::string> &ids) {
+    return equals(Field::Id, ids);
+}
+
+
+Query Query::definition(const std::string &definition) {
+    return equals(Field::Definition, {definition});
+}
+
+
+Query Query::metadata(const std::string &section_id) {
+    return equals(Field::Metadata, {section_id});
+}
+
+
+Query Query::equals(Field field, const std::vector<std::string> &values) {
+    auto node = std::make_shared<Node>();
+    node->kind = Node::Kind::Equals;
+    node->field = field;
+    node->values = values;
+    std::sort(node->values.begin(), node->values.end());
+    return Query(node);
+}
+
+
+Query Query::prefix(Field field, const std::string &prefix) {
+    auto node = std::make_shared<Node>();
+    node->kind = Node::Kind::Prefix;
+    node->field = field;
+    node->values = {prefix};
+    return Query(node);
+}
+
+
+Query Query::operator&&(const Query &other) const {
+    if (!root) {
+        return other;
+    } else if (!other.root) {
+        return *this;
+    }
+
+    auto node = std::make_shared<Node>();
+    node->kind = Node::Kind::And;
+    node->lhs = root;
+    node->rhs = other.root;
+    return Query(node);
+}
+
+
+Query Query::operator||(const Query &other) const {
+    if (!root || !other.root) {
+        return Query();
+    }
+
+    auto node = std::make_shared<Node>();
+    node->kind = Node::Kind::Or;
+    node->lhs = root;
+    node->rhs = other.root;
+    return Query(node);
+}
+
+
+Query Query::operator!() const {
+    if (!root) {
+        // negation of "all": an empty set of allowed values never matches
+        return equals(Field::Id, {});
+    }
+
+    auto node = std::make_shared<Node>();
+    node->kind = Node::Kind::Not;
+    node->lhs = root;
+    return Query(node);
+}
+
+
+bool Query::acceptsAll() const {
+    return !root;
+}
+
+
+boost::optional<std::vector<std::string>> Query::allowedValues(Field field) const {
+    boost::optional<std::vector<std::string>> values;
+    if (root) {
+        values = allowed(*root, field);
+    }
+    return values;
+}
+
+
+bool Query::matches(const accessor_t &get) const {
+    if (!root) {
+        return true;
+    }
+
+    // every field is requested at most once per entity
+    std::array<boost::optional<boost::optional<std::string>>, 5> cache;
+    accessor_t cached = [&get, &cache](Field f) {
+        boost::optional<boost::optional<std::string>> &entry = cache[static_cast<size_t>(f)];
+        if (!entry) {
+            entry = get(f);
+        }
+        return *entry;
+    };
+
+    return eval(*root, cached);
+}
+
+
+bool Query::eval(const Node &node, const accessor_t &get) {
+    switch (node.kind) {
+        case Node::Kind::Equals: {
+            if (node.values.empty()) {
+                return false;
+            }
+            boost::optional<std::string> value = get(node.field);
+            return value && std::binary_search(node.values.begin(), node.values.end(), *value);
+        }
+        case Node::Kind::Prefix: {
+            boost::optional<std::string> value = get(node.field);
+            return value && value->compare(0, node.values[0].size(), node.values[0]) == 0;
+        }
+        case Node::Kind::And:
+            return eval(*node.lhs, get) && eval(*node.rhs, get);
+        case Node::Kind::Or:
+            return eval(*node.lhs, get) || eval(*node.rhs, get);
+        case Node::Kind::Not:
+            return !eval(*node.lhs, get);
+    }
+    return false;
+}
+
+
+boost::optional<std::vector<std::string>> Query::allowed(const Node &node, Field field) {
+    boost::optional<std::vector<std::string>> values, other;
+
+    switch (node.kind) {
+        case Node::Kind::Equals:
+            if (node.field == field) {
+                values = node.values;
+            }
+            break;
+        case Node::Kind::And:
+            values = allowed(*node.lhs, field);
+            other = allowed(*node.rhs, field);
+            if (values && other) {
+                std::vector<std::string> both;
+                std::set_intersection(values->begin(), values->end(), other->begin(), other->end(),
+                                      std::back_inserter(both));
+                values = both;
+            } else if (other) {
+                values = other;
+            }
+            break;
+        case Node::Kind::Or:
+            values = allowed(*node.lhs, field);
+            other = allowed(*node.rhs, field);
+            if (values && other) {
+                std::vector<std::string> any;
+                std::set_union(values->begin(), values->end(), other->begin(), other->end(),
+                               std::back_inserter(any));
+                values = any;
+            } else {
+                values = boost::none;
+            }
+            break;
+        default:
+            break;
+    }
+
+    return values;
+}
+
+} // namespace util
+} // namespace nix
@@ -10,14 +10,18 @@
 
 #include <nix/base/IDimensions.hpp>
 
+#include <algorithm>
 #include <string>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <mutex>
 #include <random>
 #include <math.h>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/regex.hpp>
 #include <boost/random.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -32,14 +36,197 @@ namespace util {
 // Base32hex alphabet (RFC 4648)
 const char*  ID_ALPHABET = "0123456789abcdefghijklmnopqrstuv";
 // Unit scaling, SI only, substitutions for micro and ohm...
-const string  PREFIXES = "(Y|Z|E|P|T|G|M|k|h|da|d|c|m|u|n|p|f|a|z|y)";
-const string  UNITS = "(m|g|s|A|K|mol|cd|Hz|N|Pa|J|W|C|V|F|S|Wb|T|H|lm|lx|Bq|Gy|Sv|kat|l|L|Ohm|%|dB|rad)";
-const string  POWER = "(\\^[+-]?[1-9]\\d*)";
+const char *const SI_PREFIXES[] = {"Y", "Z", "E", "P", "T", "G", "M", "k", "h", "da", "d", "c", "m", "u", "n", "p",
+                                   "f", "a", "z", "y"};
+const double SI_PREFIX_FACTORS[] = {1.0e24, 1.0e21, 1.0e18, 1.0e15, 1.0e12, 1.0e9, 1.0e6, 1.0e3, 1.0e2, 1.0e1, 1.0e-1,
+                                    1.0e-2, 1.0e-3, 1.0e-6, 1.0e-9, 1.0e-12, 1.0e-15, 1.0e-18, 1.0e-21, 1.0e-24};
+const char *const SI_UNITS[] = {"m", "g", "s", "A", "K", "mol", "cd", "Hz", "N", "Pa", "J", "W", "C", "V", "F", "S",
+                                "Wb", "T", "H", "lm", "lx", "Bq", "Gy", "Sv", "kat", "l", "L", "Ohm", "%", "dB", "rad"};
+
+namespace {
+
+/*
+ * An atomic SI unit "<prefix><unit>^<power>" split into its parts, which
+ * point into the parsed string. The parser replaces the regular expressions
+ * (prefix)?(unit)(\^[+-]?[1-9]\d*)? and does not allocate.
+ */
+struct AtomicUnit {
+    int prefix = -1;
+    const char *unit = nullptr;
+    size_t unit_len = 0;
+    const char *power = nullptr;
+    size_t power_len = 0;
+
+    double factor() const {
+        return prefix < 0 ? 1.0 : SI_PREFIX_FACTORS[prefix];
+    }
+};
+
+
+template<size_t N>
+int find_token(const char *const (&table)[N], const char *str, size_t len) {
+    for (size_t i = 0; i < N; i++) {
+        if (strlen(table[i]) == len && memcmp(table[i], str, len) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+
+bool parse_atomic(const char *begin, const char *end, AtomicUnit &parsed) {
+    const char *caret = std::find(begin, end, '^');
+
+    parsed.power = nullptr;
+    parsed.power_len = 0;
+    if (caret != end) {
+        const char *p = caret + 1;
+        if (p != end && (*p == '+' || *p == '-')) {
+            ++p;
+        }
+        if (p == end || *p < '1' || *p > '9') {
+            return false;
+        }
+        while (++p != end) {
+            if (*p < '0' || *p > '9') {
+                return false;
+            }
+        }
+        parsed.power = caret + 1;
+        parsed.power_len = static_cast<size_t>(end - parsed.power);
+    }
+
+    size_t len = static_cast<size_t>(caret - begin);
+    if (find_token(SI_UNITS, begin, len) >= 0) {
+        parsed.prefix = -1;
+        parsed.unit = begin;
+        parsed.unit_len = len;
+        return true;
+    }
+
+    for (size_t i = 0; i < sizeof(SI_PREFIXES) / sizeof(SI_PREFIXES[0]); i++) {
+        size_t prefix_len = strlen(SI_PREFIXES[i]);
+        if (prefix_len < len && memcmp(SI_PREFIXES[i], begin, prefix_len) == 0 &&
+            find_token(SI_UNITS, begin + prefix_len, len - prefix_len) >= 0) {
+            parsed.prefix = static_cast<int>(i);
+            parsed.unit = begin + prefix_len;
+            parsed.unit_len = len - prefix_len;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool parse_atomic(const string &unit, AtomicUnit &parsed) {
+    return parse_atomic(unit.data(), unit.data() + unit.size(), parsed);
+}
+
+
+bool is_separator(char c) {
+    return c == '*' || c == '/';
+}
 
-const map<string, double> PREFIX_FACTORS = {{"y", 1.0e-24}, {"z", 1.0e-21}, {"a", 1.0e-18}, {"f", 1.0e-15},
-    {"p", 1.0e-12}, {"n",1.0e-9}, {"u", 1.0e-6}, {"m", 1.0e-3}, {"c", 1.0e-2}, {"d",1.0e-1}, {"da", 1.0e1}, {"h", 1.0e2},
-    {"k", 1.0e3}, {"M",1.0e6}, {"G", 1.0e9}, {"T", 1.0e12}, {"P", 1.0e15}, {"E",1.0e18}, {"Z", 1.0e21}, {"Y", 1.0e24}};
 
+bool is_compound(const string &unit) {
+    const char *begin = unit.data();
+    const char *end = begin + unit.size();
+    size_t parts = 0;
+    AtomicUnit parsed;
+
+    while (true) {
+        const char *sep = std::find_if(begin, end, is_separator);
+        if (!parse_atomic(begin, sep, parsed)) {
+            return false;
+        }
+        parts++;
+        if (sep == end) {
+            break;
+        }
+        begin = sep + 1;
+    }
+    return parts > 1;
+}
+
+
+/*
+ * The factor to scale values from the origin into the destination unit,
+ * NaN if the units are not scalable versions of the same SI unit.
+ */
+double si_scaling(const string &origin, const string &destination) {
+    const double not_scalable = numeric_limits<double>::quiet_NaN();
+    AtomicUnit org, dest;
+    bool org_atomic = parse_atomic(origin, org);
+    bool dest_atomic = parse_atomic(destination, dest);
+
+    if (!(org_atomic || (!origin.empty() && is_compound(origin))) ||
+        !(dest_atomic || (!destination.empty() && is_compound(destination)))) {
+        return not_scalable;
+    }
+    if (!org_atomic || !dest_atomic) {
+        // compound units are only scalable to themselves
+        return origin == destination ? 1.0 : not_scalable;
+    }
+    if (org.unit_len != dest.unit_len || memcmp(org.unit, dest.unit, org.unit_len) != 0 ||
+        org.power_len != dest.power_len || (org.power_len > 0 && memcmp(org.power, dest.power, org.power_len) != 0)) {
+        return not_scalable;
+    }
+
+    if (org.prefix == dest.prefix) {
+        return 1.0;
+    }
+    double scaling = org.factor() / dest.factor();
+    if (org.power_len > 0) {
+        scaling = pow(scaling, static_cast<int>(strtol(org.power, nullptr, 10)));
+    }
+    return scaling;
+}
+
+
+/*
+ * Thread-safe memo table of scaling factors. Origin and destination are
+ * hashed into a fixed number of slots and a slot holds the last pair that
+ * mapped to it, so a lookup of a known pair does not allocate.
+ */
+class ScalingMemo {
+
+public:
+
+    double scaling(const string &origin, const string &destination) {
+        size_t h = hash<string>()(origin) * 31 + hash<string>()(destination);
+        Slot &slot = slots[h % slot_count];
+
+        {
+            lock_guard<mutex> guard(lock);
+            if (slot.used && slot.origin == origin && slot.destination == destination) {
+                return slot.factor;
+            }
+        }
+
+        double factor = si_scaling(origin, destination);
+
+        lock_guard<mutex> guard(lock);
+        slot.origin = origin;
+        slot.destination = destination;
+        slot.factor = factor;
+        slot.used = true;
+        return factor;
+    }
+
+private:
+
+    struct Slot {
+        string origin, destination;
+        double factor = 1.0;
+        bool used = false;
+    };
+
+    static const size_t slot_count = 64;
+    Slot slots[slot_count];
+    mutex lock;
+};
+
+} // anonymous namespace
 
 string createId() {
     typedef boost::mt19937::result_type seed_type;
@@ -116,34 +303,11 @@ std::string unitSanitizer(const std::string &unit) {
 }
 
 void splitUnit(const string &combinedUnit, string &prefix, string &unit, string &power) {
-    boost::regex prefix_and_unit_and_power(PREFIXES + UNITS + POWER);
-    boost::regex prefix_and_unit(PREFIXES + UNITS);
-    boost::regex unit_and_power(UNITS + POWER);
-    boost::regex unit_only(UNITS);
-    boost::regex prefix_only(PREFIXES);
-
-    if (boost::regex_match(combinedUnit, prefix_and_unit_and_power)) {
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, prefix_only);
-        prefix = m[0];
-        string suffix = m.suffix();
-        boost::regex_search(suffix, m, unit_only);
-        unit = m[0];
-        power = m.suffix();
-        power = power.substr(1);
-    } else if (boost::regex_match(combinedUnit, unit_and_power)) {
-        prefix = "";
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, unit_only);
-        unit = m[0];
-        power = m.suffix();
-        power = power.substr(1);
-    } else if (boost::regex_match(combinedUnit, prefix_and_unit)) {
-        boost::match_results<std::string::const_iterator> m;
-        boost::regex_search(combinedUnit, m, prefix_only);
-        prefix = m[0];
-        unit = m.suffix();
-        power = "";
+    AtomicUnit parsed;
+    if (parse_atomic(combinedUnit, parsed)) {
+        prefix = parsed.prefix < 0 ? "" : SI_PREFIXES[parsed.prefix];
+        unit.assign(parsed.unit, parsed.unit_len);
+        power = parsed.power_len > 0 ? string(parsed.power, parsed.power_len) : "";
     } else {
         unit = combinedUnit;
         prefix = "";
@@ -151,7 +315,6 @@ void splitUnit(const string &combinedUnit, string &prefix, string &unit, string
     }
 }
 
-
 void invertPower(std::string &unit) {
     string p, u, power;
     util::splitUnit(unit, p, u, power);
@@ -168,52 +331,39 @@ void invertPower(std::string &unit) {
 
 
 void splitCompoundUnit(const std::string &compoundUnit, std::vector<std::string> &atomicUnits) {
-    string s = compoundUnit;
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    boost::regex separator("(\\*|/)");
-    boost::match_results<std::string::const_iterator> m;
-    string sep;
-    while (boost::regex_search(s, m, opt_prefix_and_unit_and_power) && (m.suffix().length() > 0)) {
-        string suffix = m.suffix();
-        util::deblankString(suffix);
-        if (sep == "/") {
-            string unit = m[0];
+    string s = deblankString(compoundUnit);
+    char sep = 0;
+    size_t begin = 0;
+    while (true) {
+        size_t end = s.find_first_of("*/", begin);
+        string unit = s.substr(begin, end == string::npos ? string::npos : end - begin);
+        if (sep == '/') {
             invertPower(unit);
-            atomicUnits.push_back(unit);
-        } else {
-            atomicUnits.push_back(m[0]);
         }
-        sep = suffix[0];
-        s = suffix.substr(1);
-    }
-    if (sep == "/") {
-        string unit = m[0];
-        invertPower(unit);
         atomicUnits.push_back(unit);
-    } else {
-        atomicUnits.push_back(m[0]);
+        if (end == string::npos) {
+            break;
+        }
+        sep = s[end];
+        begin = end + 1;
     }
 }
 
-
 bool isSIUnit(const string &unit) {
     return !unit.empty() && (isAtomicSIUnit(unit) || isCompoundSIUnit(unit));
 }
 
 
 bool isAtomicSIUnit(const string &unit) {
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    return boost::regex_match(unit, opt_prefix_and_unit_and_power);
+    AtomicUnit parsed;
+    return parse_atomic(unit, parsed);
 }
 
 
 bool isCompoundSIUnit(const string &unit) {
-    string atomic_unit = PREFIXES + "?" + UNITS + POWER + "?";
-    boost::regex compound_unit("(" + atomic_unit + "(\\*|/))+"+ atomic_unit);
-    return !unit.empty() && boost::regex_match(unit, compound_unit);
+    return !unit.empty() && is_compound(unit);
 }
 
-
 std::string dimTypeToStr(const nix::DimensionType &dtype) {
     std::stringstream s;
     s << dtype;
@@ -222,20 +372,9 @@ std::string dimTypeToStr(const nix::DimensionType &dtype) {
 
 
 bool isScalable(const string &unitA, const string &unitB) {
-    if (!(isSIUnit(unitA) && isSIUnit(unitB))) {
-        return false;
-    }
-    string a_unit, a_prefix, a_power;
-    string b_unit, b_prefix, b_power;
-    splitUnit(unitA, a_prefix, a_unit, a_power);
-    splitUnit(unitB, b_prefix, b_unit, b_power);
-    if (!(a_unit == b_unit) || !(a_power == b_power) ) {
-        return false;
-    }
-    return true;
+    return !std::isnan(si_scaling(unitA, unitB));
 }
 
-
 bool isScalable(const vector<string> &unitsA, const vector<string> &unitsB) {
     bool scalable = true;
     
@@ -275,31 +414,12 @@ bool isSetAtSamePos(const vector<string> &unitsA, const vector<string> &unitsB)
 
 
 double getSIScaling(const string &originUnit, const string &destinationUnit) {
-    double scaling = 1.0;
-    if (!isScalable(originUnit, destinationUnit)) {
+    static ScalingMemo memo;
+    double scaling = memo.scaling(originUnit, destinationUnit);
+    if (std::isnan(scaling)) {
         throw nix::InvalidUnit("Origin unit and destination unit are not scalable versions of the same SI unit!",
                                "nix::util::getSIScaling");
     }
-    
-    string org_unit, org_prefix, org_power;
-    string dest_unit, dest_prefix, dest_power;
-    splitUnit(originUnit, org_prefix, org_unit, org_power);
-    splitUnit(destinationUnit, dest_prefix, dest_unit, dest_power);
-
-    if ((org_prefix == dest_prefix) && (org_power == dest_power)) {
-        return scaling;
-    }
-    if (dest_prefix.empty() && !org_prefix.empty()) {
-        scaling = PREFIX_FACTORS.at(org_prefix);
-    } else if (org_prefix.empty() && !dest_prefix.empty()) {
-        scaling = 1.0 / PREFIX_FACTORS.at(dest_prefix);
-    } else if (!org_prefix.empty() && !dest_prefix.empty()) {
-        scaling = PREFIX_FACTORS.at(org_prefix) / PREFIX_FACTORS.at(dest_prefix);
-    }
-    if (!org_power.empty()) {
-        int power = std::stoi(org_power);
-        scaling = pow(scaling, power);
-    }
     return scaling;
 }
 
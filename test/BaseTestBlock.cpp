@@ -9,6 +9,7 @@
 #include "BaseTestBlock.hpp"
 
 #include <iterator>
+#include <algorithm>
 #include <boost/math/constants/constants.hpp>
 
 #include <nix/hydra/multiArray.hpp>
@@ -303,6 +304,137 @@ void BaseTestBlock::testGroupAccess() {
 }
 
 
+void BaseTestBlock::testQuery() {
+    using util::Query;
+
+    std::vector<std::string> names = { "spikes_a", "spikes_b", "lfp_a", "lfp_b", "tmp_spikes" };
+    std::vector<std::string> types = { "nix.spike", "nix.spike", "nix.lfp", "nix.lfp.raw", "nix.spike" };
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < names.size(); i++) {
+        DataArray da = block.createDataArray(names[i], types[i], DataType::Double, nix::NDSize({ 0 }));
+        ids.push_back(da.id());
+    }
+    block.getDataArray("lfp_a").definition("local field potential");
+    block.getDataArray("spikes_b").metadata(section);
+
+    auto sorted_names = [](const std::vector<DataArray> &arrays) {
+        std::vector<std::string> ret;
+        for (const auto &da : arrays) {
+            ret.push_back(da.name());
+        }
+        std::sort(ret.begin(), ret.end());
+        return ret;
+    };
+
+    std::vector<std::string> expected;
+    expected = { "spikes_a", "spikes_b", "tmp_spikes" };
+    CPPUNIT_ASSERT(sorted_names(block.dataArrays(Query::type("nix.spike"))) == expected);
+
+    expected = { "spikes_a", "spikes_b" };
+    CPPUNIT_ASSERT(sorted_names(block.dataArrays(Query::type("nix.spike") && !Query::namePrefix("tmp_"))) == expected);
+
+    expected = { "lfp_a", "lfp_b" };
+    CPPUNIT_ASSERT(sorted_names(block.dataArrays(Query::typePrefix("nix.lfp"))) == expected);
+
+    expected = { "lfp_a", "spikes_b" };
+    CPPUNIT_ASSERT(sorted_names(block.dataArrays(Query::metadata(section.id()) ||
+                                                 Query::definition("local field potential"))) == expected);
+
+    expected = { "lfp_b", "spikes_a" };
+    CPPUNIT_ASSERT(sorted_names(block.dataArrays(Query::ids({ids[3], ids[0]}))) == expected);
+
+    expected = { "tmp_spikes" };
+    CPPUNIT_ASSERT(sorted_names(block.dataArrays(Query::id(ids[4]))) == expected);
+    CPPUNIT_ASSERT(sorted_names(block.dataArrays(Query::name("tmp_spikes"))) == expected);
+
+    CPPUNIT_ASSERT_EQUAL(names.size(), block.dataArrays(Query::all()).size());
+    CPPUNIT_ASSERT(block.dataArrays(!Query::all()).empty());
+    CPPUNIT_ASSERT(block.dataArrays(Query::name("missing")).empty());
+    CPPUNIT_ASSERT(block.tags(Query::type("nix.spike")).empty());
+
+    // a query can also be used as a filter
+    Query q = Query::typePrefix("nix.lfp") && !Query::definition("local field potential");
+    expected = { "lfp_b" };
+    CPPUNIT_ASSERT(sorted_names(block.dataArrays(util::Filter<DataArray>::type(q))) == expected);
+    CPPUNIT_ASSERT(sorted_names(block.dataArrays(q)) == expected);
+
+    block.createTag("tag_a", "nix.stimulus", {0.0});
+    block.createTag("tag_b", "nix.event", {0.0});
+    std::vector<Tag> tags = block.tags(Query::type("nix.event"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), tags.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("tag_b"), tags[0].name());
+
+    for (const auto &name : names) {
+        block.deleteDataArray(name);
+    }
+    block.deleteTag("tag_a");
+    block.deleteTag("tag_b");
+}
+
+void BaseTestBlock::testTypeIndex() {
+    typedef util::TypeFilter<DataArray> type_filter;
+
+    auto names_of = [](const std::vector<DataArray> &arrays) {
+        std::vector<std::string> ret;
+        for (const auto &da : arrays) {
+            ret.push_back(da.name());
+        }
+        std::sort(ret.begin(), ret.end());
+        return ret;
+    };
+
+    block.createDataArray("a", "nix.sampled", DataType::Double, nix::NDSize({ 0 }));
+    block.createDataArray("b", "nix.events", DataType::Double, nix::NDSize({ 0 }));
+
+    std::vector<std::string> expected = { "a" };
+    CPPUNIT_ASSERT(names_of(block.dataArrays(type_filter("nix.sampled"))) == expected);
+
+    // the index has to follow creation, type changes and deletion
+    block.createDataArray("c", "nix.sampled", DataType::Double, nix::NDSize({ 0 }));
+    expected = { "a", "c" };
+    CPPUNIT_ASSERT(names_of(block.dataArrays(type_filter("nix.sampled"))) == expected);
+
+    block.getDataArray("b").type("nix.sampled");
+    block.getDataArray("a").type("nix.events");
+    expected = { "b", "c" };
+    CPPUNIT_ASSERT(names_of(block.dataArrays(type_filter("nix.sampled"))) == expected);
+    expected = { "a" };
+    CPPUNIT_ASSERT(names_of(block.dataArrays(type_filter("nix.events"))) == expected);
+
+    block.deleteDataArray("c");
+    expected = { "b" };
+    CPPUNIT_ASSERT(names_of(block.dataArrays(type_filter("nix.sampled"))) == expected);
+    block.createDataArray("c", "nix.events", DataType::Double, nix::NDSize({ 0 }));
+    expected = { "a", "c" };
+    CPPUNIT_ASSERT(names_of(block.dataArrays(type_filter("nix.events"))) == expected);
+    CPPUNIT_ASSERT(names_of(block.dataArrays(util::Query::type("nix.events") && util::Query::name("c"))) ==
+                   std::vector<std::string>({"c"}));
+    CPPUNIT_ASSERT(names_of(block.dataArrays(util::Query::ids({block.getDataArray("a").id()}) ||
+                                             util::Query::type("nix.sampled"))) ==
+                   std::vector<std::string>({"a", "b"}));
+
+    // other collections and blocks are indexed separately
+    block_other.createDataArray("d", "nix.events", DataType::Double, nix::NDSize({ 0 }));
+    block.createTag("t", "nix.events", {0.0});
+    block.createMultiTag("m", "nix.events", block.getDataArray("a"));
+    block.createGroup("g", "nix.events");
+    CPPUNIT_ASSERT(block.dataArrays(type_filter("nix.events")).size() == 2);
+    CPPUNIT_ASSERT(block_other.dataArrays(type_filter("nix.events")).size() == 1);
+    CPPUNIT_ASSERT(block.tags(util::TypeFilter<Tag>("nix.events")).size() == 1);
+    CPPUNIT_ASSERT(block.multiTags(util::TypeFilter<MultiTag>("nix.events")).size() == 1);
+    CPPUNIT_ASSERT(block.groups(util::TypeFilter<Group>("nix.events")).size() == 1);
+    CPPUNIT_ASSERT(block.groups(util::TypeFilter<Group>("nix.sampled")).empty());
+
+    block.deleteMultiTag("m");
+    block.deleteTag("t");
+    block.deleteGroup("g");
+    block_other.deleteDataArray("d");
+    for (const std::string &name : {"a", "b", "c"}) {
+        block.deleteDataArray(name);
+    }
+    CPPUNIT_ASSERT(block.dataArrays(type_filter("nix.events")).empty());
+}
+
 void BaseTestBlock::testOperators() {
     CPPUNIT_ASSERT(block_null == false);
     CPPUNIT_ASSERT(block_null == none);
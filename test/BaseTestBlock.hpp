@@ -35,6 +35,8 @@ public:
     void testTagAccess();
     void testMultiTagAccess();
     void testGroupAccess();
+    void testQuery();
+    void testTypeIndex();
 
     void testOperators();
     void testUpdatedAt();
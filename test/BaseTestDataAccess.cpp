@@ -10,9 +10,11 @@
 #include <sstream>
 #include <iterator>
 #include <stdexcept>
+#include <cmath>
 
 #include <nix/hydra/multiArray.hpp>
 #include <nix/util/dataAccess.hpp>
+#include <nix/util/epochs.hpp>
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/CompilerOutputter.h>
@@ -25,6 +27,21 @@
 
 using namespace nix;
 
+namespace {
+
+// the index of a feature, backends do not have to keep the creation order
+template<typename T>
+size_t featureIndex(const T &tag, const Feature &feature) {
+    for (size_t i = 0; i < tag.featureCount(); i++) {
+        if (tag.getFeature(i).id() == feature.id()) {
+            return i;
+        }
+    }
+    throw std::runtime_error("feature " + feature.id() + " not found");
+}
+
+} // anonymous namespace
+
 
 void BaseTestDataAccess::testPositionToIndexRangeDimension() {
     std::string unit = "ms";
@@ -114,6 +131,38 @@ void BaseTestDataAccess::testOffsetAndCount() {
 }
 
 
+void BaseTestDataAccess::testOffsetsAndCounts() {
+    std::vector<ndsize_t> offsets, counts;
+    util::getOffsetsAndCounts(multi_tag, data_array, offsets, counts);
+
+    ndsize_t position_count = multi_tag.positions().dataExtent()[0];
+    size_t rank = static_cast<size_t>(data_array.dimensionCount());
+    CPPUNIT_ASSERT(offsets.size() == position_count * rank);
+    CPPUNIT_ASSERT(counts.size() == position_count * rank);
+
+    for (size_t i = 0; i < position_count; i++) {
+        NDSize offset, count;
+        util::getOffsetAndCount(multi_tag, data_array, i, offset, count);
+        for (size_t j = 0; j < rank; j++) {
+            CPPUNIT_ASSERT(offsets[i * rank + j] == offset[j]);
+            CPPUNIT_ASSERT(counts[i * rank + j] == count[j]);
+        }
+    }
+
+    std::vector<DataView> views = util::retrieveData(multi_tag, std::vector<size_t>{0, 0}, 0);
+    CPPUNIT_ASSERT(views.size() == 2);
+    for (const DataView &view : views) {
+        NDSize data_size = view.dataExtent();
+        CPPUNIT_ASSERT(data_size.size() == 3);
+        CPPUNIT_ASSERT(data_size[0] == 1 && data_size[1] == 6 && data_size[2] == 2);
+    }
+
+    CPPUNIT_ASSERT(util::retrieveData(multi_tag, std::vector<size_t>(), 0).empty());
+    CPPUNIT_ASSERT_THROW(util::retrieveData(multi_tag, std::vector<size_t>{0, 1}, 0), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(util::retrieveData(multi_tag, std::vector<size_t>{0, 10}, 0), nix::OutOfBounds);
+}
+
+
 void BaseTestDataAccess::testPositionInData() {
     NDSize offsets, counts;
     util::getOffsetAndCount(multi_tag, data_array, 0, offsets, counts);
@@ -177,9 +226,13 @@ void BaseTestDataAccess::testTagFeatureData() {
     Feature f2 = pos_tag.createFeature(ramp_feat, nix::LinkType::Tagged);
     Feature f3 = pos_tag.createFeature(ramp_feat, nix::LinkType::Untagged);
 
-    DataView data1 = util::retrieveFeatureData(pos_tag, 0);
-    DataView data2 = util::retrieveFeatureData(pos_tag, 1);
-    DataView data3 = util::retrieveFeatureData(pos_tag, 2);
+    size_t i1 = featureIndex(pos_tag, f1);
+    size_t i2 = featureIndex(pos_tag, f2);
+    size_t i3 = featureIndex(pos_tag, f3);
+
+    DataView data1 = util::retrieveFeatureData(pos_tag, i1);
+    DataView data2 = util::retrieveFeatureData(pos_tag, i2);
+    DataView data3 = util::retrieveFeatureData(pos_tag, i3);
 
     CPPUNIT_ASSERT(pos_tag.featureCount() == 3);
     CPPUNIT_ASSERT(data1.dataExtent().nelms() == 1);
@@ -187,9 +240,9 @@ void BaseTestDataAccess::testTagFeatureData() {
     CPPUNIT_ASSERT(data3.dataExtent().nelms() == ramp_data.size());
     // make tag pointing to a slice
     pos_tag.extent({2.0});
-    data1 = util::retrieveFeatureData(pos_tag, 0);
-    data2 = util::retrieveFeatureData(pos_tag, 1);
-    data3 = util::retrieveFeatureData(pos_tag, 2);
+    data1 = util::retrieveFeatureData(pos_tag, i1);
+    data2 = util::retrieveFeatureData(pos_tag, i2);
+    data3 = util::retrieveFeatureData(pos_tag, i3);
 
     CPPUNIT_ASSERT(data1.dataExtent().nelms() == 1);
     CPPUNIT_ASSERT(data2.dataExtent().nelms() == 2);
@@ -252,8 +305,11 @@ void BaseTestDataAccess::testMultiTagFeatureData() {
 
     // preparations done, actually test 
     CPPUNIT_ASSERT(multi_tag.featureCount() == 3);
+    size_t index_idx = featureIndex(multi_tag, index_feature);
+    size_t tagged_idx = featureIndex(multi_tag, tagged_feature);
+    size_t untagged_idx = featureIndex(multi_tag, untagged_feature);
     // indexed feature
-    DataView data_view = util::retrieveFeatureData(multi_tag, 0, 0);
+    DataView data_view = util::retrieveFeatureData(multi_tag, 0, index_idx);
     NDSize data_size = data_view.dataExtent();
 
     CPPUNIT_ASSERT(data_size.size() == 2);
@@ -270,7 +326,7 @@ void BaseTestDataAccess::testMultiTagFeatureData() {
 
     CPPUNIT_ASSERT(sum == 45);
 
-    data_view = util::retrieveFeatureData(multi_tag, 9, 0);
+    data_view = util::retrieveFeatureData(multi_tag, 9, index_idx);
     sum = 0;
     for (size_t i = 0; i < data_view.dataExtent()[1]; ++i){
         offset[1] = i;
@@ -279,11 +335,11 @@ void BaseTestDataAccess::testMultiTagFeatureData() {
     }
     CPPUNIT_ASSERT(sum == 9045);
     // untagged feature
-    data_view = util::retrieveFeatureData(multi_tag, 0, 2);
+    data_view = util::retrieveFeatureData(multi_tag, 0, untagged_idx);
     CPPUNIT_ASSERT(data_view.dataExtent().nelms() == 100);
     
     
-    data_view = util::retrieveFeatureData(multi_tag, 1, 2);
+    data_view = util::retrieveFeatureData(multi_tag, 1, untagged_idx);
     data_size = data_view.dataExtent();
     CPPUNIT_ASSERT(data_size.nelms() == 100);
     sum = 0;
@@ -298,15 +354,15 @@ void BaseTestDataAccess::testMultiTagFeatureData() {
     }
     CPPUNIT_ASSERT(sum == total);
     // tagged feature
-    data_view = util::retrieveFeatureData(multi_tag, 0, 1);
+    data_view = util::retrieveFeatureData(multi_tag, 0, tagged_idx);
     data_size = data_view.dataExtent();
     CPPUNIT_ASSERT(data_size.size() == 3);
 
-    data_view = util::retrieveFeatureData(multi_tag, 1, 1);
+    data_view = util::retrieveFeatureData(multi_tag, 1, tagged_idx);
     data_size = data_view.dataExtent();
     CPPUNIT_ASSERT(data_size.size() == 3);
 
-    CPPUNIT_ASSERT_THROW(util::retrieveFeatureData(multi_tag, 2, 1), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(util::retrieveFeatureData(multi_tag, 2, tagged_idx), nix::OutOfBounds);
     CPPUNIT_ASSERT_THROW(util::retrieveFeatureData(multi_tag, 2, 3), nix::OutOfBounds);
     
     // clean up
@@ -389,3 +445,111 @@ void BaseTestDataAccess::testDataView() {
 
 
 }
+
+
+void BaseTestDataAccess::testEpochs() {
+    const size_t samples = 1000, channels = 3;
+    std::vector<double> values(samples * channels);
+    for (size_t t = 0; t < samples; t++) {
+        for (size_t c = 0; c < channels; c++) {
+            values[t * channels + c] = t * 10.0 + c;
+        }
+    }
+    DataArray signal = block.createDataArray("signal", "test", DataType::Double, NDSize({samples, channels}));
+    signal.setData(DataType::Double, values.data(), NDSize({samples, channels}), NDSize({0, 0}));
+    SampledDimension time = signal.appendSampledDimension(0.1);
+    time.unit("s");
+    signal.appendSetDimension();
+
+    std::vector<double> events{10.0, 10.5, 0.2, 99.5};
+    DataArray positions = block.createDataArray("events", "test", events);
+    MultiTag spikes = block.createMultiTag("spikes", "test", positions);
+    spikes.units(std::vector<std::string>{"s"});
+    spikes.addReference(signal);
+
+    auto at = [](const NDArray &a, size_t e, size_t k, size_t c) {
+        return a.get<double>(NDSize({e, k, c}));
+    };
+
+    util::EpochExtractor extractor(spikes, 0.5, 1.0);
+    NDArray epochs = extractor.extract(0);
+    CPPUNIT_ASSERT_EQUAL(NDSize({4, 15, 3}), epochs.shape());
+
+    // windows start 5 samples before the event
+    for (size_t k = 0; k < 15; k++) {
+        for (size_t c = 0; c < channels; c++) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL((95.0 + k) * 10 + c, at(epochs, 0, k, c), 1e-9);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL((100.0 + k) * 10 + c, at(epochs, 1, k, c), 1e-9);
+        }
+    }
+    // samples outside of the data are NaN
+    for (size_t k = 0; k < 15; k++) {
+        CPPUNIT_ASSERT(k < 3 ? std::isnan(at(epochs, 2, k, 0)) : at(epochs, 2, k, 0) == (k - 3.0) * 10);
+        CPPUNIT_ASSERT(k >= 10 ? std::isnan(at(epochs, 3, k, 2)) : at(epochs, 3, k, 2) == (990.0 + k) * 10 + 2);
+    }
+
+    // reading every window alone gives the same epochs
+    NDArray single = util::EpochExtractor(spikes, 0.5, 1.0).maxGap(0).extract(signal, {3, 0, 1});
+    CPPUNIT_ASSERT_EQUAL(NDSize({3, 15, 3}), single.shape());
+    for (size_t k = 0; k < 15; k++) {
+        CPPUNIT_ASSERT_EQUAL(at(epochs, 0, k, 1), at(single, 1, k, 1));
+        CPPUNIT_ASSERT_EQUAL(at(epochs, 1, k, 1), at(single, 2, k, 1));
+    }
+
+    // the mean of the 5 samples before the event is subtracted
+    NDArray corrected = util::EpochExtractor(spikes, 0.5, 1.0).baseline(-0.5, 0.0).extract(0);
+    for (size_t k = 0; k < 15; k++) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0 * k - 20.0, at(corrected, 0, k, 2), 1e-9);
+    }
+
+    signal.polynomCoefficients({1.0, 2.0});
+    NDArray calibrated = util::EpochExtractor(spikes, 0.5, 1.0).calibrate().extract(signal, {0});
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 + 2.0 * 951, at(calibrated, 0, 0, 1), 1e-9);
+
+    // the streamed average matches the mean and variance of the extracted epochs
+    util::EpochAverage average = util::EpochExtractor(spikes, 0.5, 1.0).maxGap(2).average(0);
+    CPPUNIT_ASSERT_EQUAL(NDSize({15, 3}), average.mean.shape());
+    CPPUNIT_ASSERT_EQUAL(NDSize({15, 3}), average.variance.shape());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(15), average.counts.size());
+    for (size_t k = 0; k < 15; k++) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(k < 3 || k >= 10 ? 3 : 4), average.counts[k]);
+        for (size_t c = 0; c < channels; c++) {
+            double sum = 0.0, sum2 = 0.0;
+            size_t n = 0;
+            for (size_t e = 0; e < 4; e++) {
+                double value = at(epochs, e, k, c);
+                if (!std::isnan(value)) {
+                    sum += value;
+                    n++;
+                }
+            }
+            double mean = sum / n;
+            for (size_t e = 0; e < 4; e++) {
+                double value = at(epochs, e, k, c);
+                if (!std::isnan(value)) {
+                    sum2 += (value - mean) * (value - mean);
+                }
+            }
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(mean, average.mean.get<double>(NDSize({k, c})), 1e-6);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(sum2 / (n - 1), average.variance.get<double>(NDSize({k, c})), 1e-3);
+        }
+    }
+
+    std::vector<double> spike_times{9.6, 10.0, 10.4, 10.9, 50.0};
+    DataArray times = block.createDataArray("spike_times", "test", spike_times);
+    std::vector<ndsize_t> psth = extractor.histogram(times, 0.5);
+    CPPUNIT_ASSERT(psth == std::vector<ndsize_t>({3, 3, 1}));
+    CPPUNIT_ASSERT_THROW(extractor.histogram(times, 0.0), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(extractor.histogram(signal, 0.5), nix::IncompatibleDimensions);
+    block.deleteDataArray(times.id());
+
+    CPPUNIT_ASSERT_THROW(util::EpochExtractor(spikes, 0.5, -0.5), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(util::EpochExtractor(spikes, 0.5, 1.0).baseline(-1.0, 0.0).extract(0), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(extractor.extract(signal, {4}), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(extractor.extract(1), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(extractor.extract(data_array), nix::IncompatibleDimensions);
+
+    block.deleteMultiTag(spikes.id());
+    block.deleteDataArray(positions.id());
+    block.deleteDataArray(signal.id());
+}
@@ -29,12 +29,14 @@ public:
     void testPositionToIndexSampledDimension();
     void testPositionToIndexRangeDimension();
     void testOffsetAndCount();
+    void testOffsetsAndCounts();
     void testPositionInData();
     void testRetrieveData();
     void testTagFeatureData();
     void testMultiTagFeatureData();
     void testMultiTagUnitSupport();
     void testDataView();
+    void testEpochs();
 };
 
 #endif // NIX_BASETESTDATAACCESS_H
@@ -13,6 +13,8 @@
 #include <iterator>
 #include <stdexcept>
 #include <limits>
+#include <array>
+#include <utility>
 
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/tools/rational.hpp>
@@ -21,6 +23,7 @@
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
 #include <nix/hydra/multiArray.hpp>
+#include <nix/NDArray.hpp>
 
 #include "BaseTestDataArray.hpp"
 
@@ -259,6 +262,83 @@ void BaseTestDataArray::testData() {
 }
 
 
+void BaseTestDataArray::testArrayViews() {
+    std::vector<double> values(6 * 4);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<double>(i);
+    }
+    DataArray da = block.createDataArray("views", "double", DataType::Double, NDSize({6, 4}));
+    da.setData(DataType::Double, values.data(), {6, 4}, {0, 0});
+
+    // contiguous views are read into directly
+    NDArray array(DataType::Double, {3, 4});
+    NDArrayView<double> rows = array.view<double>();
+    da.getData(rows, {2, 0});
+    CPPUNIT_ASSERT_EQUAL(8.0, rows(0, 0));
+    CPPUNIT_ASSERT_EQUAL(19.0, rows(2, 3));
+
+    // strided views go through a buffer
+    NDArrayView<double> column = rows.slice(1, 1, 1);
+    CPPUNIT_ASSERT(!column.isContiguous());
+    da.getData(column, {0, 3});
+    CPPUNIT_ASSERT_EQUAL(3.0, rows(0, 1));
+    CPPUNIT_ASSERT_EQUAL(7.0, rows(1, 1));
+    CPPUNIT_ASSERT_EQUAL(11.0, rows(2, 1));
+    CPPUNIT_ASSERT_EQUAL(8.0, rows(0, 0));
+
+    // writing a transposed view writes the transposed data
+    std::vector<double> block_values(2 * 3, 0.0);
+    NDArrayView<double> source(block_values.data(), {2, 3});
+    source(0, 2) = 100.0;
+    source(1, 0) = 200.0;
+    da.setData(source.transpose(), {0, 0});
+    std::vector<double> check(6 * 4);
+    da.getData(DataType::Double, check.data(), {6, 4}, {0, 0});
+    CPPUNIT_ASSERT_EQUAL(200.0, check[1]);
+    CPPUNIT_ASSERT_EQUAL(100.0, check[2 * 4]);
+    CPPUNIT_ASSERT_EQUAL(0.0, check[4]);
+    CPPUNIT_ASSERT_EQUAL(values[3 * 4], check[3 * 4]);
+
+    CPPUNIT_ASSERT_THROW(array.view<float>(), std::invalid_argument);
+
+    // reading into an array of a fitting shape reuses its storage
+    const NDArray::byte_type *storage = array.data();
+    da.getData(array, {2, 4}, {1, 0});
+    CPPUNIT_ASSERT(array.data() == storage);
+    CPPUNIT_ASSERT_EQUAL(NDSize({2, 4}), array.shape());
+    CPPUNIT_ASSERT_EQUAL(check[4], array.get<double>(0));
+
+    // memory of the caller is filled directly
+    std::vector<double> ring(32, -1.0);
+    da.getData(make_span(ring.data() + 8, {2, 4}), {0, 0});
+    CPPUNIT_ASSERT_EQUAL(-1.0, ring[7]);
+    CPPUNIT_ASSERT_EQUAL(check[0], ring[8]);
+    CPPUNIT_ASSERT_EQUAL(check[7], ring[15]);
+    CPPUNIT_ASSERT_EQUAL(-1.0, ring[16]);
+
+    std::pair<double *, NDSize> raw(ring.data() + 16, {4});
+    da.getData(raw, {1, 4}, {5, 0});
+    CPPUNIT_ASSERT_EQUAL(NDSize({1, 4}), raw.second);
+    CPPUNIT_ASSERT_EQUAL(check[20], ring[16]);
+    CPPUNIT_ASSERT_THROW(da.getData(raw, {2, 4}, {0, 0}), InvalidRank);
+
+    std::array<double, 4> row;
+    da.getData(row, {1, 4}, {3, 0});
+    CPPUNIT_ASSERT_EQUAL(check[12], row[0]);
+    CPPUNIT_ASSERT_EQUAL(check[15], row[3]);
+
+    std::array<double, 4> zeros{{0.0, 0.0, 0.0, 0.0}};
+    std::pair<const double *, NDSize> source_row(zeros.data(), {1, 4});
+    da.setData(source_row, {3, 0});
+    da.setData(source_row, {4, 0});
+    da.getData(DataType::Double, check.data(), {6, 4}, {0, 0});
+    CPPUNIT_ASSERT_EQUAL(0.0, check[12]);
+    CPPUNIT_ASSERT_EQUAL(0.0, check[19]);
+
+    block.deleteDataArray(da.id());
+}
+
+
 void BaseTestDataArray::testPolynomial() {
     double PI = boost::math::constants::pi<double>();
     boost::array<double, 10> coefficients1;
@@ -435,6 +515,25 @@ void BaseTestDataArray::testDimension() {
     CPPUNIT_ASSERT(dims[2].dimensionType() == nix::DimensionType::Range);
     CPPUNIT_ASSERT(dims[3].dimensionType() == nix::DimensionType::Range);
     CPPUNIT_ASSERT(dims[4].dimensionType() == nix::DimensionType::Set);
+
+    // descriptors are kept by the data array, changes are seen by all of them
+    nix::SampledDimension sampled = array2.getDimension(1).asSampledDimension();
+    sampled.offset(42.0);
+    sampled.unit("ms");
+    CPPUNIT_ASSERT(*array2.getDimension(1).asSampledDimension().offset() == 42.0);
+    CPPUNIT_ASSERT(*array2.getDimension(1).asSampledDimension().unit() == "ms");
+    nix::DataArray other = block.getDataArray(array2.id());
+    CPPUNIT_ASSERT(*other.getDimension(1).asSampledDimension().offset() == 42.0);
+    CPPUNIT_ASSERT(other.dimensionCount() == 5);
+
+    // ... and dropped when dimensions are replaced
+    array2.createSetDimension(1);
+    CPPUNIT_ASSERT(array2.getDimension(1).dimensionType() == nix::DimensionType::Set);
+    array2.createSampledDimension(1, samplingInterval);
+    CPPUNIT_ASSERT(array2.getDimension(1).dimensionType() == nix::DimensionType::Sample);
+    CPPUNIT_ASSERT(!array2.getDimension(1).asSampledDimension().offset());
+    CPPUNIT_ASSERT(array2.dimensionCount() == 5);
+
     // since deleteDimension renumbers indices to be continuous we test that too
     array2.deleteDimension(5);
     array2.deleteDimension(4);
@@ -444,6 +543,7 @@ void BaseTestDataArray::testDimension() {
     dims = array2.dimensions();
     CPPUNIT_ASSERT(array2.dimensionCount() == 0);
     CPPUNIT_ASSERT(dims.size() == 0);
+    CPPUNIT_ASSERT(!array2.getDimension(1));
 }
 
 
@@ -499,6 +599,70 @@ void BaseTestDataArray::testAliasRangeDimension() {
 
     std::vector<double> ticks_2 = rd.ticks();
     CPPUNIT_ASSERT(t.size() == ticks_2.size());
+
+    // handles taken before the data is written see the new ticks
+    std::vector<double> data = {1.0, 2.0, 3.0, 4.0};
+    DataArray alias_array = block.createDataArray("alias array", "alias_array", data);
+    nix::RangeDimension alias_dim = alias_array.appendAliasRangeDimension();
+    CPPUNIT_ASSERT(alias_dim.tickAt(2) == 3.0);
+    CPPUNIT_ASSERT(alias_dim.indexOf(3.0) == 2);
+    data = {10.0, 20.0, 30.0, 40.0, 50.0};
+    alias_array.setData(data);
+    CPPUNIT_ASSERT(alias_dim.tickCount() == 5);
+    CPPUNIT_ASSERT(alias_dim.tickAt(2) == 30.0);
+    CPPUNIT_ASSERT(alias_dim.indexOf(30.0) == 2);
+    CPPUNIT_ASSERT(alias_array.getDimension(1).asRangeDimension().ticks() == data);
+}
+
+
+void BaseTestDataArray::testDimensionHandles() {
+    // changes through one handle are seen through all others
+    DataArray da = block.createDataArray("handles", "test", nix::DataType::Double, nix::NDSize({10}));
+    CPPUNIT_ASSERT(da.dimensionCount() == 0);
+    block.getDataArray("handles").appendSampledDimension(0.5);
+    CPPUNIT_ASSERT(da.dimensionCount() == 1);
+
+    SampledDimension sd = da.getDimension(1).asSampledDimension();
+    CPPUNIT_ASSERT(sd.samplingInterval() == 0.5);
+    block.getDataArray("handles").getDimension(1).asSampledDimension().samplingInterval(2.0);
+    CPPUNIT_ASSERT(sd.samplingInterval() == 2.0);
+    CPPUNIT_ASSERT(da.getDimension(1).asSampledDimension().samplingInterval() == 2.0);
+
+    SetDimension set_dim = da.appendSetDimension();
+    std::vector<std::string> labels = {"a", "b"};
+    set_dim.labels(labels);
+    CPPUNIT_ASSERT(set_dim.labels() == labels);
+    labels = {"c"};
+    block.getDataArray("handles").getDimension(2).asSetDimension().labels(labels);
+    CPPUNIT_ASSERT(set_dim.labels() == labels);
+
+    block.getDataArray("handles").deleteDimension(1);
+    CPPUNIT_ASSERT(da.dimensionCount() == 1);
+    CPPUNIT_ASSERT(da.getDimension(1).dimensionType() == nix::DimensionType::Set);
+
+    std::vector<double> data = {1.0, 2.0, 3.0};
+    DataArray ev = block.createDataArray("events", "test", data);
+    RangeDimension a1 = ev.appendAliasRangeDimension();
+    CPPUNIT_ASSERT(a1.tickAt(2) == 3.0);
+    data = {7.0, 8.0, 9.0};
+    block.getDataArray("events").setData(data);
+    CPPUNIT_ASSERT(a1.tickAt(2) == 9.0);
+    CPPUNIT_ASSERT(a1.indexOf(8.0) == 1);
+
+    std::vector<double> ticks = {1.0, 2.0, 3.0, 4.0, 5.0};
+    RangeDimension d1 = ev.appendRangeDimension(ticks);
+    CPPUNIT_ASSERT(d1.tickAt(0) == 1.0);
+    CPPUNIT_ASSERT(d1.indexOf(4.0) == 3);
+    ticks = {10.0, 20.0, 30.0, 40.0, 50.0};
+    block.getDataArray("events").getDimension(2).asRangeDimension().ticks(ticks);
+    CPPUNIT_ASSERT(d1.tickAt(0) == 10.0);
+    CPPUNIT_ASSERT(d1.ticks() == ticks);
+    CPPUNIT_ASSERT(d1.tickAt(2) == 30.0);
+    CPPUNIT_ASSERT(d1.indexOf(40.0) == 3);
+    CPPUNIT_ASSERT(d1.indexOf(std::vector<double>({15.0, 40.0})) == std::vector<size_t>({1, 3}));
+
+    block.deleteDataArray(da);
+    block.deleteDataArray(ev);
 }
 
 
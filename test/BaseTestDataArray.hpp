@@ -30,12 +30,14 @@ public:
     void testName();
     void testDefinition();
     void testData();
+    void testArrayViews();
     void testPolynomial();
     void testPolynomialSetter();
     void testLabel();
     void testUnit();
     void testDimension();
     void testAliasRangeDimension();
+    void testDimensionHandles();
     void testOperator();
     void testValidate();
 };
@@ -6,6 +6,7 @@
 // modification, are permitted under the terms of the BSD License. See
 // LICENSE file in the root of the Project.
 
+#include <algorithm>
 #include <limits>
 #include <sstream>
 #include <iostream>
@@ -236,6 +237,16 @@ void BaseTestDimension::testSampledDimAxis() {
         axis.back(),
         std::numeric_limits<double>::round_error());
 
+    AxisView view = sd.axisView(100, 10);
+    CPPUNIT_ASSERT(view.size() == 100);
+    CPPUNIT_ASSERT(std::equal(view.begin(), view.end(), axis.begin()));
+    CPPUNIT_ASSERT(view[99] == axis[99]);
+    CPPUNIT_ASSERT(view.end() - view.begin() == 100);
+    CPPUNIT_ASSERT(*(10 + view.begin()) == *(view.begin() + 10));
+    CPPUNIT_ASSERT(std::lower_bound(view.begin(), view.end(), axis[42]) - view.begin() == 42);
+    CPPUNIT_ASSERT_THROW(view.at(100), OutOfBounds);
+    CPPUNIT_ASSERT(sd.axisView(0).empty());
+
     data_array.deleteDimension(d.index());
 }
 
@@ -418,6 +429,57 @@ void BaseTestDimension::testRangeDimIndexOf() {
     CPPUNIT_ASSERT(rd.indexOf(257.28) == 4);
     CPPUNIT_ASSERT(rd.indexOf(-257.28) == 0);
 
+    std::vector<size_t> indices = rd.indexOf(std::vector<double>{5.0, -257.28, -50., 257.28, -100.});
+    CPPUNIT_ASSERT(indices == (std::vector<size_t>{3, 0, 1, 4, 0}));
+    CPPUNIT_ASSERT(rd.indexOf(std::vector<double>()).empty());
+
+    // the ticks kept by the dimension follow writes
+    rd.ticks(std::vector<double>{0.0, 1.0, 2.0});
+    CPPUNIT_ASSERT(rd.tickCount() == 3);
+    CPPUNIT_ASSERT(rd.indexOf(5.0) == 2);
+    CPPUNIT_ASSERT(rd.tickAt(1) == 1.0);
+
+    data_array.deleteDimension(d.index());
+}
+
+
+void BaseTestDimension::testRangeDimLargeTicks() {
+    // more ticks than are kept in memory, searched on disk
+    size_t count = (1 << 20) + 4321;
+    std::vector<double> ticks(count);
+    for (size_t i = 0; i < count; i++) {
+        ticks[i] = 0.5 * static_cast<double>(i);
+    }
+    Dimension d = data_array.appendRangeDimension(ticks);
+
+    RangeDimension rd = data_array.getDimension(d.index()).asRangeDimension();
+    CPPUNIT_ASSERT(rd.tickCount() == count);
+    CPPUNIT_ASSERT(rd.tickAt(0) == 0.0);
+    CPPUNIT_ASSERT(rd.tickAt(count - 1) == ticks.back());
+    CPPUNIT_ASSERT_THROW(rd.tickAt(count), OutOfBounds);
+
+    std::vector<double> axis = rd.axis(3, 1000000);
+    CPPUNIT_ASSERT(axis == (std::vector<double>{500000.0, 500000.5, 500001.0}));
+
+    // a view reads pages of ticks as they are accessed
+    size_t view_start = 100000 - AxisView::page_size / 2;
+    AxisView view = rd.axisView(3 * AxisView::page_size, view_start);
+    CPPUNIT_ASSERT(view.size() == 3 * AxisView::page_size);
+    CPPUNIT_ASSERT(std::equal(view.begin(), view.end(), ticks.begin() + view_start));
+    CPPUNIT_ASSERT(view[2 * AxisView::page_size + 5] == ticks[view_start + 2 * AxisView::page_size + 5]);
+    CPPUNIT_ASSERT(view[7] == ticks[view_start + 7]);
+    CPPUNIT_ASSERT(*(view.end() - 1) == ticks[view_start + view.size() - 1]);
+
+    std::vector<double> positions = {-1.0, 0.0, 0.1, 1000.25, 333333.3, 500000.0, 1e9, ticks.back()};
+    std::vector<size_t> indices = rd.indexOf(positions);
+    CPPUNIT_ASSERT(indices.size() == positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        size_t expected = positions[i] > ticks.back() ? count - 1 :
+            std::lower_bound(ticks.begin(), ticks.end(), positions[i]) - ticks.begin();
+        CPPUNIT_ASSERT(indices[i] == expected);
+        CPPUNIT_ASSERT(rd.indexOf(positions[i]) == expected);
+    }
+
     data_array.deleteDimension(d.index());
 }
 
@@ -463,6 +525,12 @@ void BaseTestDimension::testRangeDimAxis() {
 
     CPPUNIT_ASSERT_THROW(rd.axis(10), OutOfBounds);
     CPPUNIT_ASSERT_THROW(rd.axis(2, 10), OutOfBounds);
+
+    AxisView view = rd.axisView(3, 1);
+    CPPUNIT_ASSERT(view.size() == 3);
+    CPPUNIT_ASSERT(view[0] == -10.0 && view[2] == 10.0);
+    CPPUNIT_ASSERT(view.toVector() == rd.axis(3, 1));
+    CPPUNIT_ASSERT_THROW(rd.axisView(2, 10), OutOfBounds);
 }
 
 
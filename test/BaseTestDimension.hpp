@@ -43,6 +43,7 @@ public:
     void testRangeTicks();
     void testRangeDimUnit();
     void testRangeDimIndexOf();
+    void testRangeDimLargeTicks();
     void testRangeDimTickAt();
     void testRangeDimAxis();
 
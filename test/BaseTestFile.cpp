@@ -81,6 +81,9 @@ void BaseTestFile::testBlockAccess() {
     CPPUNIT_ASSERT_THROW(file_open.createBlock("", "dataset"), EmptyString);
     CPPUNIT_ASSERT(file_open.blockCount() == names.size());
     CPPUNIT_ASSERT(file_open.blocks().size() == names.size());
+    CPPUNIT_ASSERT(file_open.blocks(util::Query::type("dataset")).size() == names.size());
+    CPPUNIT_ASSERT(file_open.blocks(util::Query::id(ids[1])).size() == 1);
+    CPPUNIT_ASSERT(file_open.blocks(util::Query::type("session")).empty());
 
     for (const auto &name : names) {
         Block bl_name = file_open.getBlock(name);
@@ -130,6 +133,9 @@ void BaseTestFile::testSectionAccess() {
 
     CPPUNIT_ASSERT(file_open.sectionCount() == names.size());
     CPPUNIT_ASSERT(file_open.sections().size() == names.size());
+    CPPUNIT_ASSERT(file_open.sections(util::Query::type("root section")).size() == names.size());
+    std::vector<Section> matches = file_open.sections(util::Query::name("section_c") || util::Query::id(ids[0]));
+    CPPUNIT_ASSERT(matches.size() == 2);
 
     for (auto it = ids.begin(); it != ids.end(); it++) {
         Section sec = file_open.getSection(*it);
@@ -180,3 +186,172 @@ void BaseTestFile::testReopen() {
 
     CPPUNIT_ASSERT(file_open.fileMode() == FileMode::Overwrite);
 }
+
+
+void BaseTestFile::testBatch() {
+    Batch inactive;
+    CPPUNIT_ASSERT(!inactive.isActive());
+    CPPUNIT_ASSERT_THROW(file_null.beginBatch(), UninitializedEntity);
+
+    Section sec;
+    {
+        Batch batch = file_open.beginBatch();
+        CPPUNIT_ASSERT(batch.isActive());
+
+        sec = file_open.createSection("batch_section", "test");
+        CPPUNIT_ASSERT_THROW(file_open.createSection("batch_section", "test"), DuplicateName);
+        CPPUNIT_ASSERT(file_open.hasSection("batch_section"));
+        CPPUNIT_ASSERT(file_open.hasSection(sec.id()));
+
+        {
+            Batch nested = file_open.beginBatch();
+            Section child = sec.createSection("child", "test");
+            CPPUNIT_ASSERT_THROW(sec.createSection("child", "test"), DuplicateName);
+            CPPUNIT_ASSERT(sec.deleteSection(child));
+            CPPUNIT_ASSERT(!sec.hasSection("child"));
+            nested.commit();
+        }
+
+        for (int i = 0; i < 100; i++) {
+            sec.createProperty("prop_" + util::numToStr(i), Value(i));
+        }
+        CPPUNIT_ASSERT_THROW(sec.createProperty("prop_42", Value(42)), DuplicateName);
+        CPPUNIT_ASSERT(sec.hasProperty("prop_99"));
+        CPPUNIT_ASSERT(!sec.hasProperty("prop_100"));
+
+        Property p = sec.getProperty("prop_0");
+        CPPUNIT_ASSERT(sec.hasProperty(p.id()));
+        CPPUNIT_ASSERT(sec.deleteProperty(p));
+        CPPUNIT_ASSERT(!sec.hasProperty("prop_0"));
+        CPPUNIT_ASSERT_NO_THROW(sec.createProperty("prop_0", Value(0)));
+
+        batch.commit();
+        CPPUNIT_ASSERT(!batch.isActive());
+        CPPUNIT_ASSERT_NO_THROW(batch.commit());
+    }
+
+    CPPUNIT_ASSERT(sec.propertyCount() == 100);
+    CPPUNIT_ASSERT(sec.updatedAt() >= startup_time);
+    CPPUNIT_ASSERT(sec.getProperty("prop_42").createdAt() >= startup_time);
+    CPPUNIT_ASSERT_THROW(sec.createProperty("prop_42", Value(42)), DuplicateName);
+
+    // abandoned batches keep their changes but no longer index names
+    Batch moved;
+    {
+        Batch abandoned = file_open.beginBatch();
+        sec.createSection("abandoned", "test");
+        moved = file_open.beginBatch();
+        CPPUNIT_ASSERT(moved.isActive());
+    }
+    CPPUNIT_ASSERT(sec.hasSection("abandoned"));
+    moved = Batch();
+    CPPUNIT_ASSERT(!moved.isActive());
+    CPPUNIT_ASSERT(sec.deleteSection("abandoned"));
+    CPPUNIT_ASSERT(!sec.hasSection("abandoned"));
+    CPPUNIT_ASSERT_NO_THROW(sec.createSection("abandoned", "test"));
+}
+
+
+void BaseTestFile::testBatchValues() {
+    Batch batch = file_open.beginBatch();
+    Section sec = file_open.createSection("batch_values", "test");
+    for (int i = 0; i < 10; i++) {
+        sec.createProperty("prop_" + util::numToStr(i), Value(i));
+    }
+    batch.commit();
+
+    CPPUNIT_ASSERT(sec.getProperty("prop_7").values()[0].get<int>() == 7);
+    File reopened = File::open(file_open.location(), FileMode::ReadOnly);
+    CPPUNIT_ASSERT(reopened.getSection("batch_values").getProperty("prop_7").values()[0].get<int>() == 7);
+    reopened.close();
+}
+
+
+void BaseTestFile::testMetadataSnapshot() {
+    CPPUNIT_ASSERT_THROW(file_null.metadataSnapshot(), UninitializedEntity);
+    MetadataSnapshot empty;
+    CPPUNIT_ASSERT(!empty.isCurrent());
+
+    Section root = file_open.createSection("snap_root", "nix.experiment");
+    Section trial = root.createSection("trial", "nix.trial");
+    Section subject = root.createSection("subject", "nix.subject");
+    Section setup = trial.createSection("setup", "nix.setup");
+    Section other = file_open.createSection("snap_other", "nix.defaults");
+    root.createProperty("date", Value("2016-01-01"));
+    other.createProperty("date", Value("1970-01-01"));
+    other.createProperty("rate", Value(1000.0)).unit("Hz");
+    setup.link(other);
+
+    MetadataSnapshot snap = file_open.metadataSnapshot();
+    CPPUNIT_ASSERT(snap.isCurrent());
+    CPPUNIT_ASSERT_EQUAL(file_open.findSections().size(), static_cast<size_t>(snap.sectionCount()));
+    CPPUNIT_ASSERT_EQUAL(file_open.sectionCount(), static_cast<ndsize_t>(snap.sections().size()));
+    CPPUNIT_ASSERT(snap.propertyCount() >= 3);
+
+    Section s = snap.getSection(setup.id());
+    CPPUNIT_ASSERT(s && s.name() == "setup" && s.type() == "nix.setup");
+    CPPUNIT_ASSERT(s.parent().id() == trial.id());
+    CPPUNIT_ASSERT(s.parent().parent().id() == root.id());
+    CPPUNIT_ASSERT(s.parent().parent().parent() == none);
+    CPPUNIT_ASSERT(s.link().id() == other.id());
+    CPPUNIT_ASSERT(!snap.getSection(util::createId()));
+
+    std::vector<Section> found = snap.findSections(util::TypeFilter<Section>("nix.trial"));
+    CPPUNIT_ASSERT(found.size() == 1 && found[0].id() == trial.id());
+    CPPUNIT_ASSERT(snap.sections(util::NameFilter<Section>("snap_root")).size() == 1);
+
+    std::vector<Section> related = s.findRelated(util::TypeFilter<Section>("nix.subject"));
+    CPPUNIT_ASSERT(related.size() == 1 && related[0].id() == subject.id());
+    CPPUNIT_ASSERT(setup.findRelated(util::TypeFilter<Section>("nix.subject"))[0].id() == subject.id());
+
+    std::vector<Property> props = s.inheritedProperties();
+    CPPUNIT_ASSERT(props.size() == 2);
+    Property rate = s.link().getProperty("rate");
+    CPPUNIT_ASSERT(rate.unit() && *rate.unit() == "Hz");
+
+    // snapshots are read-only and invalidated by writes
+    CPPUNIT_ASSERT_THROW(s.createSection("new", "test"), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(rate.unit("kHz"), std::runtime_error);
+    CPPUNIT_ASSERT(snap.isCurrent());
+
+    trial.definition("modified");
+    CPPUNIT_ASSERT(!snap.isCurrent());
+    CPPUNIT_ASSERT_THROW(snap.findSections(), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(s.name(), std::runtime_error);
+
+    MetadataSnapshot fresh = file_open.metadataSnapshot();
+    CPPUNIT_ASSERT(*fresh.getSection(trial.id()).definition() == "modified");
+    setup.deleteSection(util::createId());
+    CPPUNIT_ASSERT(fresh.isCurrent());
+    root.deleteSection(trial);
+    CPPUNIT_ASSERT(!fresh.isCurrent());
+
+    file_open.deleteSection(root);
+    file_open.deleteSection(other);
+}
+
+
+void BaseTestFile::testMetadataSnapshotValues() {
+    Section root = file_open.createSection("snap_values", "nix.experiment");
+    Section trial = root.createSection("trial", "nix.trial");
+    Property date = root.createProperty("date", Value("2016-01-01"));
+    Property rate = trial.createProperty("rate", Value(1000.0));
+
+    MetadataSnapshot snap = file_open.metadataSnapshot();
+    CPPUNIT_ASSERT(snap.getSection(trial.id()).getProperty("rate").values()[0].get<double>() == 1000.0);
+    CPPUNIT_ASSERT(snap.getSection(root.id()).getProperty("date").values()[0].get<std::string>() == "2016-01-01");
+    CPPUNIT_ASSERT(snap.getSection(root.id()).propertyValues(2) == root.propertyValues(2));
+
+    // writing or deleting values invalidates the snapshot
+    rate.values({Value(500.0), Value(250.0)});
+    CPPUNIT_ASSERT(!snap.isCurrent());
+    MetadataSnapshot fresh = file_open.metadataSnapshot();
+    std::vector<Value> values = fresh.getSection(trial.id()).getProperty("rate").values();
+    CPPUNIT_ASSERT(values.size() == 2 && values[1].get<double>() == 250.0);
+
+    date.deleteValues();
+    CPPUNIT_ASSERT(!fresh.isCurrent());
+    CPPUNIT_ASSERT(file_open.metadataSnapshot().getSection(root.id()).getProperty("date").valueCount() == 0);
+
+    file_open.deleteSection(root);
+}
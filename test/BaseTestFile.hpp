@@ -47,6 +47,10 @@ public:
     void testReopen();
     void testCheckHeader();
     void testCompare();
+    void testBatch();
+    void testBatchValues();
+    void testMetadataSnapshot();
+    void testMetadataSnapshotValues();
 
 };
 
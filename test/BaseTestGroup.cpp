@@ -147,6 +147,15 @@ void BaseTestGroup::testTags() {
     CPPUNIT_ASSERT_THROW(g.getTag(42), nix::OutOfBounds);
     CPPUNIT_ASSERT(g.tagCount() == 0);
 
+    g.tags(tags);
+    CPPUNIT_ASSERT(g.tagCount() == tags.size());
+    std::vector<Tag> fewer(tags.begin() + 1, tags.end());
+    g.tags(fewer);
+    CPPUNIT_ASSERT(g.tagCount() == fewer.size());
+    CPPUNIT_ASSERT(!g.hasTag(tags[0].name()));
+    CPPUNIT_ASSERT(g.getTag(tags[1].name()).id() == tags[1].id());
+    CPPUNIT_ASSERT_THROW(g.tags({tags[0], t}), std::runtime_error);
+    CPPUNIT_ASSERT(g.tagCount() == fewer.size());
     g.tags(tags);
     CPPUNIT_ASSERT(g.tagCount() == tags.size());
     g.addTag(tag_1);
@@ -115,6 +115,72 @@ void BaseTestProperty::testValues()
 }
 
 
+void BaseTestProperty::testValueColumn()
+{
+    nix::Section section = file.createSection("Columns", "test");
+
+    std::vector<nix::Value> values;
+    for (int32_t i = 0; i < 100; i++) {
+        nix::Value v(i * 3);
+        v.uncertainty = i * 0.5;
+        if (i % 10 == 0) {
+            v.reference = "ref_" + std::to_string(i);
+            v.checksum = "sum";
+        }
+        values.push_back(v);
+    }
+    nix::Property p1 = section.createProperty("intProperty", values);
+
+    nix::ValueColumn column = p1.valueColumn();
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::Int32, column.dataType());
+    CPPUNIT_ASSERT_EQUAL(values.size(), column.size());
+    CPPUNIT_ASSERT_THROW(column.data<double>(), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(column.string(0), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(column.uncertainty(values.size()), nix::OutOfBounds);
+
+    const int32_t *data = column.data<int32_t>();
+    for (size_t i = 0; i < values.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(values[i].get<int32_t>(), data[i]);
+        CPPUNIT_ASSERT_EQUAL(values[i].uncertainty, column.uncertainty(i));
+        CPPUNIT_ASSERT_EQUAL(values[i].reference, std::string(column.reference(i)));
+        CPPUNIT_ASSERT_EQUAL(values[i].checksum, std::string(column.checksum(i)));
+        CPPUNIT_ASSERT_EQUAL(std::string(), std::string(column.filename(i)));
+        CPPUNIT_ASSERT_EQUAL(values[i], column.value(i));
+    }
+    CPPUNIT_ASSERT(column.toValues() == p1.values());
+
+    std::vector<nix::Value> strValues = { nix::Value("Freude"),
+                                          nix::Value("schoener"),
+                                          nix::Value("") };
+    strValues[1].encoder = "utf-8";
+    nix::Property p2 = section.createProperty("strProperty", strValues);
+    column = p2.valueColumn();
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::String, column.dataType());
+    CPPUNIT_ASSERT_THROW(column.data<int32_t>(), std::invalid_argument);
+    CPPUNIT_ASSERT_EQUAL(std::string("Freude"), std::string(column.string(0)));
+    CPPUNIT_ASSERT_EQUAL(std::string("schoener"), std::string(column.string(1)));
+    CPPUNIT_ASSERT_EQUAL(std::string(), std::string(column.string(2)));
+    CPPUNIT_ASSERT_EQUAL(std::string("utf-8"), std::string(column.encoder(1)));
+    CPPUNIT_ASSERT(column.toValues() == strValues);
+
+    // columns built in memory
+    nix::ValueColumn mem(strValues);
+    CPPUNIT_ASSERT(mem.toValues() == strValues);
+    CPPUNIT_ASSERT_THROW(mem.push_back(nix::Value(1.0)), std::invalid_argument);
+
+    nix::ValueColumn bools;
+    bools.append(true, 0.0, nullptr, nullptr, nullptr, nullptr);
+    bools.append(false, 1.0, "r", nullptr, nullptr, nullptr);
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::Bool, bools.dataType());
+    CPPUNIT_ASSERT_EQUAL(true, bools.get<bool>(0));
+    CPPUNIT_ASSERT_EQUAL(false, bools.get<bool>(1));
+    CPPUNIT_ASSERT_EQUAL(std::string("r"), std::string(bools.reference(1)));
+
+    nix::Property p3 = section.createProperty("empty", nix::DataType::Double);
+    CPPUNIT_ASSERT(p3.valueColumn().empty());
+}
+
+
 void BaseTestProperty::testDataType() {
     nix::Section section = file.createSection("Area51", "Boolean");
     std::vector<nix::Value> strValues = { nix::Value("Freude"),
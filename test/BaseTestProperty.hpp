@@ -33,6 +33,7 @@ public:
     void testMapping();
     void testDataType();
     void testValues();
+    void testValueColumn();
     void testUnit();
     void testIsValidEntity();
 
@@ -70,6 +70,22 @@ void BaseTestSection::testParent() {
     CPPUNIT_ASSERT(child.parent().id() == section.id());
 
     CPPUNIT_ASSERT(child.parent().parent() == nix::none);
+
+    // parents of sections that are reached via links
+    Section grandchild = child.createSection("grandchild", "section");
+    section_other.link(grandchild);
+    CPPUNIT_ASSERT(section_other.link().parent().id() == child.id());
+    CPPUNIT_ASSERT(section_other.link().parent().parent().id() == section.id());
+
+    Block b = file.createBlock("parent_block", "test");
+    b.metadata(grandchild);
+    CPPUNIT_ASSERT(b.metadata().parent().id() == child.id());
+    b.metadata(section);
+    CPPUNIT_ASSERT(b.metadata().parent() == nix::none);
+
+    child.deleteSection(grandchild.id());
+    CPPUNIT_ASSERT(!section_other.link());
+    file.deleteBlock(b);
 }
 
 
@@ -355,6 +371,60 @@ void BaseTestSection::testPropertyAccess() {
 }
 
 
+void BaseTestSection::testPropertyValues() {
+    CPPUNIT_ASSERT(section.propertyValues().empty());
+
+    section.createProperty("rate", Value(1000.0));
+    section.createProperty("names", std::vector<Value>{Value("a"), Value("b")});
+    Section trial = section.createSection("trial", "test");
+    trial.createProperty("count", Value(int32_t(42)));
+    Section setup = trial.createSection("setup", "test");
+    setup.createProperty("active", Value(true));
+
+    std::map<std::string, std::vector<Value>> values = section.propertyValues();
+    CPPUNIT_ASSERT(values.size() == 2);
+    CPPUNIT_ASSERT(values.count("rate") == 1 && values.count("names") == 1);
+
+    values = section.propertyValues(1);
+    CPPUNIT_ASSERT(values.size() == 3);
+    CPPUNIT_ASSERT(values.count("trial/count") == 1);
+
+    values = section.propertyValues(std::numeric_limits<size_t>::max());
+    CPPUNIT_ASSERT(values.size() == 4);
+    CPPUNIT_ASSERT(values.count("trial/setup/active") == 1);
+    CPPUNIT_ASSERT(trial.propertyValues(0).size() == 1);
+
+    section.deleteSection(trial);
+    section.deleteProperty("rate");
+    section.deleteProperty("names");
+    CPPUNIT_ASSERT(section.propertyValues(1).empty());
+}
+
+
+void BaseTestSection::testPropertyValuesData() {
+    section.createProperty("rate", Value(1000.0));
+    section.createProperty("names", std::vector<Value>{Value("a"), Value("b")});
+    Section trial = section.createSection("trial", "test");
+    trial.createProperty("count", Value(int32_t(42)));
+    Section setup = trial.createSection("setup", "test");
+    setup.createProperty("active", Value(true));
+
+    std::map<std::string, std::vector<Value>> values = section.propertyValues();
+    CPPUNIT_ASSERT(values["rate"][0].get<double>() == 1000.0);
+    CPPUNIT_ASSERT(values["names"].size() == 2);
+    CPPUNIT_ASSERT(values["names"][1].get<std::string>() == "b");
+
+    values = section.propertyValues(std::numeric_limits<size_t>::max());
+    CPPUNIT_ASSERT(values["trial/count"][0].get<int32_t>() == 42);
+    CPPUNIT_ASSERT(values["trial/setup/active"][0].get<bool>());
+    CPPUNIT_ASSERT(values["trial/count"] == trial.getProperty("count").values());
+
+    section.deleteSection(trial);
+    section.deleteProperty("rate");
+    section.deleteProperty("names");
+}
+
+
 void BaseTestSection::testOperators() {
     CPPUNIT_ASSERT(section_null == false);
     CPPUNIT_ASSERT(section_null == none);
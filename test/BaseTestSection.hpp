@@ -36,6 +36,8 @@ public:
     void testFindSection();
     void testFindRelated();
     void testPropertyAccess();
+    void testPropertyValues();
+    void testPropertyValuesData();
 
     void testOperators();
     void testUpdatedAt();
@@ -243,6 +243,30 @@ void BaseTestTag::testReferences() {
         CPPUNIT_ASSERT(tag.removeReference(refs[i]));
     }
     CPPUNIT_ASSERT(tag.referenceCount() == 0);
+
+    // replacing the references keeps common ones, adds and removes the rest
+    std::vector<DataArray> first(refs.begin(), refs.begin() + 3);
+    std::vector<DataArray> second(refs.begin() + 2, refs.end());
+    tag.references(first);
+    CPPUNIT_ASSERT(tag.referenceCount() == first.size());
+    tag.references(second);
+    CPPUNIT_ASSERT(tag.referenceCount() == second.size());
+    CPPUNIT_ASSERT(!tag.hasReference(refs[0]) && !tag.hasReference(refs[1].name()));
+    for (const auto &ref : second) {
+        CPPUNIT_ASSERT(tag.hasReference(ref.name()));
+        CPPUNIT_ASSERT(tag.getReference(ref.name()).id() == ref.id());
+    }
+
+    Block other = file.createBlock("other block", "test");
+    DataArray foreign = other.createDataArray("foreign", "test", DataType::Double, NDSize({0}));
+    std::vector<DataArray> invalid = {refs[0], foreign};
+    CPPUNIT_ASSERT_THROW(tag.references(invalid), std::runtime_error);
+    CPPUNIT_ASSERT(tag.referenceCount() == second.size());
+    file.deleteBlock(other);
+
+    tag.references(std::vector<DataArray>());
+    CPPUNIT_ASSERT(tag.referenceCount() == 0);
+
     DataArray a;
     CPPUNIT_ASSERT(!tag.hasReference(a));
     CPPUNIT_ASSERT_THROW(tag.addReference(a), UninitializedEntity);
@@ -11,6 +11,8 @@
 #include <nix.hpp>
 #include <nix/NDArray.hpp>
 
+#include "Benchmark.hpp"
+
 #include <cstdio>
 #include <queue>
 #include <random>
@@ -57,26 +59,6 @@ auto data_type_dispatch(nix::DataType dtype, Func &&F, Args&&... args)
 
 /* ************************************ */
 
-class Stopwatch {
-
-public:
-    typedef std::chrono::high_resolution_clock::time_point time_point_t;
-    typedef std::chrono::high_resolution_clock clock_t;
-
-    Stopwatch() : t_start(clock_t::now()) { };
-
-    ssize_t ms() {
-        time_point_t t_end = clock_t::now();
-        ssize_t count = std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_start).count();
-        return count;
-    }
-
-private:
-    time_point_t t_start;
-};
-
-/* ************************************ */
-
 class RndGenBase {
 public:
     RndGenBase() : rd(), rd_gen(rd()) { };
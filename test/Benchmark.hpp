@@ -0,0 +1,73 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BENCHMARK_HPP
+#define NIX_BENCHMARK_HPP
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+/* ************************************ */
+
+class Stopwatch {
+
+public:
+    typedef std::chrono::high_resolution_clock::time_point time_point_t;
+    typedef std::chrono::high_resolution_clock clock_t;
+
+    Stopwatch() : t_start(clock_t::now()) { };
+
+    ssize_t ms() {
+        time_point_t t_end = clock_t::now();
+        ssize_t count = std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_start).count();
+        return count;
+    }
+
+private:
+    time_point_t t_start;
+};
+
+/* ************************************ */
+
+struct Report {
+    std::string name;
+    size_t      count;
+    ssize_t     millis;
+    std::string detail;  // appended to the line of the report, if any
+};
+
+
+inline Report measure(const std::string &name, size_t count, const std::function<void()> &fn) {
+    Stopwatch sw;
+    fn();
+    return Report{name, count, sw.ms(), ""};
+}
+
+
+// one line per report; what is counted, e.g. "calls" or "entities"
+inline void print_reports(const std::vector<Report> &reports, const std::string &what) {
+    std::cout << " === Reports ===" << std::endl;
+    std::cout.precision(5);
+    std::cout.unsetf (std::ios::floatfield);
+    for (const Report &r : reports) {
+        std::cout << r.name << ", " << r.count << " " << what << ", "
+                  << r.millis << " ms, "
+                  << (r.millis > 0 ? r.count * 1000.0 / r.millis : 0.0) << " N/s";
+        if (!r.detail.empty()) {
+            std::cout << ", " << r.detail;
+        }
+        std::cout << std::endl;
+    }
+}
+
+#endif // NIX_BENCHMARK_HPP
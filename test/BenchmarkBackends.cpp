@@ -0,0 +1,121 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include "Benchmark.hpp"
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* ************************************ */
+
+static Report measure(const std::string &backend, const std::string &name, size_t count,
+                      const std::function<void()> &fn) {
+    return measure(backend + ": " + name, count, fn);
+}
+
+/* ************************************ */
+
+// the same metadata work load for every back-end
+static void run_backend(const std::string &backend, const std::string &location, size_t n,
+                        std::vector<Report> &reports) {
+    nix::File file = nix::File::open(location, nix::FileMode::Overwrite, backend);
+    nix::Block block = file.createBlock("block", "nix.session");
+
+    std::vector<std::string> names, ids;
+    for (size_t i = 0; i < n; i++) {
+        names.push_back("array_" + nix::util::numToStr(i));
+    }
+
+    reports.push_back(measure(backend, "create data arrays", n, [&] {
+        for (const std::string &name : names) {
+            nix::DataArray da = block.createDataArray(name, "nix.sampled", nix::DataType::Double, {0});
+            da.label("voltage");
+            da.unit("mV");
+            da.appendSampledDimension(0.1).unit("ms");
+            ids.push_back(da.id());
+        }
+    }));
+
+    reports.push_back(measure(backend, "hasDataArray(name)", n, [&] {
+        for (const std::string &name : names) {
+            block.hasDataArray(name);
+        }
+    }));
+
+    reports.push_back(measure(backend, "getDataArray(name)", n, [&] {
+        for (const std::string &name : names) {
+            block.getDataArray(name);
+        }
+    }));
+
+    reports.push_back(measure(backend, "getDataArray(id)", n, [&] {
+        for (const std::string &id : ids) {
+            block.getDataArray(id);
+        }
+    }));
+
+    reports.push_back(measure(backend, "getDataArray(index)", n, [&] {
+        for (size_t i = 0; i < n; i++) {
+            block.getDataArray(i);
+        }
+    }));
+
+    std::vector<nix::DataArray> arrays = block.dataArrays();
+    reports.push_back(measure(backend, "label() + unit()", n, [&] {
+        for (const nix::DataArray &da : arrays) {
+            da.label();
+            da.unit();
+        }
+    }));
+
+    reports.push_back(measure(backend, "getDimension(1)", n, [&] {
+        for (const nix::DataArray &da : arrays) {
+            da.getDimension(1);
+        }
+    }));
+    arrays.clear();
+
+    reports.push_back(measure(backend, "create sections", n, [&] {
+        for (const std::string &name : names) {
+            file.createSection(name, "nix.recording");
+        }
+    }));
+
+    reports.push_back(measure(backend, "getSection(name)", n, [&] {
+        for (const std::string &name : names) {
+            file.getSection(name);
+        }
+    }));
+
+    file.close();
+}
+
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+
+    std::vector<Report> reports;
+    std::cout << "Performing back-end tests (" << n << " entities)..." << std::endl;
+
+    run_backend("hdf5", "backends.h5", n, reports);
+#ifdef ENABLE_FS_BACKEND
+    run_backend("file", "backends_fs", n, reports);
+#else
+    std::cout << "filesystem back-end not enabled, skipping it" << std::endl;
+#endif
+
+    print_reports(reports, "entities");
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include "Benchmark.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* ************************************ */
+
+/*
+ * Importer-style construction of metadata: a tree of sections with
+ * a fixed number of properties each, holding a few values per property.
+ */
+static void import_metadata(nix::File &file, size_t n_props, size_t props_per_section) {
+    nix::Section root = file.createSection("experiment", "nix.experiment");
+    nix::Section sec;
+
+    for (size_t i = 0; i < n_props; i++) {
+        if (i % props_per_section == 0) {
+            sec = root.createSection("trial_" + nix::util::numToStr(i / props_per_section), "nix.trial");
+        }
+
+        std::vector<nix::Value> values = {nix::Value(static_cast<double>(i)), nix::Value(1.0), nix::Value(2.0)};
+        nix::Property p = sec.createProperty("property_" + nix::util::numToStr(i), values);
+        p.unit("mV");
+    }
+}
+
+
+static Report run_import(const std::string &name, size_t n_props, size_t props_per_section, bool batched) {
+    nix::File file = nix::File::open(name, nix::FileMode::Overwrite);
+
+    Stopwatch sw;
+    if (batched) {
+        nix::Batch batch = file.beginBatch();
+        import_metadata(file, n_props, props_per_section);
+        batch.commit();
+    } else {
+        import_metadata(file, n_props, props_per_section);
+    }
+    ssize_t ms = sw.ms();
+
+    file.close();
+    return Report{batched ? "import (batch)" : "import", n_props, ms, ""};
+}
+
+/*
+ * Reading a single property with many values, once as Value entities
+ * and once as ValueColumn.
+ */
+static void run_value_reads(const std::string &name, size_t n_values, std::vector<Report> &reports) {
+    nix::File file = nix::File::open(name, nix::FileMode::Overwrite);
+    nix::Section sec = file.createSection("values", "nix.trial");
+
+    std::vector<nix::Value> values;
+    values.reserve(n_values);
+    for (size_t i = 0; i < n_values; i++) {
+        values.emplace_back("stimulus_" + nix::util::numToStr(i));
+        values.back().uncertainty = 0.1;
+    }
+    nix::Property p = sec.createProperty("labels", values);
+
+    const size_t repeats = 10;
+    size_t n = 0;
+
+    Stopwatch sw;
+    for (size_t i = 0; i < repeats; i++) {
+        n += p.values().size();
+    }
+    reports.push_back(Report{"values() read", n, sw.ms(), ""});
+
+    n = 0;
+    Stopwatch sw_column;
+    for (size_t i = 0; i < repeats; i++) {
+        n += p.valueColumn().size();
+    }
+    reports.push_back(Report{"valueColumn() read", n, sw_column.ms(), ""});
+
+    file.close();
+}
+
+/* ************************************ */
+
+int main(int argc, char **argv)
+{
+    size_t n_props = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const size_t props_per_section = 1000;
+
+    std::vector<Report> reports;
+
+    std::cout << "Performing metadata import tests (" << n_props << " properties)..." << std::endl;
+    reports.push_back(run_import("metadata_import.h5", n_props, props_per_section, false));
+    reports.push_back(run_import("metadata_import_batch.h5", n_props, props_per_section, true));
+    run_value_reads("metadata_values.h5", n_props, reports);
+
+    print_reports(reports, "entities");
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include "Benchmark.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* ************************************ */
+
+// count all allocations done with operator new
+
+static std::atomic<size_t> allocations(0);
+
+static void *counted_malloc(size_t size) {
+    allocations++;
+    void *p = std::malloc(size ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new(size_t size) {
+    return counted_malloc(size);
+}
+
+void *operator new[](size_t size) {
+    return counted_malloc(size);
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+    std::free(p);
+}
+
+/* ************************************ */
+
+// like measure(), with the allocations per call as detail
+static Report measure_allocs(const std::string &name, size_t count, const std::function<void()> &fn) {
+    size_t before = allocations;
+    Stopwatch sw;
+    fn();
+    ssize_t millis = sw.ms();
+    size_t allocs = allocations - before;
+
+    std::ostringstream detail;
+    detail.precision(5);
+    detail << static_cast<double>(allocs) / count << " allocations/call";
+    return Report{name, count, millis, detail.str()};
+}
+
+/* ************************************ */
+
+int main(int argc, char **argv)
+{
+    size_t n_calls = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t n_reads = n_calls / 100;
+
+    std::vector<Report> reports;
+    std::cout << "Performing NDSize tests (" << n_calls << " calls, " << n_reads << " reads)..." << std::endl;
+
+    nix::ndsize_t checksum = 0;
+    reports.push_back(measure_allocs("construct 1-3-D", n_calls, [&] {
+        for (size_t i = 0; i < n_calls; i++) {
+            nix::NDSize a({i, i + 1});
+            nix::NDSize b(3, i);
+            nix::NDSize c = {i};
+            checksum += a[0] + b[2] + c[0];
+        }
+    }));
+
+    nix::NDSize count = {10, 20, 3};
+    nix::NDSize offset = {1, 2, 0};
+    reports.push_back(measure_allocs("copy and move", n_calls, [&] {
+        for (size_t i = 0; i < n_calls; i++) {
+            nix::NDSize a(count);
+            nix::NDSize b(std::move(a));
+            a = offset;
+            swap(a, b);
+            checksum += a[1] + b[1];
+        }
+    }));
+
+    reports.push_back(measure_allocs("arithmetic", n_calls, [&] {
+        for (size_t i = 0; i < n_calls; i++) {
+            nix::NDSize end = offset + count;
+            nix::NDSize inner = end + 1;
+            checksum += (inner * count).nelms() + (offset + count > end);
+        }
+    }));
+
+    nix::File file = nix::File::open("test_ndsize.h5", nix::FileMode::Overwrite);
+    nix::Block block = file.createBlock("ndsize", "bench");
+    nix::DataArray array = block.createDataArray("data", "bench", nix::DataType::Double, nix::NDSize({100, 100, 3}));
+    std::vector<double> values(100 * 100 * 3, 1.0);
+    array.setData(nix::DataType::Double, values.data(), nix::NDSize({100, 100, 3}), nix::NDSize({0, 0, 0}));
+    nix::DataView view(array, nix::NDSize({50, 50, 3}), nix::NDSize({10, 10, 0}));
+
+    std::vector<double> buffer(10 * 20 * 3);
+    double sum = 0.0;
+    reports.push_back(measure_allocs("DataArray direct read", n_reads, [&] {
+        for (size_t i = 0; i < n_reads; i++) {
+            array.getDataDirect(nix::DataType::Double, buffer.data(), count, offset);
+            sum += buffer[0];
+        }
+    }));
+
+    reports.push_back(measure_allocs("DataArray read", n_reads, [&] {
+        for (size_t i = 0; i < n_reads; i++) {
+            array.getData(nix::DataType::Double, buffer.data(), count, offset);
+            sum += buffer[0];
+        }
+    }));
+
+    reports.push_back(measure_allocs("DataView read", n_reads, [&] {
+        for (size_t i = 0; i < n_reads; i++) {
+            view.getData(nix::DataType::Double, buffer.data(), count, offset);
+            sum += buffer[0];
+        }
+    }));
+
+    std::cout << "(checksum " << checksum << ", " << sum << ")" << std::endl;
+
+    print_reports(reports, "calls");
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include "Benchmark.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* ************************************ */
+
+int main(int argc, char **argv)
+{
+    size_t n_refs = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+
+    nix::File file = nix::File::open("references.h5", nix::FileMode::Overwrite);
+    nix::Block block = file.createBlock("block", "nix.session");
+
+    std::vector<std::string> names;
+    for (size_t i = 0; i < n_refs; i++) {
+        names.push_back("array_" + nix::util::numToStr(i));
+        block.createDataArray(names.back(), "nix.sampled", nix::DataType::Double, {0});
+    }
+
+    nix::Tag tag = block.createTag("tag", "nix.stimulus", {0.0});
+    nix::Group group = block.createGroup("group", "nix.group");
+
+    // the second half of the first set and the first half of the second one overlap;
+    // data arrays are only kept open while they are needed, since HDF5 visits all
+    // open objects whenever a link is deleted
+    auto arrays = [&](size_t begin, size_t end) {
+        std::vector<nix::DataArray> ret;
+        for (size_t i = begin; i < end; i++) {
+            ret.push_back(block.getDataArray(names[i]));
+        }
+        return ret;
+    };
+    const size_t first_end = n_refs / 2 + n_refs / 4, second_begin = n_refs / 4;
+
+    std::vector<Report> reports;
+    std::cout << "Performing reference tests (" << n_refs << " data arrays)..." << std::endl;
+
+    for (int i = 0; i < 2; i++) {
+        std::vector<nix::DataArray> first = arrays(0, first_end);
+        std::vector<nix::DataArray> second = arrays(second_begin, n_refs);
+        if (i == 0) {
+            reports.push_back(measure("tag: set references", first.size(), [&] { tag.references(first); }));
+            reports.push_back(measure("tag: replace references", second.size(), [&] { tag.references(second); }));
+        } else {
+            reports.push_back(measure("group: set data arrays", first.size(), [&] { group.dataArrays(first); }));
+            reports.push_back(measure("group: replace data arrays", second.size(), [&] { group.dataArrays(second); }));
+        }
+    }
+
+    reports.push_back(measure("tag: hasReference(name)", n_refs, [&] {
+        for (const std::string &name : names) {
+            tag.hasReference(name);
+        }
+    }));
+    reports.push_back(measure("tag: getReference(name)", n_refs - second_begin, [&] {
+        for (size_t i = second_begin; i < n_refs; i++) {
+            tag.getReference(names[i]);
+        }
+    }));
+    reports.push_back(measure("group: getDataArray(name)", n_refs - second_begin, [&] {
+        for (size_t i = second_begin; i < n_refs; i++) {
+            group.getDataArray(names[i]);
+        }
+    }));
+    reports.push_back(measure("tag: removeReference(name)", n_refs - second_begin, [&] {
+        for (size_t i = second_begin; i < n_refs; i++) {
+            tag.removeReference(names[i]);
+        }
+    }));
+
+    file.close();
+
+    print_reports(reports, "entities");
+
+    return 0;
+}
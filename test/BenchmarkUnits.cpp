@@ -0,0 +1,74 @@
+// Copyright (c) 2016, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix.hpp>
+
+#include "Benchmark.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* ************************************ */
+
+int main(int argc, char **argv)
+{
+    size_t n_calls = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    const std::vector<std::pair<std::string, std::string>> pairs = {
+        {"ms", "s"}, {"s", "ms"}, {"mV", "uV"}, {"kHz", "Hz"}, {"mV^2", "V^2"}, {"mol", "mmol"}, {"cm", "m"}
+    };
+    const std::vector<std::string> units = {"V", "mV", "mV^-2", "kat", "mV/cm^2*kg", "mOhm/m", "Hz", "dB"};
+
+    std::vector<Report> reports;
+    std::cout << "Performing unit tests (" << n_calls << " calls each)..." << std::endl;
+
+    double sum = 0.0;
+    reports.push_back(measure("getSIScaling", n_calls, [&] {
+        for (size_t i = 0; i < n_calls; i++) {
+            const auto &p = pairs[i % pairs.size()];
+            sum += nix::util::getSIScaling(p.first, p.second);
+        }
+    }));
+
+    size_t valid = 0;
+    reports.push_back(measure("isSIUnit", n_calls, [&] {
+        for (size_t i = 0; i < n_calls; i++) {
+            valid += nix::util::isSIUnit(units[i % units.size()]);
+        }
+    }));
+
+    reports.push_back(measure("isScalable", n_calls, [&] {
+        for (size_t i = 0; i < n_calls; i++) {
+            const auto &p = pairs[i % pairs.size()];
+            valid += nix::util::isScalable(p.first, p.second);
+        }
+    }));
+
+    std::string prefix, unit, power;
+    reports.push_back(measure("splitUnit", n_calls, [&] {
+        for (size_t i = 0; i < n_calls; i++) {
+            nix::util::splitUnit(units[i % units.size()], prefix, unit, power);
+        }
+    }));
+
+    std::vector<std::string> atomic;
+    reports.push_back(measure("splitCompoundUnit", n_calls, [&] {
+        for (size_t i = 0; i < n_calls; i++) {
+            atomic.clear();
+            nix::util::splitCompoundUnit("mV/cm^2*kg", atomic);
+        }
+    }));
+
+    std::cout << "(checksum " << sum << ", " << valid << ")" << std::endl;
+
+    print_reports(reports, "calls");
+
+    return 0;
+}
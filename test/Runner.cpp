@@ -54,6 +54,7 @@
 #include "fs/TestTagFS.hpp"
 #include "fs/TestBaseTagFS.hpp"
 #include "fs/TestDimensionFS.hpp"
+#include "fs/TestDataAccessFS.hpp"
 #endif
 
 int main(int argc, char* argv[]) {
@@ -103,6 +104,7 @@ int main(int argc, char* argv[]) {
     CPPUNIT_TEST_SUITE_REGISTRATION(TestTagFS);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestBaseTagFS);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestDimensionFS);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestDataAccessFS);
 #endif
 
     CPPUNIT_NS::TestResult testresult;
@@ -45,5 +45,99 @@ void TestNDArray::basic() {
 
 }
 
+void TestNDArray::views() {
+    nix::NDArray A(nix::DataType::Double, nix::NDSize({3, 4, 5}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<uintptr_t>(0), reinterpret_cast<uintptr_t>(A.data()) % nix::NDArray::alignment);
+
+    nix::NDArrayView<double> all = A.view<double>();
+    CPPUNIT_ASSERT(all.isContiguous());
+    for (size_t i = 0; i < 60; i++) {
+        A.set<double>(i, static_cast<double>(i));
+    }
+    CPPUNIT_ASSERT_EQUAL(26.0, all(1, 1, 1));
+    CPPUNIT_ASSERT_EQUAL(A.get<double>(nix::NDSize({2, 3, 4})), all(nix::NDSize({2, 3, 4})));
+    CPPUNIT_ASSERT_THROW(all.at(nix::NDSize({3, 0, 0})), nix::OutOfBounds);
+
+    // views share the memory of the array
+    nix::NDArrayView<double> rows = all.slice(0, 1, 2);
+    CPPUNIT_ASSERT(rows.isContiguous());
+    CPPUNIT_ASSERT_EQUAL(20.0, rows(0, 0, 0));
+    rows(0, 0, 0) = -1.0;
+    CPPUNIT_ASSERT_EQUAL(-1.0, A.get<double>(20));
+
+    nix::NDArrayView<double> block = all.subBlock({1, 1, 2}, {2, 2, 2});
+    CPPUNIT_ASSERT(!block.isContiguous());
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({2, 2, 2}), block.shape());
+    CPPUNIT_ASSERT_EQUAL(27.0, block(0, 0, 0));
+    CPPUNIT_ASSERT_EQUAL(53.0, block(1, 1, 1));
+    CPPUNIT_ASSERT_THROW(all.subBlock({2, 0, 0}, {2, 1, 1}), nix::OutOfBounds);
+
+    std::vector<double> copy(8);
+    block.copyTo(copy.data());
+    CPPUNIT_ASSERT_EQUAL(28.0, copy[1]);
+    CPPUNIT_ASSERT_EQUAL(32.0, copy[2]);
+    CPPUNIT_ASSERT_EQUAL(47.0, copy[4]);
+
+    nix::NDArrayView<double> t = all.transpose();
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({5, 4, 3}), t.shape());
+    CPPUNIT_ASSERT_EQUAL(all(2, 1, 4), t(4, 1, 2));
+    nix::NDArrayView<double> s = all.swapAxes(0, 2);
+    CPPUNIT_ASSERT_EQUAL(all(2, 1, 4), s(4, 1, 2));
+
+    const nix::NDArray &C = A;
+    nix::NDArrayView<const double> cv = C.view<double>();
+    CPPUNIT_ASSERT_EQUAL(26.0, cv(1, 1, 1));
+    nix::NDArrayView<const double> converted = all;
+    CPPUNIT_ASSERT_EQUAL(26.0, converted(1, 1, 1));
+
+    CPPUNIT_ASSERT_THROW(A.view<int32_t>(), std::invalid_argument);
+}
+
+void TestNDArray::pool() {
+    using nix::BufferPool;
+    BufferPool::trim();
+    size_t cached = BufferPool::cached();
+
+    // blocks of the same size class are reused
+    void *block = BufferPool::acquire(5000);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uintptr_t>(0), reinterpret_cast<uintptr_t>(block) % BufferPool::alignment);
+    BufferPool::release(block, 5000);
+    CPPUNIT_ASSERT_EQUAL(cached + 8192, BufferPool::cached());
+    CPPUNIT_ASSERT(BufferPool::acquire(6000) == block);
+    CPPUNIT_ASSERT_EQUAL(cached, BufferPool::cached());
+    BufferPool::release(block, 6000);
+
+    size_t limit = BufferPool::limit();
+    BufferPool::limit(0);
+    BufferPool::trim();
+    cached = BufferPool::cached();
+    block = BufferPool::acquire(100);
+    BufferPool::release(block, 100);
+    CPPUNIT_ASSERT_EQUAL(cached, BufferPool::cached());
+    BufferPool::limit(limit);
+
+    // new elements are zeroed unless requested otherwise, even in reused blocks
+    {
+        nix::NDArray A(nix::DataType::Double, nix::NDSize({1000}), nix::NDArray::Init::Uninitialized);
+        for (size_t i = 0; i < 1000; i++) {
+            A.set<double>(i, 1.0);
+        }
+    }
+    nix::NDArray B(nix::DataType::Double, nix::NDSize({1000}));
+    for (size_t i = 0; i < 1000; i++) {
+        CPPUNIT_ASSERT_EQUAL(0.0, B.get<double>(i));
+    }
+
+    // resizing within the capacity keeps the storage
+    const nix::NDArray::byte_type *data = B.data();
+    B.resize(nix::NDSize({10, 10}), nix::NDArray::Init::Uninitialized);
+    B.set<double>(99, 5.0);
+    B.resize(nix::NDSize({20, 50}));
+    CPPUNIT_ASSERT(B.data() == data);
+    CPPUNIT_ASSERT(B.capacity() >= 8000);
+    CPPUNIT_ASSERT_EQUAL(5.0, B.get<double>(99));
+    CPPUNIT_ASSERT_EQUAL(0.0, B.get<double>(999));
+}
+
 void TestNDArray::tearDown() {
 }
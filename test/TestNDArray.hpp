@@ -28,6 +28,8 @@ public:
 
     void setUp();
     void basic();
+    void views();
+    void pool();
     void tearDown();
 
 
@@ -35,6 +37,8 @@ private:
 
     CPPUNIT_TEST_SUITE(TestNDArray);
     CPPUNIT_TEST(basic);
+    CPPUNIT_TEST(views);
+    CPPUNIT_TEST(pool);
     CPPUNIT_TEST_SUITE_END ();
 };
 
@@ -10,6 +10,9 @@
 
 #include <nix/NDSize.hpp>
 
+#include <type_traits>
+#include <utility>
+
 void TestNDSize::testAll() {
     using namespace nix;
 
@@ -110,3 +113,55 @@ void TestNDSize::testAll() {
     CPPUNIT_ASSERT(!(t <= s));
     CPPUNIT_ASSERT(!(t < u));
 }
+
+
+void TestNDSize::testStorage() {
+    using namespace nix;
+
+    typedef NDSize::value_type value_type;
+    const size_t large_rank = NDSize::inline_rank + 3;
+
+    // inline and heap storage, in all combinations of copy, move and swap
+    NDSize small({1, 2, 3});
+    NDSize large(large_rank, static_cast<value_type>(7));
+    large[large_rank - 1] = 9;
+
+    NDSize a(small), b(large);
+    CPPUNIT_ASSERT(a == small && b == large);
+
+    NDSize c(std::move(a));
+    NDSize d(std::move(b));
+    CPPUNIT_ASSERT(c == small && d == large);
+    CPPUNIT_ASSERT(a.empty() && b.empty());
+
+    a = large;
+    b = small;
+    CPPUNIT_ASSERT(a == large && b == small);
+    a = small;
+    b = large;
+    CPPUNIT_ASSERT(a == small && b == large);
+    NDSize &self = b;
+    b = self;
+    CPPUNIT_ASSERT(b == large);
+
+    c = std::move(d);
+    CPPUNIT_ASSERT(c == large && d.empty());
+    d = std::move(a);
+    CPPUNIT_ASSERT(d == small && a.empty());
+
+    swap(c, d);
+    CPPUNIT_ASSERT(c == small && d == large);
+    swap(b, d);
+    CPPUNIT_ASSERT(b == large && d == large);
+    swap(c, a);
+    CPPUNIT_ASSERT(a == small && c.empty());
+
+    NDSize e = small + small;
+    CPPUNIT_ASSERT_EQUAL(static_cast<value_type>(6), e[2]);
+    NDSize f = large + large;
+    CPPUNIT_ASSERT_EQUAL(static_cast<value_type>(18), f[large_rank - 1]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<value_type>(14), f[0]);
+
+    CPPUNIT_ASSERT(std::is_nothrow_move_constructible<NDSize>::value);
+    CPPUNIT_ASSERT(std::is_nothrow_move_assignable<NDSize>::value);
+}
@@ -17,11 +17,13 @@ private:
 
     CPPUNIT_TEST_SUITE(TestNDSize);
     CPPUNIT_TEST(testAll);
+    CPPUNIT_TEST(testStorage);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
 
     void testAll();
+    void testStorage();
 };
 
 
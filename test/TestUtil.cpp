@@ -52,6 +52,12 @@ void TestUtil::testUnitScaling() {
     CPPUNIT_ASSERT(util::getSIScaling("V","mV") == 1e+03);
     CPPUNIT_ASSERT(util::getSIScaling("V^2","mV^2") == 1e+06);
     CPPUNIT_ASSERT(util::getSIScaling("mV^2","kV^2") == 1e-12);
+    CPPUNIT_ASSERT(util::getSIScaling("mmol^2","mol^2") == 1e-06);
+    CPPUNIT_ASSERT(util::getSIScaling("mV/cm","mV/cm") == 1.0);
+    CPPUNIT_ASSERT_THROW(util::getSIScaling("mV/cm","V/cm"), nix::InvalidUnit);
+    // repeated lookups are answered from the memo table
+    CPPUNIT_ASSERT(util::getSIScaling("mV","kV") == 1e-6);
+    CPPUNIT_ASSERT_THROW(util::getSIScaling("mOhm","ms"), nix::InvalidUnit);
 }
 
 void TestUtil::testIsSIUnit() {
@@ -81,6 +87,14 @@ void TestUtil::testSIUnitSplit() {
     CPPUNIT_ASSERT(prefix == "m" && unit == "V" && power == "-2");
     util::splitUnit(unit_5, prefix, unit, power);
     CPPUNIT_ASSERT(prefix == "" && unit == "m" && power == "2");
+    util::splitUnit("mmol^2", prefix, unit, power);
+    CPPUNIT_ASSERT(prefix == "m" && unit == "mol" && power == "2");
+    util::splitUnit("Sv^-1", prefix, unit, power);
+    CPPUNIT_ASSERT(prefix == "" && unit == "Sv" && power == "-1");
+    util::splitUnit("dam", prefix, unit, power);
+    CPPUNIT_ASSERT(prefix == "da" && unit == "m" && power == "");
+    util::splitUnit("mV/s", prefix, unit, power);
+    CPPUNIT_ASSERT(prefix == "" && unit == "mV/s" && power == "");
 }
 
 void TestUtil::testIsAtomicSIUnit() {
@@ -90,6 +104,10 @@ void TestUtil::testIsAtomicSIUnit() {
     CPPUNIT_ASSERT(!util::isAtomicSIUnit("mV/cm"));
     CPPUNIT_ASSERT(util::isAtomicSIUnit("dB"));
     CPPUNIT_ASSERT(util::isAtomicSIUnit("rad"));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit(""));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit("mV^"));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit("mV^0"));
+    CPPUNIT_ASSERT(!util::isAtomicSIUnit("h"));
 }
 
 void TestUtil::testIsCompoundSIUnit() {
@@ -102,6 +120,8 @@ void TestUtil::testIsCompoundSIUnit() {
     CPPUNIT_ASSERT(util::isCompoundSIUnit(unit_2));
     CPPUNIT_ASSERT(util::isCompoundSIUnit(unit_3));
     CPPUNIT_ASSERT(!util::isCompoundSIUnit(unit_4));
+    CPPUNIT_ASSERT(!util::isCompoundSIUnit("mV/"));
+    CPPUNIT_ASSERT(!util::isCompoundSIUnit("mV//s"));
 }
 
 void TestUtil::testSplitCompoundUnit() {
@@ -217,4 +217,55 @@ void TestVariant::testEquals() {
     CPPUNIT_ASSERT(v2 == v1);
 }
 
-
+void TestVariant::testSmallString() {
+    const std::string small(nix::Variant::small_capacity, 's');
+    const std::string large(nix::Variant::small_capacity + 1, 'l');
+
+    nix::Variant s(small);
+    nix::Variant l(large);
+    CPPUNIT_ASSERT(!s.on_heap());
+    CPPUNIT_ASSERT(l.on_heap());
+    CPPUNIT_ASSERT_EQUAL(small, s.get<std::string>());
+    CPPUNIT_ASSERT_EQUAL(large, l.get<std::string>());
+
+    // switch between inline and heap storage
+    nix::Variant v(large);
+    v.set(small);
+    CPPUNIT_ASSERT(!v.on_heap());
+    CPPUNIT_ASSERT_EQUAL(small, v.get<std::string>());
+    v.set(large);
+    CPPUNIT_ASSERT(v.on_heap());
+    CPPUNIT_ASSERT_EQUAL(large, v.get<std::string>());
+    v.set(42);
+    CPPUNIT_ASSERT(!v.on_heap());
+    CPPUNIT_ASSERT_EQUAL(42, v.get<int32_t>());
+
+    // a part of the own string
+    v.set(large);
+    v.set(v.get<const char *>() + 20);
+    CPPUNIT_ASSERT_EQUAL(large.substr(20), v.get<std::string>());
+    v.set(v.get<const char *>() + 1, 3);
+    CPPUNIT_ASSERT_EQUAL(std::string("lll"), v.get<std::string>());
+
+    // moves leave the source empty and keep the string
+    nix::Variant ms(std::move(s));
+    nix::Variant ml(std::move(l));
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::Nothing, s.type());
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::Nothing, l.type());
+    CPPUNIT_ASSERT_EQUAL(small, ms.get<std::string>());
+    CPPUNIT_ASSERT_EQUAL(large, ml.get<std::string>());
+
+    ms = std::move(ml);
+    CPPUNIT_ASSERT(ms.on_heap());
+    CPPUNIT_ASSERT_EQUAL(large, ms.get<std::string>());
+
+    nix::Variant a(small), b(large);
+    swap(a, b);
+    CPPUNIT_ASSERT_EQUAL(large, a.get<std::string>());
+    CPPUNIT_ASSERT_EQUAL(small, b.get<std::string>());
+
+    a = a;
+    CPPUNIT_ASSERT_EQUAL(large, a.get<std::string>());
+    CPPUNIT_ASSERT(nix::Variant(small) == b);
+    CPPUNIT_ASSERT(nix::Variant(large) != b);
+}
@@ -39,6 +39,7 @@ public:
     void testObject();
     void testSwap();
     void testEquals();
+    void testSmallString();
 
 private:
 
@@ -46,6 +47,7 @@ private:
     CPPUNIT_TEST(testObject);
     CPPUNIT_TEST(testSwap);
     CPPUNIT_TEST(testEquals);
+    CPPUNIT_TEST(testSmallString);
     CPPUNIT_TEST_SUITE_END ();
 
 };
@@ -73,3 +73,72 @@ void TestAttributesFS::testReadField() {
     attrs.get(vector_field, vector_return);
     CPPUNIT_ASSERT(vector_values == vector_return);
 }
+
+void TestAttributesFS::testWriteBack() {
+    boost::filesystem::path p = this->location / "attributes";
+    file::AttributesFS attrs(this->location.string(), FileMode::Overwrite);
+    attrs.set("format", "nix");
+
+    // changes are shared by all attributes of the directory
+    file::AttributesFS other(this->location.string(), FileMode::ReadOnly);
+    string format;
+    other.get("format", format);
+    CPPUNIT_ASSERT(format == "nix");
+
+    attrs.flush();
+    YAML::Node node = YAML::LoadFile(p.string());
+    CPPUNIT_ASSERT(node["format"].as<string>() == "nix");
+
+    // changes of the file by others are noticed
+    boost::filesystem::path temp = this->location / "replacement";
+    {
+        ofstream ofs(temp.string());
+        ofs << "format: xin" << endl << "version: 2" << endl;
+    }
+    boost::filesystem::rename(temp, p);
+    attrs.get("format", format);
+    CPPUNIT_ASSERT(format == "xin");
+    CPPUNIT_ASSERT(attrs.attributeCount() == 2);
+
+    // pending changes survive changes of the file by others
+    attrs.set("format", "nix");
+    attrs.remove("version");
+    {
+        ofstream ofs(temp.string());
+        ofs << "format: xin" << endl << "version: 3" << endl << "created_at: 2015-01-01" << endl;
+    }
+    boost::filesystem::rename(temp, p);
+    attrs.get("format", format);
+    CPPUNIT_ASSERT(format == "nix");
+    CPPUNIT_ASSERT(!attrs.has("version"));
+    CPPUNIT_ASSERT(attrs.has("created_at"));
+    {
+        ofstream ofs(temp.string());
+        ofs << "format: xin" << endl << "owner: someone" << endl;
+    }
+    boost::filesystem::rename(temp, p);
+    attrs.flush();
+    node = YAML::LoadFile(p.string());
+    CPPUNIT_ASSERT(node["format"].as<string>() == "nix");
+    CPPUNIT_ASSERT(node["owner"].as<string>() == "someone");
+    CPPUNIT_ASSERT(!node["version"]);
+
+    // flushing a directory leaves the attributes of others alone
+    boost::filesystem::path nested_dir = this->location / "nested", elsewhere = this->location / "elsewhere";
+    boost::filesystem::create_directories(nested_dir);
+    boost::filesystem::create_directories(elsewhere);
+    file::AttributesFS nested(nested_dir, FileMode::Overwrite);
+    file::AttributesFS outside(elsewhere, FileMode::Overwrite);
+    nested.set("format", "nix");
+    outside.set("format", "nix");
+    file::AttributesFS::flushAll(nested_dir);
+    CPPUNIT_ASSERT(YAML::LoadFile((nested_dir / "attributes").string())["format"]);
+    CPPUNIT_ASSERT(!YAML::LoadFile((elsewhere / "attributes").string())["format"]);
+
+    // the last attributes of a directory write pending changes
+    attrs.set("format", "nix");
+    attrs = file::AttributesFS();
+    other = file::AttributesFS();
+    node = YAML::LoadFile(p.string());
+    CPPUNIT_ASSERT(node["format"].as<string>() == "nix");
+}
@@ -26,6 +26,8 @@ class TestBlockFS : public BaseTestBlock {
     CPPUNIT_TEST(testTagAccess);
     CPPUNIT_TEST(testMultiTagAccess);
     CPPUNIT_TEST(testGroupAccess);
+    CPPUNIT_TEST(testQuery);
+    CPPUNIT_TEST(testTypeIndex);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);
@@ -24,8 +24,10 @@ class TestDataArrayFS : public BaseTestDataArray {
     CPPUNIT_TEST(testUnit);
     CPPUNIT_TEST(testDimension);
     CPPUNIT_TEST(testAliasRangeDimension);
+    CPPUNIT_TEST(testDimensionHandles);
     CPPUNIT_TEST(testOperator);
     CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testStringData);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -58,16 +60,14 @@ public:
         file.close();
     }
 
-    void testData() {
-        // TODO data is not implemented yet
-    }
-
-    void testPolynomial() {
-        // TODO
-    }
+    void testStringData() {
+        CPPUNIT_ASSERT_THROW(block.createDataArray("strings", "text", nix::DataType::String, nix::NDSize({ 2 })),
+                             std::invalid_argument);
+        CPPUNIT_ASSERT(!block.hasDataArray("strings"));
 
-    void testAliasRangeDimension() {
-        // TODO
+        std::vector<std::string> text = { "a", "b" };
+        CPPUNIT_ASSERT_THROW(array3.setData(nix::DataType::String, text.data(), nix::NDSize({ 2 }), nix::NDSize({ 0 })),
+                             std::invalid_argument);
     }
 };
 #endif //NIX_TESTDATAARRAYFS_HPP
@@ -33,6 +33,7 @@ class TestDimensionFS : public BaseTestDimension {
     CPPUNIT_TEST(testRangeDimUnit);
     // CPPUNIT_TEST(testRangeTicks);
     // CPPUNIT_TEST(testRangeDimIndexOf);
+    // CPPUNIT_TEST(testRangeDimLargeTicks);
     // CPPUNIT_TEST(testRangeDimTickAt);
     // CPPUNIT_TEST(testRangeDimAxis);
     CPPUNIT_TEST_SUITE_END ();
@@ -24,6 +24,8 @@ class TestFileFS: public BaseTestFile {
     CPPUNIT_TEST(testSectionAccess);
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testReopen);
+    CPPUNIT_TEST(testBatch);
+    CPPUNIT_TEST(testMetadataSnapshot);
     CPPUNIT_TEST(testCheckHeader);
 
     CPPUNIT_TEST_SUITE_END ();
@@ -29,6 +29,7 @@ class TestSectionFS : public BaseTestSection {
     CPPUNIT_TEST(testFindSection);
     CPPUNIT_TEST(testFindRelated);
     CPPUNIT_TEST(testPropertyAccess);
+    CPPUNIT_TEST(testPropertyValues);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);
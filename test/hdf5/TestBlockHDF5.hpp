@@ -11,6 +11,8 @@
 
 #include "BaseTestBlock.hpp"
 
+#include <hdf5.h>
+
 class TestBlockHDF5 : public BaseTestBlock {
 
     CPPUNIT_TEST_SUITE(TestBlockHDF5);
@@ -27,6 +29,9 @@ class TestBlockHDF5 : public BaseTestBlock {
     CPPUNIT_TEST(testTagAccess);
     CPPUNIT_TEST(testMultiTagAccess);
     CPPUNIT_TEST(testGroupAccess);
+    CPPUNIT_TEST(testQuery);
+    CPPUNIT_TEST(testQueryDetachedMetadata);
+    CPPUNIT_TEST(testTypeIndex);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);
@@ -52,6 +57,32 @@ public:
     void tearDown() {
         file.close();
     }
+
+
+    void testQueryDetachedMetadata() {
+        std::string sub_id;
+        {
+            nix::Section sub = file.createSection("parent", "test").createSection("sub", "test");
+            block.createDataArray("array", "test", nix::DataType::Double, nix::NDSize({1})).metadata(sub);
+            sub_id = sub.id();
+            CPPUNIT_ASSERT_EQUAL(size_t(1), block.dataArrays(nix::util::Query::metadata(sub_id)).size());
+        }
+        file.close();
+
+        // files changed by other tools may still link a section that is no
+        // longer part of the metadata tree
+        hid_t h5file = H5Fopen("test_block.h5", H5F_ACC_RDWR, H5P_DEFAULT);
+        CPPUNIT_ASSERT(H5Iis_valid(h5file));
+        CPPUNIT_ASSERT(H5Ldelete(h5file, "/metadata/parent/sections/sub", H5P_DEFAULT) >= 0);
+        H5Fclose(h5file);
+
+        file = nix::File::open("test_block.h5", nix::FileMode::ReadWrite);
+        block = file.getBlock("block_one");
+        nix::util::Query query = nix::util::Query::metadata(sub_id);
+        CPPUNIT_ASSERT(!block.getDataArray("array").metadata());
+        CPPUNIT_ASSERT(block.dataArrays(nix::util::Filter<nix::DataArray>::type(query)).empty());
+        CPPUNIT_ASSERT(block.dataArrays(query).empty());
+    }
     
 };
 
@@ -20,12 +20,14 @@ class TestDataAccessHDF5 : public BaseTestDataAccess {
     CPPUNIT_TEST(testPositionToIndexSetDimension);
     CPPUNIT_TEST(testPositionToIndexRangeDimension);
     CPPUNIT_TEST(testOffsetAndCount);
+    CPPUNIT_TEST(testOffsetsAndCounts);
     CPPUNIT_TEST(testPositionInData);
     CPPUNIT_TEST(testRetrieveData);
     CPPUNIT_TEST(testTagFeatureData);
     CPPUNIT_TEST(testMultiTagFeatureData);
     CPPUNIT_TEST(testMultiTagUnitSupport);
     CPPUNIT_TEST(testDataView);
+    CPPUNIT_TEST(testEpochs);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -21,11 +21,13 @@ class TestDataArrayHDF5 : public BaseTestDataArray {
     CPPUNIT_TEST(testName);
     CPPUNIT_TEST(testDefinition);
     CPPUNIT_TEST(testData);
+    CPPUNIT_TEST(testArrayViews);
     CPPUNIT_TEST(testPolynomial);
     CPPUNIT_TEST(testLabel);
     CPPUNIT_TEST(testUnit);
     CPPUNIT_TEST(testDimension);
     CPPUNIT_TEST(testAliasRangeDimension);
+    CPPUNIT_TEST(testDimensionHandles);
     CPPUNIT_TEST(testOperator);
     CPPUNIT_TEST(testValidate);
     CPPUNIT_TEST_SUITE_END ();
@@ -6,6 +6,9 @@
 #define NIX_TESTFILEHDF5_HPP_H
 
 #include "BaseTestFile.hpp"
+#include "hdf5/h5x/H5Group.hpp"
+
+#include <boost/filesystem.hpp>
 
 class TestFileHDF5: public BaseTestFile {
 
@@ -21,6 +24,11 @@ class TestFileHDF5: public BaseTestFile {
     CPPUNIT_TEST(testSectionAccess);
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testReopen);
+    CPPUNIT_TEST(testBatch);
+    CPPUNIT_TEST(testBatchValues);
+    CPPUNIT_TEST(testMetadataSnapshot);
+    CPPUNIT_TEST(testMetadataSnapshotValues);
+    CPPUNIT_TEST(testRepack);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -43,6 +51,93 @@ public:
         CPPUNIT_ASSERT(file_other.location() == "test_file_other.h5");
     }
 
+    void testRepack() {
+        nix::Block b = file_open.createBlock("repack", "test");
+        std::vector<double> values(1000);
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = i * 0.5;
+        }
+        nix::DataArray big = b.createDataArray("big", "test", values);
+        nix::DataArray small = b.createDataArray("small", "test", nix::DataType::Int32, nix::NDSize({2, 3}));
+        std::vector<int32_t> ints = {1, 2, 3, 4, 5, 6};
+        small.setData(nix::DataType::Int32, ints.data(), {2, 3}, {0, 0});
+        nix::DataArray gone = b.createDataArray("gone", "test", values);
+        nix::Tag tag = b.createTag("tag", "test", {1.0});
+        tag.addReference(big);
+        nix::Section sub = file_open.createSection("sec", "test").createSection("sub", "test");
+        sub.createProperty("prop", nix::Value("value"));
+        b.metadata(sub);
+        b.deleteDataArray(gone);
+
+        CPPUNIT_ASSERT_THROW(file_open.repack("test_file.h5"), std::invalid_argument);
+
+        nix::StorageOptions options;
+        options.chunking = [](nix::DataType, const nix::NDSize &extent) {
+            return extent.size() == 1 ? nix::NDSize({100}) : nix::NDSize();
+        };
+        options.compression = 4;
+        options.compact_limit = 1024;
+        options.latest_format = true;
+        file_open.repack("test_file_repacked.h5", options);
+
+        nix::File repacked = nix::File::open("test_file_repacked.h5", nix::FileMode::ReadOnly);
+        nix::Block rb = repacked.getBlock(b.id());
+        CPPUNIT_ASSERT(rb && rb.name() == "repack");
+        CPPUNIT_ASSERT(rb.dataArrayCount() == 2);
+        CPPUNIT_ASSERT(!rb.hasDataArray("gone"));
+
+        std::vector<double> read;
+        rb.getDataArray(big.id()).getData(read);
+        CPPUNIT_ASSERT(read == values);
+        std::vector<int32_t> read_ints(6);
+        rb.getDataArray("small").getData(nix::DataType::Int32, read_ints.data(), {2, 3}, {0, 0});
+        CPPUNIT_ASSERT(read_ints == ints);
+
+        nix::Tag rtag = rb.getTag(tag.id());
+        CPPUNIT_ASSERT(rtag.referenceCount() == 1 && rtag.getReference(0).id() == big.id());
+        nix::Section rsub = rb.metadata();
+        CPPUNIT_ASSERT(rsub && rsub.id() == sub.id());
+        CPPUNIT_ASSERT(rsub.parent() && rsub.parent().name() == "sec");
+        CPPUNIT_ASSERT(rsub.getProperty("prop").values()[0].get<std::string>() == "value");
+        CPPUNIT_ASSERT(repacked.sectionCount() == file_open.sectionCount());
+        repacked.close();
+
+        // the storage of the data sets
+        hid_t h5file = H5Fopen("test_file_repacked.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+        CPPUNIT_ASSERT(H5Iis_valid(h5file));
+        {
+            nix::hdf5::H5Group arrays(H5Gopen2(h5file, "/data/repack/data_arrays", H5P_DEFAULT));
+            nix::hdf5::DataSet big_data = arrays.openGroup("big", false).openData("data");
+            CPPUNIT_ASSERT_EQUAL(nix::NDSize({100}), big_data.chunking());
+            nix::hdf5::H5Object big_dcpl = H5Dget_create_plist(big_data.h5id());
+            unsigned int flags, level;
+            size_t nlevel = 1;
+            CPPUNIT_ASSERT(H5Pget_filter_by_id2(big_dcpl.h5id(), H5Z_FILTER_DEFLATE, &flags, &nlevel, &level,
+                                                0, nullptr, nullptr) >= 0);
+            CPPUNIT_ASSERT_EQUAL(4u, level);
+
+            nix::hdf5::DataSet small_data = arrays.openGroup("small", false).openData("data");
+            nix::hdf5::H5Object small_dcpl = H5Dget_create_plist(small_data.h5id());
+            CPPUNIT_ASSERT(H5Pget_layout(small_dcpl.h5id()) == H5D_COMPACT);
+        }
+        H5Fclose(h5file);
+
+        // the space of the deleted data is reclaimed, even without compression
+        file_open.flush();
+        file_open.repack("test_file_plain.h5");
+        CPPUNIT_ASSERT(boost::filesystem::file_size("test_file_plain.h5") + values.size() * sizeof(double) <=
+                       boost::filesystem::file_size("test_file.h5"));
+        CPPUNIT_ASSERT(boost::filesystem::file_size("test_file_repacked.h5") <
+                       boost::filesystem::file_size("test_file_plain.h5"));
+        boost::filesystem::remove("test_file_plain.h5");
+
+        // compact data can not grow
+        repacked = nix::File::open("test_file_repacked.h5", nix::FileMode::ReadWrite);
+        nix::DataArray rsmall = repacked.getBlock(b.id()).getDataArray("small");
+        CPPUNIT_ASSERT_THROW(rsmall.dataExtent({4, 3}), nix::hdf5::H5Error);
+        repacked.close();
+    }
+
 };
 
 #endif //NIX_TESTFILEHDF5_HPP_H
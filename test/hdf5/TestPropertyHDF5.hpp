@@ -22,6 +22,7 @@ class TestPropertyHDF5 : public BaseTestProperty {
     CPPUNIT_TEST(testMapping);
 
     CPPUNIT_TEST(testValues);
+    CPPUNIT_TEST(testValueColumn);
     CPPUNIT_TEST(testDataType);
     CPPUNIT_TEST(testUnit);
 
@@ -29,6 +29,8 @@ class TestSectionHDF5 : public BaseTestSection {
     CPPUNIT_TEST(testFindSection);
     CPPUNIT_TEST(testFindRelated);
     CPPUNIT_TEST(testPropertyAccess);
+    CPPUNIT_TEST(testPropertyValues);
+    CPPUNIT_TEST(testPropertyValuesData);
 
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testUpdatedAt);